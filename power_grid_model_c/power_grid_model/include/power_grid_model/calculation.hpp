@@ -84,11 +84,13 @@ template <symmetry_tag sym> struct Calculator<power_flow_t, sym> {
                          MainModelOptions const& /*options*/) {
         return [&state](Idx n_math_solvers) { return main_core::prepare_power_flow_input<sym>(state, n_math_solvers); };
     }
-    static auto solver(CalculationMethod calculation_method, MainModelOptions const& options, bool cache_run,
-                       Logger& logger) {
-        return [calculation_method, err_tol = options.err_tol, max_iter = options.max_iter, &logger,
-                cache_run](MathSolverProxy<sym>& solver, YBus<sym> const& y_bus, PowerFlowInput<sym> const& input) {
-            return solver.get().run_power_flow(input, err_tol, max_iter, cache_run, logger, calculation_method, y_bus);
+    static auto solver(CalculationMethod calculation_method, MainModelOptions const& options, bool cache_run) {
+        return [calculation_method, err_tol = options.err_tol, max_iter = options.max_iter,
+                initialization = options.power_flow_initialization,
+                cache_run](MathSolverProxy<sym>& solver, YBus<sym> const& y_bus, PowerFlowInput<sym> const& input,
+                           Logger& logger) {
+            return solver.get().run_power_flow(input, err_tol, max_iter, cache_run, logger, calculation_method,
+                                               initialization, y_bus);
         };
     }
 };
@@ -100,11 +102,13 @@ template <symmetry_tag sym> struct Calculator<state_estimation_t, sym> {
             return main_core::prepare_state_estimation_input<sym>(state, n_math_solvers);
         };
     }
-    static auto solver(CalculationMethod calculation_method, MainModelOptions const& options, bool /*cache_run*/,
-                       Logger& logger) {
+    static auto solver(CalculationMethod calculation_method, MainModelOptions const& options, bool /*cache_run*/) {
         return [calculation_method, err_tol = options.err_tol, max_iter = options.max_iter,
-                &logger](MathSolverProxy<sym>& solver, YBus<sym> const& y_bus, StateEstimationInput<sym> const& input) {
-            return solver.get().run_state_estimation(input, err_tol, max_iter, logger, calculation_method, y_bus);
+                factorization_precision = options.factorization_precision](
+                   MathSolverProxy<sym>& solver, YBus<sym> const& y_bus, StateEstimationInput<sym> const& input,
+                   Logger& logger) {
+            return solver.get().run_state_estimation(input, err_tol, max_iter, logger, calculation_method,
+                                                     factorization_precision, y_bus);
         };
     }
 };
@@ -116,10 +120,9 @@ template <symmetry_tag sym> struct Calculator<short_circuit_t, sym> {
             return main_core::prepare_short_circuit_input<sym>(state, comp_coup, n_math_solvers, voltage_scaling);
         };
     }
-    static auto solver(CalculationMethod calculation_method, MainModelOptions const& /*options*/, bool /*cache_run*/,
-                       Logger& logger) {
-        return [calculation_method, &logger](MathSolverProxy<sym>& solver, YBus<sym> const& y_bus,
-                                             ShortCircuitInput const& input) {
+    static auto solver(CalculationMethod calculation_method, MainModelOptions const& /*options*/, bool /*cache_run*/) {
+        return [calculation_method](MathSolverProxy<sym>& solver, YBus<sym> const& y_bus,
+                                    ShortCircuitInput const& input, Logger& logger) {
             return solver.get().run_short_circuit(input, logger, calculation_method, y_bus);
         };
     }
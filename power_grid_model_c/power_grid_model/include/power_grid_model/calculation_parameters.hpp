@@ -210,6 +210,8 @@ struct MathModelTopology {
     Idx n_transformer_tap_regulator() const { return tap_regulators_per_branch.element_size(); }
 
     Idx n_load_gen_voltage_regulator() const { return voltage_regulators_per_load_gen.element_size(); }
+
+    friend bool operator==(MathModelTopology const& x, MathModelTopology const& y) = default;
 };
 
 struct SourceCalcParam {
@@ -533,6 +535,8 @@ struct ComponentConnections {
     // 3-way branch, phase shift = phase_node_x - phase_internal_node
     std::vector<std::array<double, 3>> branch3_phase_shift;
     IntSVector source_connected;
+
+    friend bool operator==(ComponentConnections const& x, ComponentConnections const& y) = default;
 };
 
 // To couple 3-way branch, to math model, 3 virtual branches are created
@@ -7,13 +7,16 @@
 #include "calculation_parameters.hpp"
 #include "common/common.hpp"
 #include "common/counting_iterator.hpp"
+#include "common/enum.hpp"
 #include "common/exception.hpp"
 #include "component/component.hpp"
 #include "component/load_gen.hpp"
 #include "component/source.hpp"
+#include "main_core/island_solve.hpp"
 #include "main_core/main_model_type.hpp"
 #include "main_core/math_state.hpp"
 #include "main_core/topology.hpp"
+#include "main_core/topology_cache.hpp"
 #include "main_core/y_bus.hpp"
 #include "math_solver/math_solver_dispatch.hpp"
 #include "supernodes.hpp"
@@ -21,7 +24,12 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <ranges>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace power_grid_model {
@@ -124,17 +132,248 @@ inline void reset_solvers(typename ModelType::MainModelState& state, SolverPrepa
     main_core::clear(solver_context.math_state);
     state.math_topology.clear();
     state.topo_comp_coup.reset();
+    state.y_bus_structure.clear();
+    state.comp_conn.reset();
+    state.has_branch_outages = false;
     state.comp_coup = {};
 }
 
+template <class ModelType>
+inline void assign_topology(typename ModelType::MainModelState& state, main_core::TopologyCacheEntry const& topology) {
+    state.comp_conn = topology.comp_conn;
+    state.reduced_topology = topology.reduced_topology;
+    state.math_topology = topology.math_topology;
+    state.topo_comp_coup = topology.topo_comp_coup;
+    state.y_bus_structure = topology.y_bus_structure;
+}
+
+// whether the component connections only differ from the ones of the topology by disconnected branches, which do not
+// split any math model, so that the branch outages can be calculated on the same math topology
+// the disconnected branches then have zero admittance, or only the shunt admittance of the side that is still connected
+inline bool is_branch_outage_without_islanding(main_core::TopologyCacheEntry const& topology,
+                                               ComponentConnections const& comp_conn) {
+    ComponentConnections const& base_conn = *topology.comp_conn;
+    if (comp_conn.branch3_connected != base_conn.branch3_connected ||
+        comp_conn.link_connected != base_conn.link_connected ||
+        comp_conn.branch_phase_shift != base_conn.branch_phase_shift ||
+        comp_conn.branch3_phase_shift != base_conn.branch3_phase_shift ||
+        comp_conn.source_connected != base_conn.source_connected) {
+        return false;
+    }
+    assert(comp_conn.branch_connected.size() == base_conn.branch_connected.size());
+
+    // math branches of the outages, per math model
+    std::vector<IdxVector> outages(topology.math_topology.size());
+    for (auto const& [branch_idx, base_connected, connected] :
+         std::views::zip(std::views::iota(Idx{0}), base_conn.branch_connected, comp_conn.branch_connected)) {
+        if (connected == base_connected) {
+            continue;
+        }
+        if (connected[0] > base_connected[0] || connected[1] > base_connected[1]) {
+            return false; // a branch is connected
+        }
+        if (Idx2D const math_idx = topology.topo_comp_coup->branch[branch_idx]; math_idx.group != disconnected) {
+            outages[math_idx.group].push_back(math_idx.pos);
+        }
+    }
+
+    // the buses of a math model stay connected through the other branches
+    for (auto const& [math_topo, math_outages] : std::views::zip(topology.math_topology, outages)) {
+        if (math_outages.empty()) {
+            continue;
+        }
+        auto math_branch_connected =
+            math_topo->branch_bus_idx | std::views::transform([](BranchIdx const& bus_idx) {
+                return BranchConnected{static_cast<IntS>(bus_idx[0] != disconnected),
+                                       static_cast<IntS>(bus_idx[1] != disconnected)};
+            }) |
+            std::ranges::to<std::vector>();
+        for (Idx const outage : math_outages) {
+            math_branch_connected[outage] = BranchConnected{0, 0};
+        }
+        if (supernodes::detail::find_link_connected_components(math_topo->n_bus(), math_topo->branch_bus_idx,
+                                                               math_branch_connected)
+                .n_topo_nodes() != 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// the math models of the previous topology, together with their y bus and solvers
+struct PreviousMathModels {
+    std::vector<std::shared_ptr<MathModelTopology const>> math_topology;
+    std::shared_ptr<TopologicalComponentToMathCoupling const> topo_comp_coup;
+    std::vector<std::shared_ptr<math_solver::YBusStructure const>> y_bus_structure;
+    main_core::MathState math_state;
+};
+
+// for each math model, the previous math model that has the same topology, or disconnected if there is none
+// a math model is compared with the previous math model of the topological node of its first bus. The math models of
+// the islands that are not touched by a switching change then match, because the topology search and the bus
+// ordering of an island only depend on the components of that island
+inline IdxVector
+match_unchanged_math_models(std::vector<std::shared_ptr<MathModelTopology const>> const& previous_math_topology,
+                            TopologicalComponentToMathCoupling const& previous_topo_comp_coup,
+                            std::vector<std::shared_ptr<MathModelTopology const>> const& math_topology,
+                            TopologicalComponentToMathCoupling const& topo_comp_coup) {
+    IdxVector previous_math_model(math_topology.size(), disconnected);
+    // the topological nodes are different if the links changed
+    if (previous_topo_comp_coup.node.size() != topo_comp_coup.node.size()) {
+        return previous_math_model;
+    }
+    for (auto const& [math_idx, previous_math_idx] :
+         std::views::zip(topo_comp_coup.node, previous_topo_comp_coup.node)) {
+        if (math_idx.group == disconnected || math_idx.pos != 0 || previous_math_idx.group == disconnected ||
+            previous_math_idx.pos != 0) {
+            continue;
+        }
+        if (*math_topology[math_idx.group] == *previous_math_topology[previous_math_idx.group]) {
+            previous_math_model[math_idx.group] = previous_math_idx.group;
+        }
+    }
+    return previous_math_model;
+}
+
+// use the previous math models for the math models that did not change, as their y bus and solvers refer to them
+template <class ModelType>
+inline IdxVector reuse_unchanged_math_topology(typename ModelType::MainModelState& state,
+                                               PreviousMathModels const& previous) {
+    if (previous.topo_comp_coup == nullptr) {
+        return IdxVector(state.math_topology.size(), disconnected);
+    }
+    auto previous_math_model = match_unchanged_math_models(previous.math_topology, *previous.topo_comp_coup,
+                                                           state.math_topology, *state.topo_comp_coup);
+    for (Idx const idx : IdxRange{std::ssize(state.math_topology)}) {
+        if (Idx const previous_idx = previous_math_model[idx]; previous_idx != disconnected) {
+            state.math_topology[idx] = previous.math_topology[previous_idx];
+        }
+    }
+    return previous_math_model;
+}
+
+// keep the y bus and solver of the math models that did not change, and build the ones of the other math models on
+// n_thread threads
+// the parameters of all y bus are updated, because components may have moved to another math model
+// returns whether the y bus and solvers are up to date
+template <symmetry_tag sym, class ModelType>
+inline bool reuse_unchanged_math_solvers(typename ModelType::MainModelState const& state,
+                                         SolverPreparationContext& solver_context,
+                                         main_core::MathState& previous_math_state,
+                                         IdxVector const& previous_math_model, Idx n_thread = 1) {
+    auto& previous_y_bus_vec = main_core::get_y_bus<sym>(previous_math_state);
+    auto& previous_solvers = main_core::get_solvers<sym>(previous_math_state);
+    if (previous_solvers.empty() || previous_solvers.size() != previous_y_bus_vec.size() ||
+        std::ranges::none_of(previous_math_model, [](Idx previous_idx) { return previous_idx != disconnected; })) {
+        return false;
+    }
+
+    auto& y_bus_vec = main_core::get_y_bus<sym>(solver_context.math_state);
+    auto const& other_y_bus_vec = main_core::get_y_bus<other_symmetry_t<sym>>(solver_context.math_state);
+    auto& solvers = main_core::get_solvers<sym>(solver_context.math_state);
+    assert(y_bus_vec.empty());
+    assert(solvers.empty());
+
+    Idx const n_math_solvers = std::ssize(state.math_topology);
+    auto math_params = main_core::get_math_param<sym>(state, n_math_solvers);
+    // every previous math model is matched at most once, so the islands can be built in parallel
+    auto const build_island = [&state, &solver_context, &previous_y_bus_vec, &previous_solvers, &previous_math_model,
+                               &other_y_bus_vec,
+                               &math_params](Idx idx) -> std::pair<YBus<sym>, MathSolverProxy<sym>> {
+        if (Idx const previous_idx = previous_math_model[idx]; previous_idx != disconnected) {
+            std::pair island{std::move(previous_y_bus_vec[previous_idx]), std::move(previous_solvers[previous_idx])};
+            island.first.clear_parameters_changed_callbacks();
+            return island;
+        }
+        MathSolverProxy<sym> solver{solver_context.math_solver_dispatcher, state.math_topology[idx]};
+        // construct from existing Y_bus structure if possible
+        if (!other_y_bus_vec.empty()) {
+            return {YBus<sym>{*state.math_topology[idx], std::move(math_params[idx]),
+                              other_y_bus_vec[idx].shared_y_bus_structure()},
+                    std::move(solver)};
+        }
+        if (!state.y_bus_structure.empty()) {
+            return {YBus<sym>{*state.math_topology[idx], std::move(math_params[idx]), state.y_bus_structure[idx]},
+                    std::move(solver)};
+        }
+        return {YBus<sym>{*state.math_topology[idx], std::move(math_params[idx])}, std::move(solver)};
+    };
+    y_bus_vec.reserve(n_math_solvers);
+    solvers.reserve(n_math_solvers);
+    auto const add_island = [&y_bus_vec, &solvers](auto&& island) {
+        y_bus_vec.push_back(std::move(island.first));
+        solvers.push_back(std::move(island.second));
+    };
+    if (n_thread > 1) {
+        for (auto& island :
+             main_core::build_islands_parallel(build_island, main_core::get_math_model_sizes(state.math_topology),
+                                               n_thread)) {
+            add_island(std::move(island));
+        }
+    } else {
+        for (Idx const idx : IdxRange{n_math_solvers}) {
+            add_island(build_island(idx));
+        }
+    }
+    for (Idx const idx : IdxRange{n_math_solvers}) {
+        y_bus_vec[idx].register_parameters_changed_callback(
+            [solver = std::ref(solvers[idx])](bool changed) { solver.get().get().parameters_changed(changed); });
+    }
+    for (Idx const idx : IdxRange{n_math_solvers}) {
+        if (previous_math_model[idx] != disconnected) {
+            y_bus_vec[idx].update_admittance(std::move(math_params[idx]));
+        }
+    }
+    return true;
+}
+
 template <class ModelType>
 inline void rebuild_topology(typename ModelType::MainModelState& state, SolverPreparationContext& solver_context,
-                             SolversCacheStatus<ModelType>& solvers_cache_status) {
+                             SolversCacheStatus<ModelType>& solvers_cache_status, ContingencyMode contingency_mode,
+                             Idx n_thread = 1) {
     using topology::Topology;
 
+    auto comp_conn = main_core::construct_components_connections<ModelType>(state.components);
+
+    // the math topology only depends on the component connections
+    // if they did not change, e.g. a scenario opens the same switch as the previous one, the topology and solvers
+    // can be kept and only the parameters need to be updated
+    if (state.comp_conn != nullptr && !state.math_topology.empty() && *state.comp_conn == comp_conn) {
+        state.has_branch_outages = false;
+        solvers_cache_status.set_topology_status(true);
+        solvers_cache_status.template set_parameter_status<symmetric_t>(false);
+        solvers_cache_status.template set_parameter_status<asymmetric_t>(false);
+        return;
+    }
+
+    // branch outages, e.g. of N-1 contingency scenarios, are calculated on the topology of the base case, as long as
+    // they do not split a math model
+    // the solvers of the base case are kept, which apply the changed admittances as a low-rank update
+    if (contingency_mode == ContingencyMode::low_rank_update && state.base_topology != nullptr &&
+        is_branch_outage_without_islanding(*state.base_topology, comp_conn)) {
+        if (state.comp_conn != state.base_topology->comp_conn || state.math_topology.empty()) {
+            reset_solvers(state, solver_context, solvers_cache_status);
+            assign_topology<ModelType>(state, *state.base_topology);
+        }
+        state.has_branch_outages = true;
+        solvers_cache_status.set_topology_status(true);
+        solvers_cache_status.template set_parameter_status<symmetric_t>(false);
+        solvers_cache_status.template set_parameter_status<asymmetric_t>(false);
+        return;
+    }
+
+    // keep the math models of the previous topology, so that the ones that are not touched by a local switching
+    // change can be reused together with their y bus and solvers
+    PreviousMathModels previous;
+    if (!state.has_branch_outages && state.topo_comp_coup != nullptr) {
+        previous = PreviousMathModels{.math_topology = std::move(state.math_topology),
+                                      .topo_comp_coup = state.topo_comp_coup,
+                                      .y_bus_structure = std::move(state.y_bus_structure),
+                                      .math_state = std::move(solver_context.math_state)};
+    }
+
     // clear old solvers
     reset_solvers(state, solver_context, solvers_cache_status);
-    ComponentConnections const comp_conn = main_core::construct_components_connections<ModelType>(state.components);
 
     // re build
     assert((state.comp_topo->link_node_idx.empty() ||
@@ -145,14 +384,70 @@ inline void rebuild_topology(typename ModelType::MainModelState& state, SolverPr
            "either opt-in to v2 behavior (no node injection sensors) or use old v1 behavior (links are treated as "
            "regular branches) but not both");
 
-    state.reduced_topology =
-        std::make_shared<ReducedTopology const>(supernodes::reduce_topology(*state.comp_topo, comp_conn));
-    Topology topology{state.reduced_topology->reduced_comp_topo, comp_conn};
-    std::tie(state.math_topology, state.topo_comp_coup) = topology.build_topology();
+    std::size_t const comp_conn_hash =
+        state.topology_cache != nullptr ? main_core::hash_component_connections(comp_conn) : std::size_t{0};
+    auto const cached =
+        state.topology_cache != nullptr ? state.topology_cache->find(comp_conn, comp_conn_hash) : nullptr;
+    IdxVector previous_math_model;
+    if (cached != nullptr) {
+        // same switching state as an earlier scenario (possibly of another worker)
+        assign_topology<ModelType>(state, *cached);
+        previous_math_model = reuse_unchanged_math_topology<ModelType>(state, previous);
+    } else {
+        state.reduced_topology =
+            std::make_shared<ReducedTopology const>(supernodes::reduce_topology(*state.comp_topo, comp_conn));
+        Topology topology{state.reduced_topology->reduced_comp_topo, comp_conn, SparseOrderingMethod::automatic,
+                          state.topology_cache != nullptr ? &state.topology_cache->sparse_ordering_cache() : nullptr};
+        std::tie(state.math_topology, state.topo_comp_coup) = topology.build_topology();
+        state.comp_conn = std::make_shared<ComponentConnections const>(std::move(comp_conn));
+        previous_math_model = reuse_unchanged_math_topology<ModelType>(state, previous);
+
+        if (state.topology_cache != nullptr) {
+            // the y bus structures are built upfront, so that they are shared as well on a cache hit
+            // the structures of the islands that were built before, in any switching state, are reused
+            auto const get_y_bus_structure = [&state, &previous, &previous_math_model](Idx idx) {
+                if (Idx const previous_idx = previous_math_model[idx];
+                    previous_idx != disconnected && !previous.y_bus_structure.empty()) {
+                    return previous.y_bus_structure[previous_idx];
+                }
+                return state.topology_cache->get_y_bus_structure(state.math_topology[idx]);
+            };
+            if (n_thread > 1) {
+                state.y_bus_structure = main_core::build_islands_parallel(
+                    get_y_bus_structure, main_core::get_math_model_sizes(state.math_topology), n_thread);
+            } else {
+                state.y_bus_structure.reserve(state.math_topology.size());
+                for (Idx const idx : IdxRange{std::ssize(state.math_topology)}) {
+                    state.y_bus_structure.push_back(get_y_bus_structure(idx));
+                }
+            }
+            state.topology_cache->insert(std::make_shared<main_core::TopologyCacheEntry const>(
+                main_core::TopologyCacheEntry{.hash = comp_conn_hash,
+                                              .comp_conn = state.comp_conn,
+                                              .reduced_topology = state.reduced_topology,
+                                              .math_topology = state.math_topology,
+                                              .topo_comp_coup = state.topo_comp_coup,
+                                              .y_bus_structure = state.y_bus_structure}));
+        }
+    }
+    // the first topology that is built in contingency mode is the base case of the branch outages
+    if (contingency_mode == ContingencyMode::low_rank_update && state.base_topology == nullptr) {
+        state.base_topology = std::make_shared<main_core::TopologyCacheEntry const>(
+            main_core::TopologyCacheEntry{.hash = comp_conn_hash,
+                                          .comp_conn = state.comp_conn,
+                                          .reduced_topology = state.reduced_topology,
+                                          .math_topology = state.math_topology,
+                                          .topo_comp_coup = state.topo_comp_coup,
+                                          .y_bus_structure = state.y_bus_structure});
+    }
 
     solvers_cache_status.set_topology_status(true);
-    solvers_cache_status.template set_parameter_status<symmetric_t>(false);
-    solvers_cache_status.template set_parameter_status<asymmetric_t>(false);
+    solvers_cache_status.template set_parameter_status<symmetric_t>(
+        reuse_unchanged_math_solvers<symmetric_t, ModelType>(state, solver_context, previous.math_state,
+                                                             previous_math_model, n_thread));
+    solvers_cache_status.template set_parameter_status<asymmetric_t>(
+        reuse_unchanged_math_solvers<asymmetric_t, ModelType>(state, solver_context, previous.math_state,
+                                                              previous_math_model, n_thread));
 }
 
 struct ReferenceVoltageRegulator {
@@ -236,26 +531,37 @@ template <class ModelType> inline Idx get_n_math_solvers(typename ModelType::Mai
     return static_cast<Idx>(state.math_topology.size());
 }
 
+// the y bus structures, y bus and solvers of the math models are built on n_thread threads
 template <symmetry_tag sym, class ModelType>
 inline void prepare_solvers(typename ModelType::MainModelState& state, SolverPreparationContext& solver_context,
-                            SolversCacheStatus<ModelType>& solvers_cache_status) {
+                            SolversCacheStatus<ModelType>& solvers_cache_status,
+                            ContingencyMode contingency_mode = ContingencyMode::full_rebuild, Idx n_thread = 1) {
     std::vector<MathSolverProxy<sym>>& solvers = main_core::get_solvers<sym>(solver_context.math_state);
     // rebuild topology if needed
-    if (!solvers_cache_status.is_topology_valid()) {
-        detail::rebuild_topology(state, solver_context, solvers_cache_status);
+    // branch outages on the topology of the base case are not supported by all calculations
+    if (!solvers_cache_status.is_topology_valid() ||
+        (state.has_branch_outages && contingency_mode != ContingencyMode::low_rank_update)) {
+        detail::rebuild_topology(state, solver_context, solvers_cache_status, contingency_mode, n_thread);
     }
     Idx const n_math_solvers = get_n_math_solvers<ModelType>(state);
-    main_core::prepare_y_bus<sym, ModelType>(state, n_math_solvers, solver_context.math_state);
+    main_core::prepare_y_bus<sym, ModelType>(state, n_math_solvers, solver_context.math_state, n_thread);
     if (n_math_solvers != std::ssize(solvers)) {
         assert(solvers.empty());
         assert(n_math_solvers == static_cast<Idx>(main_core::get_y_bus<sym>(solver_context.math_state).size()));
 
+        auto const create_solver = [&state, &solver_context](Idx idx) {
+            return MathSolverProxy<sym>{solver_context.math_solver_dispatcher, state.math_topology[idx]};
+        };
         solvers.clear();
-        solvers.reserve(n_math_solvers);
-        std::ranges::transform(state.math_topology, std::back_inserter(solvers),
-                               [&solver_context](auto const& math_topo) {
-                                   return MathSolverProxy<sym>{solver_context.math_solver_dispatcher, math_topo};
-                               });
+        if (n_thread > 1) {
+            solvers = main_core::build_islands_parallel(
+                create_solver, main_core::get_math_model_sizes(state.math_topology), n_thread);
+        } else {
+            solvers.reserve(n_math_solvers);
+            for (Idx const idx : IdxRange{n_math_solvers}) {
+                solvers.push_back(create_solver(idx));
+            }
+        }
         for (Idx const idx : IdxRange{n_math_solvers}) {
             main_core::get_y_bus<sym>(solver_context.math_state)[idx].register_parameters_changed_callback(
                 [solver = std::ref(solvers[idx])](bool changed) { solver.get().get().parameters_changed(changed); });
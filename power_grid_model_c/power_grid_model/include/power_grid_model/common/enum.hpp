@@ -131,6 +131,46 @@ enum class SearchMethod : IntS { // Which type of tap search method for finite e
     binary_search = 1,           // use binary search: half a tap range at a time
 };
 
+enum class BatchScheduling : IntS { // How the scenarios of a batch are distributed over the threads
+    static_stride = 0,               // thread i calculates scenarios i, i + n_thread, i + 2 * n_thread, ...
+    dynamic = 1,                     // threads pull chunks of scenarios on demand; chunk sizes shrink near the end
+};
+
+enum class ScenarioOrdering : IntS { // In which order the scenarios of a batch are calculated
+    input_order = 0,                   // in the order of the update data
+    group_by_topology = 1,             // scenarios with the same topology changes consecutively
+};
+
+enum class ScenarioTransition : IntS { // How a batch worker goes from one scenario to the next
+    restore = 0,                       // restore the original model, then apply the next update
+    delta = 1,                         // apply only the difference with the previous scenario if possible
+};
+
+enum class PowerFlowInitialization : IntS { // Start voltages of the iterative power flow methods
+    default_initialization = 0,             // flat start or linear initial guess, depending on the method
+    warm_start = 1, // solution of the previous calculation on the same model copy, if it converges
+};
+
+enum class ContingencyMode : IntS { // How branch outages, e.g. of N-1 contingency scenarios, are calculated
+    full_rebuild = 0,               // rebuild the topology and factorize the matrices of the new topology
+    low_rank_update = 1,            // keep the topology and factorization, apply the outage as a low-rank update
+};
+
+enum class FactorizationPrecision : IntS { // Precision of the sparse LU factorization of the state estimation
+    double_precision = 0,                  // factorize in double precision
+    mixed_precision = 1, // factorize in single precision and refine the solution to double precision
+};
+
+enum class IslandParallelism : IntS { // Whether the independent math models (islands) of a calculation are solved in parallel
+    sequential = 0,                     // solve the islands one after another
+    parallel = 1,                       // prepare and solve the islands concurrently, largest island first
+};
+
+enum class BatchLockstep : IntS { // Whether the scenarios of a batch that share the topology are solved in lockstep
+    disabled = 0,                   // solve every scenario on its own
+    enabled = 1,                    // solve the power flow of consecutive scenarios of a thread at once
+};
+
 enum class AngleMeasurementType : IntS { // The type of the angle measurement for current sensors
     local_angle = 0,                     // local_angle = 0, the angle is relative to the local voltage angle
     global_angle = 1,                    // global_angle = 1, the angle is relative to the global voltage angle
@@ -0,0 +1,16 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+
+#include <cstddef>
+
+namespace power_grid_model {
+
+// combine the hash of a value into a seed, in the same way as boost::hash_combine
+constexpr void combine_hash(std::size_t& seed, std::size_t value) {
+    seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6U) + (seed >> 2U);
+}
+
+} // namespace power_grid_model
@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+
+#include "common.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace power_grid_model {
+
+// bounded least-recently-used cache of immutable values, which is safe to share between threads
+//
+// an entry is looked up by its hash and a predicate that compares the value with the key of the lookup. The capacity
+// is small, so a linear scan over the entries is cheaper than building the value of a single miss.
+template <typename Value> class LruCache {
+  public:
+    explicit LruCache(Idx capacity) : capacity_{std::max(capacity, Idx{1})} {}
+
+    // the value of an entry with the hash for which match(value) holds, or nullptr
+    // the entry is marked as most recently used
+    template <std::predicate<Value const&> Match> std::shared_ptr<Value const> find(std::size_t hash, Match match) {
+        std::scoped_lock const lock{mutex_};
+        auto const it = find_entry(hash, match);
+        if (it == entries_.end()) {
+            return nullptr;
+        }
+        entries_.splice(entries_.begin(), entries_, it);
+        return entries_.front().value;
+    }
+
+    // insert the value, unless another thread inserted a matching value in the meantime, which is returned instead
+    // the least recently used entry is evicted if the cache is full
+    template <std::predicate<Value const&> Match>
+    std::shared_ptr<Value const> insert(std::size_t hash, std::shared_ptr<Value const> value, Match match) {
+        assert(value != nullptr);
+        std::scoped_lock const lock{mutex_};
+        if (auto const it = find_entry(hash, match); it != entries_.end()) {
+            return it->value;
+        }
+        entries_.push_front(Entry{.hash = hash, .value = std::move(value)});
+        if (std::ssize(entries_) > capacity_) {
+            entries_.pop_back();
+        }
+        return entries_.front().value;
+    }
+
+    Idx size() const {
+        std::scoped_lock const lock{mutex_};
+        return std::ssize(entries_);
+    }
+    Idx capacity() const { return capacity_; }
+
+  private:
+    struct Entry {
+        std::size_t hash{};
+        std::shared_ptr<Value const> value;
+    };
+
+    Idx capacity_;
+    mutable std::mutex mutex_;
+    std::list<Entry> entries_;
+
+    template <typename Match> auto find_entry(std::size_t hash, Match& match) {
+        return std::ranges::find_if(
+            entries_, [hash, &match](Entry const& entry) { return entry.hash == hash && match(*entry.value); });
+    }
+};
+
+} // namespace power_grid_model
@@ -205,7 +205,7 @@ template <std::floating_point Float> inline Float abs2(std::complex<Float> const
 
 template <column_vector_or_tensor DerivedA>
 inline auto cabs(Eigen::ArrayBase<DerivedA> const& m)
-    requires(std::same_as<typename DerivedA::Scalar, DoubleComplex>)
+    requires(std::same_as<typename DerivedA::Scalar, std::complex<typename DerivedA::RealScalar>>)
 {
     return sqrt(abs2(m));
 }
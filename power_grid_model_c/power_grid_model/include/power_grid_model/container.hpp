@@ -13,10 +13,12 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <compare>
 #include <concepts>
 #include <cstddef>
+#include <memory>
 #include <numeric>
 #include <ranges>
 #include <tuple>
@@ -59,6 +61,36 @@ constexpr size_t get_sub_cls_pos_v = get_index_bool_array(std::array{std::is_bas
 template <class T, class... SupportedTs>
 concept supported_type_c = is_in_list_c<T, SupportedTs...>;
 
+// storage that is shared between copies of a container until one of the copies needs mutable access (copy-on-write)
+// e.g. the model copies of batch worker threads only get private copies of the component types they update
+//
+// the storage is owned if no other copy refers to it anymore, e.g. after the model copies of a batch are destroyed.
+// once the reference count dropped to one, no other copy can be made from the storage concurrently, so the count cannot
+// increase again before the next copy of this container.
+// concurrent copying and reading of shared storage is safe; as for any object, a container must not be copied while it
+// is being mutated
+template <class T> class CopyOnWrite {
+  public:
+    T const& get() const {
+        assert(data_ != nullptr);
+        return *data_;
+    }
+    T& get_mutable() {
+        assert(data_ != nullptr);
+        if (is_shared()) {
+            data_ = std::make_shared<T>(*data_);
+        } else {
+            // synchronize with the release of the storage by the other copies, which may have read it
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return *data_;
+    }
+    bool is_shared() const { return data_.use_count() != 1; }
+
+  private:
+    std::shared_ptr<T> data_{std::make_shared<T>()};
+};
+
 // define what types are retrievable using sequence number
 template <class... T> struct RetrievableTypes;
 
@@ -80,7 +112,7 @@ class Container<RetrievableTypes<GettableTypes...>, StorageableTypes...> {
 
     // reserve space
     template <supported_type_c<StorageableTypes...> Storageable> void reserve(size_t size) {
-        auto& vec = std::get<std::vector<Storageable>>(vectors_);
+        auto& vec = std::get<CopyOnWrite<std::vector<Storageable>>>(vectors_).get_mutable();
         vec.reserve(size);
     }
 
@@ -88,18 +120,19 @@ class Container<RetrievableTypes<GettableTypes...>, StorageableTypes...> {
     template <supported_type_c<StorageableTypes...> Storageable, class... Args> void emplace(ID id, Args&&... args) {
         // template<class... Args> Args&&... args perfect forwarding
         assert(!construction_complete_);
+        auto& map = map_.get_mutable();
         // throw if id already exists
-        if (map_.contains(id)) {
+        if (map.contains(id)) {
             throw ConflictID{id};
         }
         // find group and position
         auto const group = static_cast<Idx>(get_cls_pos_v<Storageable, StorageableTypes...>);
-        auto& vec = std::get<std::vector<Storageable>>(vectors_);
+        auto& vec = std::get<CopyOnWrite<std::vector<Storageable>>>(vectors_).get_mutable();
         auto const pos = static_cast<Idx>(vec.size());
         // create object
         vec.emplace_back(std::forward<Args>(args)...);
         // insert idx to map
-        map_[id] = Idx2D{.group = group, .pos = pos};
+        map[id] = Idx2D{.group = group, .pos = pos};
     }
 
     // get item based on Idx2D
@@ -121,7 +154,8 @@ class Container<RetrievableTypes<GettableTypes...>, StorageableTypes...> {
 #ifndef NDEBUG
     // get id by idx, only for debugging purpose
     ID get_id_by_idx(Idx2D idx_2d) const {
-        if (auto it = std::ranges::find(map_, idx_2d, &std::pair<const ID, Idx2D>::second); it != map_.end()) {
+        auto const& map = map_.get();
+        if (auto it = std::ranges::find(map, idx_2d, &std::pair<const ID, Idx2D>::second); it != map.end()) {
             return it->first;
         }
         throw Idx2DNotFound{idx_2d};
@@ -130,8 +164,9 @@ class Container<RetrievableTypes<GettableTypes...>, StorageableTypes...> {
 
     // get idx by id
     Idx2D get_idx_by_id(ID id) const {
-        auto const found = map_.find(id);
-        if (found == map_.end()) {
+        auto const& map = map_.get();
+        auto const found = map.find(id);
+        if (found == map.end()) {
             throw IDNotFound{id};
         }
         return found->second;
@@ -183,8 +218,8 @@ class Container<RetrievableTypes<GettableTypes...>, StorageableTypes...> {
     // get sequence idx based on id
     template <supported_type_c<GettableTypes...> Gettable> Idx get_seq(ID id) const {
         assert(construction_complete_);
-        auto const found = map_.find(id);
-        assert(found != map_.end());
+        auto const found = map_.get().find(id);
+        assert(found != map_.get().end());
         return get_seq<Gettable>(found->second);
     }
 
@@ -223,9 +258,18 @@ class Container<RetrievableTypes<GettableTypes...>, StorageableTypes...> {
         cum_size_ = {accumulate_size_per_vector<GettableTypes>()...};
     };
 
+    // whether the storage of a component type is shared with another copy of this container, i.e. whether the next
+    // mutable access to it makes a private copy
+    // read-only access should go through the const overloads, as any mutable access unshares the storage
+    template <supported_type_c<StorageableTypes...> Storageable> bool is_storage_shared() const {
+        return std::get<CopyOnWrite<std::vector<Storageable>>>(vectors_).is_shared();
+    }
+
   private:
-    std::tuple<std::vector<StorageableTypes>...> vectors_;
-    std::unordered_map<ID, Idx2D> map_;
+    // component storage and id map are shared between copies of the container
+    // the id map is never modified after construction, so it is never copied afterwards
+    std::tuple<CopyOnWrite<std::vector<StorageableTypes>>...> vectors_;
+    CopyOnWrite<std::unordered_map<ID, Idx2D>> map_;
     std::array<Idx, num_gettable> size_{};
     std::array<std::array<Idx, num_storageable + 1>, num_gettable> cum_size_{};
 
@@ -238,12 +282,12 @@ class Container<RetrievableTypes<GettableTypes...>, StorageableTypes...> {
     template <supported_type_c<GettableTypes...> GettableBaseType, class StorageableSubType>
         requires std::derived_from<StorageableSubType, GettableBaseType>
     GettableBaseType& get_raw(Idx pos) {
-        return std::get<std::vector<StorageableSubType>>(vectors_)[pos];
+        return std::get<CopyOnWrite<std::vector<StorageableSubType>>>(vectors_).get_mutable()[pos];
     }
     template <supported_type_c<GettableTypes...> GettableBaseType, class StorageableSubType>
         requires std::derived_from<StorageableSubType, GettableBaseType>
     GettableBaseType const& get_raw(Idx pos) const {
-        return std::get<std::vector<StorageableSubType>>(vectors_)[pos];
+        return std::get<CopyOnWrite<std::vector<StorageableSubType>>>(vectors_).get()[pos];
     }
 
     // templates to select function pointer
@@ -279,7 +323,7 @@ class Container<RetrievableTypes<GettableTypes...>, StorageableTypes...> {
         assert(construction_complete_);
         return std::array<Idx, num_storageable>{
             std::is_base_of_v<Gettable, StorageableTypes>
-                ? static_cast<Idx>(std::get<std::vector<StorageableTypes>>(vectors_).size())
+                ? static_cast<Idx>(std::get<CopyOnWrite<std::vector<StorageableTypes>>>(vectors_).get().size())
                 : 0 ...};
     }
     // total size of a type
@@ -318,8 +362,9 @@ class Container<RetrievableTypes<GettableTypes...>, StorageableTypes...> {
             return Iterator<ConstGettable const>{container_ptr_, idx_};
         }
 
+        // read through the const container, so that reading does not unshare the storage
         constexpr Gettable const& operator*() const {
-            return container_ptr_->template get_item_by_seq<base_type>(idx_);
+            return std::as_const(*container_ptr_).template get_item_by_seq<base_type>(idx_);
         }
         constexpr Gettable& operator*() { return container_ptr_->template get_item_by_seq<base_type>(idx_); }
 
@@ -13,12 +13,19 @@
 #include "common/common.hpp"
 #include "common/exception.hpp"
 #include "common/logging.hpp"
+#include "main_core/scenario_ordering.hpp"
 #include "main_core/update.hpp"
 
 #include <algorithm>
+#include <cassert>
 #include <functional>
+#include <iterator>
 #include <memory>
 #include <span>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace power_grid_model {
 
@@ -27,6 +34,8 @@ template <class MainModel> class JobAdapter;
 template <class MainModel> class JobAdapter : public JobInterface {
   public:
     using ModelType = MainModel::ImplType;
+    // the private model copy of a worker, which can be kept between batch calculations
+    using WarmState = MainModel;
 
     JobAdapter(std::reference_wrapper<MainModel> model_reference,
                std::reference_wrapper<MainModelOptions const> options)
@@ -38,7 +47,21 @@ template <class MainModel> class JobAdapter : public JobInterface {
           components_to_update_{other.components_to_update_},
           update_independence_{other.update_independence_},
           independence_flags_{other.independence_flags_},
-          all_scenarios_sequence_{other.all_scenarios_sequence_} {}
+          all_scenarios_sequence_{other.all_scenarios_sequence_},
+          dependent_scenarios_sequence_{other.dependent_scenarios_sequence_} {}
+    // construct a worker adapter on a model copy that was kept from an earlier batch calculation
+    // the warm model must have been copied from the same model revision as other
+    JobAdapter(JobAdapter const& other, std::unique_ptr<MainModel> warm_model)
+        : model_copy_{std::move(warm_model)},
+          model_reference_{std::ref(*model_copy_)},
+          options_{std::ref(other.options_)},
+          components_to_update_{other.components_to_update_},
+          update_independence_{other.update_independence_},
+          independence_flags_{other.independence_flags_},
+          all_scenarios_sequence_{other.all_scenarios_sequence_},
+          dependent_scenarios_sequence_{other.dependent_scenarios_sequence_} {
+        assert(model_copy_ != nullptr);
+    }
     JobAdapter& operator=(JobAdapter const& other) {
         if (this != &other) {
             model_copy_ = std::make_unique<MainModel>(other.model_reference_.get());
@@ -48,6 +71,7 @@ template <class MainModel> class JobAdapter : public JobInterface {
             update_independence_ = other.update_independence_;
             independence_flags_ = other.independence_flags_;
             all_scenarios_sequence_ = other.all_scenarios_sequence_;
+            dependent_scenarios_sequence_ = other.dependent_scenarios_sequence_;
         }
         return *this;
     }
@@ -58,7 +82,10 @@ template <class MainModel> class JobAdapter : public JobInterface {
           components_to_update_{std::move(other.components_to_update_)},
           update_independence_{std::move(other.update_independence_)},
           independence_flags_{std::move(other.independence_flags_)},
-          all_scenarios_sequence_{std::move(other.all_scenarios_sequence_)} {}
+          all_scenarios_sequence_{std::move(other.all_scenarios_sequence_)},
+          dependent_scenarios_sequence_{std::move(other.dependent_scenarios_sequence_)},
+          current_scenario_sequence_{std::exchange(other.current_scenario_sequence_, {})},
+          scenario_applied_{std::exchange(other.scenario_applied_, false)} {}
     JobAdapter& operator=(JobAdapter&& other) noexcept {
         if (this != &other) {
             model_copy_ = std::move(other.model_copy_);
@@ -68,11 +95,33 @@ template <class MainModel> class JobAdapter : public JobInterface {
             update_independence_ = std::move(other.update_independence_);
             independence_flags_ = std::move(other.independence_flags_);
             all_scenarios_sequence_ = std::move(other.all_scenarios_sequence_);
+            dependent_scenarios_sequence_ = std::move(other.dependent_scenarios_sequence_);
+            current_scenario_sequence_ = std::exchange(other.current_scenario_sequence_, {});
+            scenario_applied_ = std::exchange(other.scenario_applied_, false);
         }
         return *this;
     }
     ~JobAdapter() { model_copy_.reset(); }
 
+    ModelRevisionKey warm_state_key() const { return model_reference_.get().revision_key(); }
+
+    // hand out the private model copy for reuse; the adapter must not be used afterwards
+    std::unique_ptr<MainModel> release_warm_state() {
+        // a deferred restore of the last scenario must be done before the model can be reused
+        if (scenario_applied_) {
+            restore_current_scenario_();
+        }
+        return std::move(model_copy_);
+    }
+
+    // order in which the scenarios are calculated; empty for the order of the update data
+    std::span<Idx const> scenario_order() const { return scenario_order_; }
+
+    // number of consecutive scenarios of a thread that are calculated at once
+    Idx lockstep_group_size() const {
+        return MainModel::is_lockstep_calculation(options_.get()) ? MainModel::lockstep_group_size : 1;
+    }
+
   private:
     friend class JobInterface;
 
@@ -84,14 +133,34 @@ template <class MainModel> class JobAdapter : public JobInterface {
     ModelType::UpdateIndependence update_independence_{};
     ModelType::ComponentFlags independence_flags_{};
     std::shared_ptr<typename ModelType::SequenceIdx> all_scenarios_sequence_;
-    // current_scenario_sequence_cache_ is calculated per scenario, so it is excluded from the constructors.
-    ModelType::SequenceIdx current_scenario_sequence_cache_{};
+    // sequences of the components that cannot be cached, resolved for all scenarios before the dispatch
+    std::shared_ptr<main_core::update::AllScenariosSequenceIdx<ModelType> const> dependent_scenarios_sequence_;
+    // current_scenario_sequence_ and scenario_applied_ describe the scenario that is applied to the model copy,
+    // so they are excluded from the copy constructors.
+    ModelType::SequenceIdxView current_scenario_sequence_{};
+    bool scenario_applied_{false};
+    // scenario_order_ is only used by the adapter that dispatches the batch, so it is excluded from the constructors.
+    IdxVector scenario_order_{};
 
     void calculate_impl(MutableDataset const& result_data, Idx scenario_idx, Logger& logger) const {
         MainModel::calculator(options_.get(), model_reference_.get(), result_data.get_individual_scenario(scenario_idx),
                               false, logger);
     }
 
+    template <typename SetupFn, typename WinddownFn, typename HandleExceptionFn>
+    void calculate_lockstep_impl(MutableDataset const& result_data, std::span<Idx const> scenarios, SetupFn setup,
+                                 WinddownFn winddown, HandleExceptionFn handle_exception, Logger& logger) {
+        std::vector<MutableDataset> lane_result_data;
+        lane_result_data.reserve(scenarios.size());
+        std::ranges::transform(scenarios, std::back_inserter(lane_result_data), [&result_data](Idx scenario_idx) {
+            return result_data.get_individual_scenario(scenario_idx);
+        });
+        model_reference_.get().calculate_power_flow_lockstep(
+            options_.get(), lane_result_data, [&setup, scenarios](Idx lane) { setup(scenarios[lane]); },
+            [&winddown] { winddown(); },
+            [&handle_exception, scenarios](Idx lane) { handle_exception(scenarios[lane]); }, logger);
+    }
+
     void cache_calculate_impl(Logger& logger) const {
         // calculate once to cache topology, ignore results, all math solvers are initialized
         try {
@@ -110,7 +179,8 @@ template <class MainModel> class JobAdapter : public JobInterface {
         }
     }
 
-    void prepare_job_dispatch_impl(ConstDataset const& update_data) {
+    void prepare_job_dispatch_impl(ConstDataset const& update_data, std::vector<std::string>& exceptions,
+                                   Idx threading) {
         // cache component update order where possible.
         // the order for a cacheable (independent) component by definition is the same across all scenarios
         components_to_update_ = model_reference_.get().get_components_to_update(update_data);
@@ -122,20 +192,57 @@ template <class MainModel> class JobAdapter : public JobInterface {
             std::make_shared<typename ModelType::SequenceIdx>(main_core::update::get_all_sequence_idx_map<ModelType>(
                 model_reference_.get().state().components, update_data, 0, components_to_update_, update_independence_,
                 false));
+        // resolve the ids of the other components of all scenarios in parallel, so that the workers do not need to
+        // look them up anymore
+        // this uses the threading of the batch, as the options only hold the nested threading of a single scenario
+        Idx const n_thread =
+            threading == 0 ? static_cast<Idx>(std::thread::hardware_concurrency()) : std::max(threading, Idx{1});
+        dependent_scenarios_sequence_ = std::make_shared<main_core::update::AllScenariosSequenceIdx<ModelType> const>(
+            main_core::update::resolve_all_scenarios_sequence_idx_map<ModelType>(
+                model_reference_.get().state().components, update_data, components_to_update_, update_independence_,
+                n_thread, exceptions));
+        // group scenarios with the same topology changes, so that every worker builds each topology only once
+        scenario_order_ = options_.get().scenario_ordering == ScenarioOrdering::group_by_topology
+                              ? main_core::update::topology_grouped_scenario_order<ModelType>(update_data)
+                              : IdxVector{};
     }
 
     void setup_impl(ConstDataset const& update_data, Idx scenario_idx) {
-        current_scenario_sequence_cache_ = main_core::update::get_all_sequence_idx_map<ModelType>(
-            model_reference_.get().state().components, update_data, scenario_idx, components_to_update_,
-            update_independence_, true);
+        assert(dependent_scenarios_sequence_ != nullptr);
+        auto const next_scenario_sequence = dependent_scenarios_sequence_->scenario_sequence(scenario_idx);
+
+        // the previous scenario is still applied if its restore was deferred (delta transition)
+        if (scenario_applied_) {
+            scenario_applied_ = false;
+            if (std::ranges::equal(next_scenario_sequence, current_scenario_sequence_, std::ranges::equal)) {
+                // same components in the same order: only apply the difference with the previous scenario
+                model_reference_.get().transition_components(update_data, scenario_idx,
+                                                             get_current_scenario_sequence_view_());
+                scenario_applied_ = true;
+                return;
+            }
+            restore_current_scenario_();
+        }
+
+        current_scenario_sequence_ = next_scenario_sequence;
         auto const current_scenario_sequence = get_current_scenario_sequence_view_();
         model_reference_.get().template update_components<cached_update_t>(update_data, scenario_idx,
                                                                            current_scenario_sequence);
+        scenario_applied_ = true;
     }
 
     void winddown_impl() {
+        if (scenario_applied_ && options_.get().scenario_transition == ScenarioTransition::delta) {
+            // defer the restore, so that the next scenario can transition directly from this one
+            return;
+        }
+        restore_current_scenario_();
+    }
+
+    void restore_current_scenario_() {
         model_reference_.get().restore_components(get_current_scenario_sequence_view_());
-        std::ranges::for_each(current_scenario_sequence_cache_, [](auto& comp_seq_idx) { comp_seq_idx.clear(); });
+        current_scenario_sequence_ = {};
+        scenario_applied_ = false;
     }
 
     auto get_current_scenario_sequence_view_() const {
@@ -144,7 +251,7 @@ template <class MainModel> class JobAdapter : public JobInterface {
             if (std::get<comp_idx>(independence_flags_)) {
                 return std::span<Idx2D const>{std::get<comp_idx>(*all_scenarios_sequence_)};
             }
-            return std::span<Idx2D const>{std::get<comp_idx>(current_scenario_sequence_cache_)};
+            return std::get<comp_idx>(current_scenario_sequence_);
         });
     }
 };
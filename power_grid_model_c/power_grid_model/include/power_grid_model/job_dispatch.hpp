@@ -5,22 +5,28 @@
 #pragma once
 
 #include "batch_parameter.hpp"
+#include "job_executor.hpp"
 #include "job_interface.hpp"
+#include "main_model_fwd.hpp"
 
 #include "common/common.hpp"
 #include "common/counting_iterator.hpp"
+#include "common/enum.hpp"
 #include "common/exception.hpp"
 #include "common/logging.hpp"
 #include "common/timer.hpp"
 #include "common/typing.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <concepts>
 #include <exception>
 #include <format>
 #include <iterator>
+#include <memory>
 #include <ranges>
+#include <span>
 #include <sstream>
 #include <string>
 #include <thread>
@@ -30,13 +36,69 @@
 
 namespace power_grid_model {
 
+// hands out contiguous chunks of scenarios to the worker threads on demand
+// the chunk size shrinks with the amount of remaining work (guided self-scheduling)
+// so that early chunks keep the scheduling overhead low and late chunks balance the tail of the batch
+class ScenarioScheduler {
+  public:
+    ScenarioScheduler(Idx n_scenarios, Idx n_thread) : n_scenarios_{n_scenarios}, n_thread_{std::max(Idx{1}, n_thread)} {
+        assert(n_scenarios_ >= 0);
+    }
+
+    Idx n_scenarios() const { return n_scenarios_; }
+
+    // returns an empty range when all scenarios are handed out
+    IdxRange next_chunk() {
+        Idx begin = next_.load(std::memory_order_relaxed);
+        while (begin < n_scenarios_) {
+            Idx const chunk_size = std::max(Idx{1}, (n_scenarios_ - begin) / (chunk_divisor * n_thread_));
+            Idx const end = std::min(n_scenarios_, begin + chunk_size);
+            if (next_.compare_exchange_weak(begin, end, std::memory_order_relaxed)) {
+                return IdxRange{begin, end};
+            }
+        }
+        return IdxRange{n_scenarios_, n_scenarios_};
+    }
+
+  private:
+    static constexpr Idx chunk_divisor = 2;
+
+    Idx n_scenarios_;
+    Idx n_thread_;
+    std::atomic<Idx> next_{0};
+};
+
+// adapters that can hand over their private model copy to a persistent worker, and take it back in a later batch
+template <typename Adapter>
+concept warm_state_adapter_c = requires(Adapter& adapter, Adapter const& base_adapter,
+                                        std::unique_ptr<typename Adapter::WarmState> warm_state) {
+    { base_adapter.warm_state_key() } -> std::same_as<ModelRevisionKey>;
+    { Adapter{base_adapter, std::move(warm_state)} };
+    { adapter.release_warm_state() } -> std::same_as<std::unique_ptr<typename Adapter::WarmState>>;
+};
+
+// adapters that calculate the scenarios in a different order than the update data
+// the order maps the position in the execution order to the scenario index; empty for the update data order
+template <typename Adapter>
+concept scenario_order_adapter_c = requires(Adapter const& adapter) {
+    { adapter.scenario_order() } -> std::same_as<std::span<Idx const>>;
+};
+
+// adapters that can calculate several consecutive scenarios of a thread at once, see JobInterface::calculate_lockstep
+template <typename Adapter>
+concept lockstep_adapter_c = requires(Adapter const& adapter) {
+    { adapter.lockstep_group_size() } -> std::same_as<Idx>;
+};
+
 class JobDispatch {
   public:
     template <typename Adapter, typename ResultDataset, typename UpdateDataset>
         requires std::is_base_of_v<JobInterface, Adapter>
     static BatchParameter batch_calculation(Adapter& adapter, ResultDataset const& result_data,
                                             UpdateDataset const& update_data, Idx threading,
-                                            common::logging::MultiThreadedLogger& log) {
+                                            common::logging::MultiThreadedLogger& log,
+                                            BatchScheduling scheduling = BatchScheduling::static_stride,
+                                            JobExecutor* executor = nullptr) {
         if (update_data.empty()) {
             adapter.calculate(result_data, log);
             return BatchParameter{};
@@ -57,10 +119,26 @@ class JobDispatch {
         // error messages
         std::vector<std::string> exceptions(n_scenarios, "");
 
-        adapter.prepare_job_dispatch(update_data);
-        auto single_job = JobDispatch::single_thread_job(adapter, result_data, update_data, exceptions, log);
-
-        job_dispatch(single_job, n_scenarios, threading);
+        // scenarios with errors in the update data, e.g. unknown ids, already fail here and are not calculated
+        adapter.prepare_job_dispatch(update_data, exceptions, threading);
+        if (executor != nullptr) {
+            executor_job_dispatch(*executor, adapter, result_data, update_data, exceptions, log, n_scenarios, threading,
+                                  scheduling);
+            handle_batch_exceptions(exceptions);
+            return BatchParameter{};
+        }
+        switch (scheduling) {
+        case BatchScheduling::static_stride:
+            job_dispatch(JobDispatch::single_thread_job(adapter, result_data, update_data, exceptions, log),
+                         n_scenarios, threading);
+            break;
+        case BatchScheduling::dynamic:
+            dynamic_job_dispatch(JobDispatch::dynamic_thread_job(adapter, result_data, update_data, exceptions, log),
+                                 n_scenarios, threading);
+            break;
+        default:
+            throw MissingCaseForEnumError{"JobDispatch::batch_calculation", scheduling};
+        }
 
         handle_batch_exceptions(exceptions);
 
@@ -91,49 +169,30 @@ class JobDispatch {
         return [&base_adapter, &exceptions, &result_data, &update_data, &base_log](Idx start, Idx stride,
                                                                                    Idx n_scenarios) {
             assert(n_scenarios <= narrow_cast<Idx>(exceptions.size()));
-            auto thread_log_ptr = base_log.create_child();
-            Logger& thread_log = *thread_log_ptr;
-
-            Timer t_total{thread_log, LogEvent::total_batch_calculation_in_thread};
-
-            auto const copy_adapter_functor = [&base_adapter, &thread_log]() {
-                Timer const t_copy_adapter_functor{thread_log, LogEvent::copy_model};
-                auto result = Adapter{base_adapter};
-                return result;
-            };
-
-            auto adapter = copy_adapter_functor();
-
-            auto setup = [&adapter, &update_data, &thread_log](Idx scenario_idx) {
-                Timer const t_update_model{thread_log, LogEvent::update_model};
-                adapter.setup(update_data, scenario_idx);
-            };
-
-            auto winddown = [&adapter, &thread_log]() {
-                Timer const t_restore_model{thread_log, LogEvent::restore_model};
-                adapter.winddown();
-            };
-
-            auto recover_from_bad = [&adapter, &copy_adapter_functor]() {
-                // TODO(figueroa1395): Time this step
-                // how do we want to deal with exceptions and timing?
-                adapter = copy_adapter_functor();
-            };
-
-            auto run = [&adapter, &result_data, &thread_log](Idx scenario_idx) {
-                adapter.calculate(result_data, scenario_idx, thread_log);
-            };
-
-            auto calculate_scenario = JobDispatch::call_with<Idx>(std::move(run), std::move(setup), std::move(winddown),
-                                                                  JobDispatch::scenario_exception_handler(exceptions),
-                                                                  std::move(recover_from_bad));
-
-            for (Idx scenario_idx = start; scenario_idx < n_scenarios; scenario_idx += stride) {
-                Timer const t_total_single{thread_log, LogEvent::total_single_calculation_in_thread};
-                calculate_scenario(scenario_idx);
-            }
+            run_thread_job(base_adapter, result_data, update_data, exceptions, base_log,
+                           [start, stride, n_scenarios](auto const& calculate_scenario) {
+                               for (Idx scenario_idx = start; scenario_idx < n_scenarios; scenario_idx += stride) {
+                                   calculate_scenario(scenario_idx);
+                               }
+                           });
+        };
+    }
 
-            t_total.stop();
+    template <typename Adapter, typename ResultDataset, typename UpdateDataset>
+    static auto dynamic_thread_job(Adapter& base_adapter, ResultDataset const& result_data,
+                                   UpdateDataset const& update_data, std::vector<std::string>& exceptions,
+                                   common::logging::MultiThreadedLogger& base_log) {
+        return [&base_adapter, &exceptions, &result_data, &update_data, &base_log](ScenarioScheduler& scheduler) {
+            assert(scheduler.n_scenarios() <= narrow_cast<Idx>(exceptions.size()));
+            run_thread_job(base_adapter, result_data, update_data, exceptions, base_log,
+                           [&scheduler](auto const& calculate_scenario) {
+                               for (auto chunk = scheduler.next_chunk(); !chunk.empty();
+                                    chunk = scheduler.next_chunk()) {
+                                   for (Idx const scenario_idx : chunk) {
+                                       calculate_scenario(scenario_idx);
+                                   }
+                               }
+                           });
         };
     }
 
@@ -159,16 +218,93 @@ class JobDispatch {
         }
     }
 
-    // run sequential if
-    //    specified threading < 0
-    //    use hardware threads, but it is either unknown (0) or only has one thread (1)
-    //    specified threading = 1
-    static Idx n_threads(Idx n_scenarios, Idx threading) {
-        auto const hardware_thread = static_cast<Idx>(std::jthread::hardware_concurrency());
-        if (threading < 0 || threading == 1 || (threading == 0 && hardware_thread < 2)) {
+    template <typename RunDynamicJobFn>
+        requires std::invocable<std::remove_cvref_t<RunDynamicJobFn>, ScenarioScheduler&>
+    static void dynamic_job_dispatch(RunDynamicJobFn dynamic_thread_job, Idx n_scenarios, Idx threading) {
+        auto const n_thread = n_threads(n_scenarios, threading);
+        ScenarioScheduler scheduler{n_scenarios, n_thread};
+        if (n_thread == 1) {
+            // run all in sequential
+            dynamic_thread_job(scheduler);
+        } else {
+            // create parallel threads that all pull their scenarios from the same scheduler
+            std::vector<std::jthread> threads;
+            threads.reserve(n_thread);
+            for (Idx thread_number = 0; thread_number < n_thread; ++thread_number) {
+                threads.emplace_back(dynamic_thread_job, std::ref(scheduler));
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        }
+    }
+
+    // run the batch on the persistent workers of the executor
+    // the workers keep their private model copy between batch calculations on the same model revision
+    template <typename Adapter, typename ResultDataset, typename UpdateDataset>
+    static void executor_job_dispatch(JobExecutor& executor, Adapter& base_adapter, ResultDataset const& result_data,
+                                      UpdateDataset const& update_data, std::vector<std::string>& exceptions,
+                                      common::logging::MultiThreadedLogger& base_log, Idx n_scenarios, Idx threading,
+                                      BatchScheduling scheduling) {
+        assert(n_scenarios <= narrow_cast<Idx>(exceptions.size()));
+
+        Idx const n_worker = n_executor_workers(n_scenarios, threading, executor.n_threads());
+        ScenarioScheduler scheduler{n_scenarios, n_worker};
+
+        auto worker_job = [&executor, &base_adapter, &result_data, &update_data, &exceptions, &base_log, &scheduler,
+                           n_worker, n_scenarios, scheduling](Idx worker_idx) {
+            auto& warm_slot = executor.warm_slot(worker_idx);
+            switch (scheduling) {
+            case BatchScheduling::static_stride:
+                run_thread_job(
+                    base_adapter, result_data, update_data, exceptions, base_log,
+                    [worker_idx, n_worker, n_scenarios](auto const& calculate_scenario) {
+                        for (Idx scenario_idx = worker_idx; scenario_idx < n_scenarios; scenario_idx += n_worker) {
+                            calculate_scenario(scenario_idx);
+                        }
+                    },
+                    &warm_slot);
+                break;
+            case BatchScheduling::dynamic:
+                run_thread_job(
+                    base_adapter, result_data, update_data, exceptions, base_log,
+                    [&scheduler](auto const& calculate_scenario) {
+                        for (auto chunk = scheduler.next_chunk(); !chunk.empty(); chunk = scheduler.next_chunk()) {
+                            for (Idx const scenario_idx : chunk) {
+                                calculate_scenario(scenario_idx);
+                            }
+                        }
+                    },
+                    &warm_slot);
+                break;
+            default:
+                throw MissingCaseForEnumError{"JobDispatch::executor_job_dispatch", scheduling};
+            }
+        };
+        executor.run(n_worker, worker_job);
+    }
+
+    // same rules as n_threads, but bounded by the size of the executor
+    // a sequential run still uses a worker of the executor, so that its warm state can be reused
+    static Idx n_executor_workers(Idx n_scenarios, Idx threading, Idx n_executor_threads) {
+        if (threading < 0 || threading == 1) {
             return 1; // sequential
         }
-        return std::min(threading == 0 ? hardware_thread : threading, n_scenarios);
+        Idx const requested = threading == 0 ? n_executor_threads : threading;
+        return std::max(Idx{1}, std::min({requested, n_executor_threads, n_scenarios}));
+    }
+
+    // see n_job_threads
+    static Idx n_threads(Idx n_scenarios, Idx threading) { return n_job_threads(n_scenarios, threading); }
+
+    // threading setting for the parallelism within a scenario, e.g. solving the islands of a scenario in parallel
+    // the threads that are not used by the batch itself are evenly divided over the concurrently running scenarios
+    static Idx nested_threading(Idx n_scenarios, Idx threading) {
+        auto const hardware_thread = static_cast<Idx>(std::jthread::hardware_concurrency());
+        Idx const n_batch_thread = std::max(Idx{1}, n_threads(n_scenarios, threading));
+        Idx const n_total_thread = threading == 0 ? hardware_thread : threading;
+        Idx const n_nested_thread = n_total_thread / n_batch_thread;
+        return n_nested_thread < 2 ? MainModelOptions::sequential : n_nested_thread;
     }
 
     template <typename... Args, typename RunFn, typename SetupFn, typename WinddownFn, typename HandleExceptionFn,
@@ -222,6 +358,129 @@ class JobDispatch {
                                         std::move(err_msgs));
         }
     }
+
+  private:
+    // set up a private copy of the adapter and run the scenarios that are handed out by for_each_scenario
+    // if a warm slot is provided, the private copy is taken from it (when still valid) and handed back afterwards
+    template <typename Adapter, typename ResultDataset, typename UpdateDataset, typename ForEachScenarioFn>
+    static void run_thread_job(Adapter& base_adapter, ResultDataset const& result_data,
+                               UpdateDataset const& update_data, std::vector<std::string>& exceptions,
+                               common::logging::MultiThreadedLogger& base_log, ForEachScenarioFn for_each_scenario,
+                               WarmSlot* warm_slot = nullptr) {
+        auto thread_log_ptr = base_log.create_child();
+        Logger& thread_log = *thread_log_ptr;
+
+        Timer t_total{thread_log, LogEvent::total_batch_calculation_in_thread};
+
+        auto const copy_adapter_functor = [&base_adapter, &thread_log]() {
+            Timer const t_copy_adapter_functor{thread_log, LogEvent::copy_model};
+            auto result = Adapter{base_adapter};
+            return result;
+        };
+
+        auto adapter = [&base_adapter, &copy_adapter_functor, warm_slot]() {
+            if constexpr (warm_state_adapter_c<Adapter>) {
+                if (warm_slot != nullptr) {
+                    if (auto warm_state = warm_slot->take<typename Adapter::WarmState>(base_adapter.warm_state_key());
+                        warm_state != nullptr) {
+                        return Adapter{base_adapter, std::move(warm_state)};
+                    }
+                }
+            } else {
+                (void)warm_slot;
+            }
+            return copy_adapter_functor();
+        }();
+
+        auto setup = [&adapter, &update_data, &thread_log](Idx scenario_idx) {
+            Timer const t_update_model{thread_log, LogEvent::update_model};
+            adapter.setup(update_data, scenario_idx);
+        };
+
+        auto winddown = [&adapter, &thread_log]() {
+            Timer const t_restore_model{thread_log, LogEvent::restore_model};
+            adapter.winddown();
+        };
+
+        auto recover_from_bad = [&adapter, &copy_adapter_functor]() {
+            // TODO(figueroa1395): Time this step
+            // how do we want to deal with exceptions and timing?
+            adapter = copy_adapter_functor();
+        };
+
+        auto run = [&adapter, &result_data, &thread_log](Idx scenario_idx) {
+            adapter.calculate(result_data, scenario_idx, thread_log);
+        };
+
+        auto calculate_scenario = JobDispatch::call_with<Idx>(
+            std::move(run), setup, winddown, JobDispatch::scenario_exception_handler(exceptions), recover_from_bad);
+
+        // consecutive scenarios of the thread that are calculated at once
+        Idx const group_size = [&adapter] {
+            if constexpr (lockstep_adapter_c<Adapter>) {
+                return adapter.lockstep_group_size();
+            } else {
+                return Idx{1};
+            }
+        }();
+        IdxVector group;
+        group.reserve(group_size);
+        auto const calculate_group = [&adapter, &result_data, &exceptions, &thread_log, &setup, &winddown,
+                                      &recover_from_bad, &calculate_scenario, &group] {
+            if constexpr (lockstep_adapter_c<Adapter>) {
+                if (group.size() > 1) {
+                    Timer const t_total_single{thread_log, LogEvent::total_single_calculation_in_thread};
+                    try {
+                        adapter.calculate_lockstep(result_data, group, setup, winddown,
+                                                   JobDispatch::scenario_exception_handler(exceptions), thread_log);
+                    } catch (...) { // NOSONAR(S2738)
+                        // a scenario could not be restored, so the model copy is replaced and all scenarios of the
+                        // group are calculated again one by one
+                        recover_from_bad();
+                        for (Idx const scenario_idx : group) {
+                            exceptions[scenario_idx].clear();
+                            calculate_scenario(scenario_idx);
+                        }
+                    }
+                    group.clear();
+                    return;
+                }
+            }
+            for (Idx const scenario_idx : group) {
+                Timer const t_total_single{thread_log, LogEvent::total_single_calculation_in_thread};
+                calculate_scenario(scenario_idx);
+            }
+            group.clear();
+        };
+
+        auto const scenario_order = [&base_adapter] {
+            if constexpr (scenario_order_adapter_c<Adapter>) {
+                return base_adapter.scenario_order();
+            } else {
+                return std::span<Idx const>{};
+            }
+        }();
+
+        for_each_scenario([&calculate_group, &exceptions, &group, group_size, scenario_order](Idx position) {
+            Idx const scenario_idx = scenario_order.empty() ? position : scenario_order[position];
+            if (!exceptions[scenario_idx].empty()) {
+                return; // already failed while preparing the job dispatch
+            }
+            group.push_back(scenario_idx);
+            if (std::ssize(group) == group_size) {
+                calculate_group();
+            }
+        });
+        calculate_group();
+
+        if constexpr (warm_state_adapter_c<Adapter>) {
+            if (warm_slot != nullptr) {
+                warm_slot->store(base_adapter.warm_state_key(), adapter.release_warm_state());
+            }
+        }
+
+        t_total.stop();
+    }
 };
 
 } // namespace power_grid_model
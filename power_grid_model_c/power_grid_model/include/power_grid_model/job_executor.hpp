@@ -0,0 +1,238 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+
+// persistent worker threads for batch calculations
+
+#include "main_model_fwd.hpp"
+
+#include "common/common.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace power_grid_model {
+
+// per-worker storage of state that is expensive to rebuild, e.g. the private model copy of a worker.
+// the state is only handed out again if it was derived from the same model revision.
+class WarmSlot {
+  public:
+    template <typename T> std::unique_ptr<T> take(ModelRevisionKey const& key) {
+        if (state_ == nullptr || key_ != key) {
+            clear();
+            return nullptr;
+        }
+        auto* const holder = dynamic_cast<Holder<T>*>(state_.get());
+        if (holder == nullptr) {
+            clear();
+            return nullptr;
+        }
+        auto result = std::move(holder->value);
+        clear();
+        return result;
+    }
+
+    template <typename T> void store(ModelRevisionKey const& key, std::unique_ptr<T> value) {
+        if (value == nullptr) {
+            clear();
+            return;
+        }
+        key_ = key;
+        state_ = std::make_unique<Holder<T>>(std::move(value));
+    }
+
+    void clear() {
+        key_ = {};
+        state_.reset();
+    }
+
+    bool empty() const { return state_ == nullptr; }
+
+  private:
+    struct HolderBase {
+        HolderBase() = default;
+        HolderBase(HolderBase const&) = delete;
+        HolderBase& operator=(HolderBase const&) = delete;
+        HolderBase(HolderBase&&) = delete;
+        HolderBase& operator=(HolderBase&&) = delete;
+        virtual ~HolderBase() = default;
+    };
+    template <typename T> struct Holder final : HolderBase {
+        explicit Holder(std::unique_ptr<T> value_) : value{std::move(value_)} {}
+        std::unique_ptr<T> value;
+    };
+
+    ModelRevisionKey key_{};
+    std::unique_ptr<HolderBase> state_;
+};
+
+// number of threads to run a number of independent jobs with, e.g. the scenarios of a batch or the islands of a
+// calculation, given the threading option of the calculation
+// run sequential if
+//    specified threading < 0
+//    use hardware threads, but it is either unknown (0) or only has one thread (1)
+//    specified threading = 1
+inline Idx n_job_threads(Idx n_jobs, Idx threading) {
+    auto const hardware_thread = static_cast<Idx>(std::thread::hardware_concurrency());
+    if (threading < 0 || threading == 1 || (threading == 0 && hardware_thread < 2)) {
+        return 1; // sequential
+    }
+    return std::min(threading == 0 ? hardware_thread : threading, n_jobs);
+}
+
+// pool of worker threads that stays alive between batch calculations
+//
+// run() executes a job on a number of workers concurrently and blocks until all of them are done.
+// concurrent calls to run() on the same executor are serialized.
+class JobExecutor {
+  public:
+    // n_thread <= 0: use the number of hardware threads
+    explicit JobExecutor(Idx n_thread = 0) {
+        auto const hardware_thread = static_cast<Idx>(std::thread::hardware_concurrency());
+        Idx const n_worker = n_thread > 0 ? n_thread : std::max(Idx{1}, hardware_thread);
+        warm_slots_.resize(n_worker);
+        workers_.reserve(n_worker);
+        for (Idx worker_idx = 0; worker_idx != n_worker; ++worker_idx) {
+            workers_.emplace_back([this, worker_idx] { worker_loop(worker_idx); });
+        }
+    }
+    JobExecutor(JobExecutor const&) = delete;
+    JobExecutor& operator=(JobExecutor const&) = delete;
+    JobExecutor(JobExecutor&&) = delete;
+    JobExecutor& operator=(JobExecutor&&) = delete;
+    ~JobExecutor() {
+        {
+            std::scoped_lock const lock{mutex_};
+            stop_ = true;
+        }
+        task_cv_.notify_all();
+        workers_.clear(); // joins
+    }
+
+    Idx n_threads() const { return std::ssize(workers_); }
+
+    // the warm slot may only be accessed by the worker itself while a job is running
+    WarmSlot& warm_slot(Idx worker_idx) {
+        assert(0 <= worker_idx && worker_idx < std::ssize(warm_slots_));
+        return warm_slots_[worker_idx];
+    }
+
+    // drop all warm state, e.g. to release memory
+    void clear_warm_slots() {
+        std::scoped_lock const run_lock{run_mutex_};
+        std::ranges::for_each(warm_slots_, [](WarmSlot& slot) { slot.clear(); });
+    }
+
+    // run job(worker_idx) on workers 0, ..., n_worker - 1 and wait until all are finished
+    // the first exception thrown by any of the workers is rethrown in the calling thread
+    template <typename WorkerJob>
+        requires std::invocable<WorkerJob&, Idx>
+    void run(Idx n_worker, WorkerJob& job) {
+        std::scoped_lock const run_lock{run_mutex_};
+        n_worker = std::clamp(n_worker, Idx{1}, n_threads());
+
+        std::unique_lock lock{mutex_};
+        task_ = [&job](Idx worker_idx) { job(worker_idx); };
+        n_active_ = n_worker;
+        n_remaining_ = n_worker;
+        exception_ = nullptr;
+        ++generation_;
+        lock.unlock();
+        task_cv_.notify_all();
+
+        lock.lock();
+        done_cv_.wait(lock, [this] { return n_remaining_ == 0; });
+        task_ = {};
+        if (auto const ex = std::exchange(exception_, nullptr); ex != nullptr) {
+            std::rethrow_exception(ex);
+        }
+    }
+
+  private:
+    std::mutex run_mutex_;
+    std::mutex mutex_;
+    std::condition_variable task_cv_;
+    std::condition_variable done_cv_;
+
+    std::function<void(Idx)> task_;
+    std::uint64_t generation_{0};
+    Idx n_active_{0};
+    Idx n_remaining_{0};
+    std::exception_ptr exception_;
+    bool stop_{false};
+
+    std::vector<WarmSlot> warm_slots_;
+    // declared last, so that the workers are joined before the state above is destroyed
+    std::vector<std::jthread> workers_;
+
+    void worker_loop(Idx worker_idx) {
+        std::uint64_t seen_generation{0};
+        while (true) {
+            {
+                std::unique_lock lock{mutex_};
+                task_cv_.wait(lock, [this, seen_generation] { return stop_ || generation_ != seen_generation; });
+                if (stop_) {
+                    return;
+                }
+                seen_generation = generation_;
+                if (worker_idx >= n_active_) {
+                    continue;
+                }
+            }
+            // task_ is not modified until all active workers are done
+            try {
+                task_(worker_idx);
+            } catch (...) { // NOSONAR(S2738)
+                std::scoped_lock const lock{mutex_};
+                if (exception_ == nullptr) {
+                    exception_ = std::current_exception();
+                }
+            }
+            {
+                std::scoped_lock const lock{mutex_};
+                if (--n_remaining_ == 0) {
+                    done_cv_.notify_one();
+                }
+            }
+        }
+    }
+};
+
+// persistent worker threads of a single model instance, created on first use
+// a copy of the model gets its own workers, so that concurrently running copies, e.g. the model copies of the
+// workers of a batch, do not wait for each other
+class LazyJobExecutor {
+  public:
+    LazyJobExecutor() = default;
+    LazyJobExecutor(LazyJobExecutor const& /*other*/) {}
+    LazyJobExecutor& operator=(LazyJobExecutor const& /*other*/) { return *this; }
+    LazyJobExecutor(LazyJobExecutor&&) noexcept = default;
+    LazyJobExecutor& operator=(LazyJobExecutor&&) noexcept = default;
+    ~LazyJobExecutor() = default;
+
+    // executor with at least n_thread workers
+    JobExecutor& get(Idx n_thread) {
+        if (executor_ == nullptr || executor_->n_threads() < n_thread) {
+            executor_.reset(); // join the old workers first
+            executor_ = std::make_unique<JobExecutor>(n_thread);
+        }
+        return *executor_;
+    }
+
+  private:
+    std::unique_ptr<JobExecutor> executor_;
+};
+
+} // namespace power_grid_model
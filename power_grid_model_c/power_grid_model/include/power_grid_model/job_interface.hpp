@@ -10,7 +10,10 @@
 #include "common/logging.hpp"
 
 #include <concepts>
+#include <span>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace power_grid_model {
 class JobInterface {
@@ -30,6 +33,22 @@ class JobInterface {
         self.calculate(result_data, Idx{}, logger);
     }
 
+    // calculate several scenarios at once; setup(scenario_idx) and winddown() apply and restore a single scenario
+    // errors that are specific to a scenario are reported by handle_exception(scenario_idx) instead of thrown
+    template <typename Self, typename ResultDataset, typename SetupFn, typename WinddownFn, typename HandleExceptionFn>
+    void calculate_lockstep(this Self& self, ResultDataset const& result_data, std::span<Idx const> scenarios,
+                            SetupFn setup, WinddownFn winddown, HandleExceptionFn handle_exception, Logger& logger)
+        requires requires { // NOSONAR
+            {
+                self.calculate_lockstep_impl(result_data, scenarios, std::move(setup), std::move(winddown),
+                                             std::move(handle_exception), logger)
+            } -> std::same_as<void>;
+        }
+    {
+        return self.calculate_lockstep_impl(result_data, scenarios, std::move(setup), std::move(winddown),
+                                            std::move(handle_exception), logger);
+    }
+
     template <typename Self>
     void cache_calculate(this Self& self, Logger& logger)
         requires requires { // NOSONAR
@@ -39,13 +58,16 @@ class JobInterface {
         return self.cache_calculate_impl(logger);
     }
 
+    // errors that are specific to a scenario are stored in exceptions[scenario_idx] instead of thrown
+    // threading is the threading of the batch itself, not the nested threading of a single scenario
     template <typename Self, typename UpdateDataset>
-    void prepare_job_dispatch(this Self& self, UpdateDataset const& update_data)
+    void prepare_job_dispatch(this Self& self, UpdateDataset const& update_data, std::vector<std::string>& exceptions,
+                              Idx threading)
         requires requires { // NOSONAR
-            { self.prepare_job_dispatch_impl(update_data) } -> std::same_as<void>;
+            { self.prepare_job_dispatch_impl(update_data, exceptions, threading) } -> std::same_as<void>;
         }
     {
-        return self.prepare_job_dispatch_impl(update_data);
+        return self.prepare_job_dispatch_impl(update_data, exceptions, threading);
     }
 
     template <typename Self, typename UpdateDataset>
@@ -11,20 +11,20 @@
 
 #include <algorithm>
 #include <array>
+#include <cassert>
 #include <cstdint>
+#include <iterator>
 #include <optional>
 #include <ranges>
 #include <span>
-#include <unordered_map>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
 namespace power_grid_model::link_solver {
 namespace detail {
 
-using AdjacencyMap = std::unordered_map<Idx, std::unordered_set<Idx>>;
-using ContractedEdgesSet = std::unordered_set<Idx>;
+// flag per edge whether it is contracted to a point
+using ContractedEdges = std::vector<std::uint8_t>;
 
 enum class EdgeEvent : std::uint8_t {
     deleted = 0,            // pivot edge - used as pivot row
@@ -34,36 +34,88 @@ enum class EdgeEvent : std::uint8_t {
 
 enum class EdgeDirection : IntS { outgoing = -1, incoming = 1 };
 
-// Coordinate list (COO) sparse matrix representation, optimized for incremental construction during forward elimination
-struct CooSparseMatrix {
-    Idx row_number{};
-    std::unordered_map<Idx, IntS> data_map{};
+struct SparseEntry {
+    Idx col{};
+    IntS value{};
+};
+
+// sparse matrix with the entries of each row in a vector sorted by column, optimized for incremental construction
+// during forward elimination and for row-wise traversal during backward substitution and the projection
+// rows are created on demand
+class SparseRowMatrix {
+  public:
+    void prepare(Idx col_size, Idx row_size = 0) {
+        col_number_ = col_size;
+        rows_.assign(row_size, {});
+        nnz_ = 0;
+    }
+
+    Idx nnz() const { return nnz_; }
+    Idx n_rows() const { return std::ssize(rows_); }
+
+    std::span<SparseEntry const> row(Idx row_idx) const {
+        if (row_idx >= n_rows()) {
+            return {};
+        }
+        return rows_[row_idx];
+    }
 
-    void prepare(Idx col_size) { row_number = col_size; }
     void set_value(IntS value, Idx row_idx, Idx col_idx) {
-        assert(row_number != 0 && "row_number must be set before setting values in data_map");
-        data_map[row_idx * row_number + col_idx] = value;
+        assert(col_number_ != 0 && "col_number must be set before setting values in the matrix");
+        auto& entries = get_row(row_idx);
+        auto const it = find_entry(entries, col_idx);
+        if (it != entries.end() && it->col == col_idx) {
+            it->value = value;
+        } else {
+            entries.insert(it, SparseEntry{.col = col_idx, .value = value});
+            ++nnz_;
+        }
     }
     std::optional<IntS> get_value(Idx row_idx, Idx col_idx) const {
-        assert(row_number != 0 && "row_number must be set before getting values from data_map");
-        if (auto const it = data_map.find(row_idx * row_number + col_idx); it != data_map.end()) {
-            return it->second;
+        assert(col_number_ != 0 && "col_number must be set before getting values from the matrix");
+        auto const entries = row(row_idx);
+        if (auto const it = find_entry(entries, col_idx); it != entries.end() && it->col == col_idx) {
+            return it->value;
         }
         return std::nullopt;
     }
     void add_to_value(IntS value, Idx row_idx, Idx col_idx) {
-        assert(row_number != 0 && "row_number must be set before adding values in data_map");
-        auto const key = row_idx * row_number + col_idx;
-        if (auto const it = data_map.find(key); it != data_map.end()) {
-            auto const new_value = narrow_cast<IntS>(it->second + value);
+        assert(col_number_ != 0 && "col_number must be set before adding values in the matrix");
+        auto& entries = get_row(row_idx);
+        auto const it = find_entry(entries, col_idx);
+        if (it != entries.end() && it->col == col_idx) {
+            auto const new_value = narrow_cast<IntS>(it->value + value);
             if (new_value == 0) {
-                data_map.erase(it); // maintain sparsity by erasing zero entries
+                entries.erase(it); // maintain sparsity by erasing zero entries
+                --nnz_;
                 return;
             }
-            it->second = new_value;
+            it->value = new_value;
         } else if (value != 0) {
-            data_map[key] = value;
+            entries.insert(it, SparseEntry{.col = col_idx, .value = value});
+            ++nnz_;
+        }
+    }
+
+  private:
+    Idx col_number_{};
+    Idx nnz_{};
+    std::vector<std::vector<SparseEntry>> rows_;
+
+    std::vector<SparseEntry>& get_row(Idx row_idx) {
+        if (row_idx >= n_rows()) {
+            rows_.resize(row_idx + 1);
+        }
+        return rows_[row_idx];
+    }
+
+    // the entries are mostly appended in ascending column order, so check the back first
+    template <typename Entries>
+    static auto find_entry(Entries& entries, Idx col_idx) -> std::ranges::iterator_t<Entries> {
+        if (entries.empty() || entries.back().col < col_idx) {
+            return entries.end();
         }
+        return std::ranges::lower_bound(entries, col_idx, {}, &SparseEntry::col);
     }
 };
 
@@ -73,7 +125,7 @@ struct EdgeHistory {
 };
 
 struct ReducedEchelonForm {
-    CooSparseMatrix matrix{};
+    SparseRowMatrix matrix{};
     std::vector<DoubleComplex> rhs{};         // RHS value at each pivot row
     std::vector<Idx> free_edge_indices{};     // index of degrees of freedom (self loop edges)
     std::vector<Idx> pivot_edge_indices{};    // index of pivot edges
@@ -87,14 +139,81 @@ constexpr Idx to_node(BranchIdx const& edge) { return edge[1]; }
 constexpr void re_attach_to_node(Idx new_node, BranchIdx& edge) { edge[1] = new_node; }
 
 // map from node index to the set of adjacent edge indices
-// unordered_map because node IDs may be sparse/non-contiguous
-// unordered_set for O(1) insert/erase during reattachment
+// node indices are contiguous, so the edges of each node are kept in a flat vector per node
+// an edge is in the set of at most two nodes, which are stored per edge for O(1) insert/erase during reattachment
+// erased edges are only dropped from the vector of a node when the edges of that node are collected
+class AdjacencyMap {
+  public:
+    AdjacencyMap(Idx n_node, Idx n_edge) : node_edges_(n_node), edge_nodes_(n_edge, {na_Idx, na_Idx}) {}
+
+    Idx size() const { return std::ssize(node_edges_); }
+
+    bool contains(Idx node, Idx edge) const {
+        auto const& nodes = edge_nodes_[edge];
+        return nodes[0] == node || nodes[1] == node;
+    }
+    void insert(Idx node, Idx edge) {
+        if (contains(node, edge)) {
+            return;
+        }
+        auto& nodes = edge_nodes_[edge];
+        assert(nodes[0] == na_Idx || nodes[1] == na_Idx);
+        nodes[nodes[0] == na_Idx ? 0 : 1] = node;
+        node_edges_[node].push_back(edge);
+    }
+    void erase(Idx node, Idx edge) {
+        for (Idx& edge_node : edge_nodes_[edge]) {
+            if (edge_node == node) {
+                edge_node = na_Idx;
+            }
+        }
+    }
+
+    // adjacent edges of a node in ascending order
+    IdxVector at(Idx node) const {
+        IdxVector edges;
+        std::ranges::copy_if(node_edges_[node], std::back_inserter(edges),
+                             [this, node](Idx edge) { return contains(node, edge); });
+        sort_unique(edges);
+        return edges;
+    }
+
+    // move all adjacent edges of the source node to the target node
+    // the moved edges are written in ascending order into the moved_edges workspace
+    void move_edges(Idx source_node, Idx target_node, IdxVector& moved_edges) {
+        auto& source_edges = node_edges_[source_node];
+        moved_edges.clear();
+        std::ranges::copy_if(source_edges, std::back_inserter(moved_edges),
+                             [this, source_node](Idx edge) { return contains(source_node, edge); });
+        source_edges.clear();
+        sort_unique(moved_edges);
+        for (Idx const edge : moved_edges) {
+            erase(source_node, edge);
+            insert(target_node, edge);
+        }
+    }
+
+  private:
+    std::vector<IdxVector> node_edges_;
+    std::vector<std::array<Idx, 2>> edge_nodes_;
+
+    static void sort_unique(IdxVector& edges) {
+        std::ranges::sort(edges);
+        auto const [first, last] = std::ranges::unique(edges);
+        edges.erase(first, last);
+    }
+};
+
 inline auto build_adjacency_map(std::span<BranchIdx const> edges) -> AdjacencyMap {
-    AdjacencyMap adjacency_map{};
+    Idx n_node{};
+    for (auto const& [from_node, to_node] : edges) {
+        n_node = std::max({n_node, from_node + 1, to_node + 1});
+    }
+    AdjacencyMap adjacency_map{n_node, std::ssize(edges)};
     for (auto const& [index, edge] : enumerate(edges)) {
         auto const [from_node, to_node] = edge;
-        adjacency_map[from_node].insert(index);
-        adjacency_map[to_node].insert(index);
+        adjacency_map.insert(from_node, index);
+        adjacency_map.insert(to_node, index);
     }
     return adjacency_map;
 }
@@ -105,7 +224,7 @@ inline void write_edge_history(EdgeHistory& edges_history, EdgeEvent event, Idx
 }
 
 inline void replace_and_write(Idx edge_idx, Idx from_node_idx, Idx to_node_idx, Idx matrix_row,
-                              std::vector<BranchIdx>& edges, CooSparseMatrix& matrix) {
+                              std::vector<BranchIdx>& edges, SparseRowMatrix& matrix) {
     using enum EdgeDirection;
 
     auto& edge = edges[edge_idx];
@@ -119,13 +238,13 @@ inline void replace_and_write(Idx edge_idx, Idx from_node_idx, Idx to_node_idx,
 }
 
 inline void update_edge_info(Idx edge_idx, Idx matrix_row, std::vector<BranchIdx>& edges,
-                             std::vector<EdgeHistory>& edges_history, ContractedEdgesSet& edges_contracted_to_point) {
+                             std::vector<EdgeHistory>& edges_history, ContractedEdges& edges_contracted_to_point) {
     using enum EdgeEvent;
 
     auto const& edge = edges[edge_idx];
     if (from_node(edge) == to_node(edge)) {
         write_edge_history(edges_history[edge_idx], contracted_to_point, matrix_row);
-        edges_contracted_to_point.insert(edge_idx);
+        edges_contracted_to_point[edge_idx] = 1;
     } else {
         write_edge_history(edges_history[edge_idx], replaced, matrix_row);
     }
@@ -141,10 +260,11 @@ inline void forward_elimination(ReducedEchelonForm& result, std::vector<BranchId
 
     Idx matrix_row{};
     auto adjacency_map = build_adjacency_map(edges);
-    ContractedEdgesSet edges_contracted_to_point{};
+    ContractedEdges edges_contracted_to_point(edges.size());
+    IdxVector adjacent_edges_snapshot; // workspace, reused for every pivot
 
     for (auto const& [index, edge] : enumerate(std::as_const(edges))) {
-        if (edges_contracted_to_point.contains(index)) {
+        if (edges_contracted_to_point[index] != 0) {
             result.free_edge_indices.push_back(index);
         } else {
             write_edge_history(result.edges_history[index], deleted, matrix_row); // Delete edge -> pivot there
@@ -153,28 +273,22 @@ inline void forward_elimination(ReducedEchelonForm& result, std::vector<BranchId
 
             Idx const from_node_idx = from_node(edge);
             Idx const to_node_idx = to_node(edge);
-            auto& adjacency_map_at_from_node = adjacency_map[from_node_idx];
-            auto& adjacency_map_at_to_node = adjacency_map[to_node_idx];
 
             // update adjacency list for deleted edge
-            adjacency_map_at_from_node.erase(index);
-            adjacency_map_at_to_node.erase(index);
+            adjacency_map.erase(from_node_idx, index);
+            adjacency_map.erase(to_node_idx, index);
 
             // Gaussian elimination like steps
             node_loads[from_node_idx] += node_loads[to_node_idx];
             result.rhs.push_back(node_loads[to_node_idx]);
 
-            auto const adjacent_edges_snapshot =
-                std::vector<Idx>(adjacency_map_at_to_node.begin(), adjacency_map_at_to_node.end());
+            // update adjacency list by re-attaching all edges of the to node to the from node
+            adjacency_map.move_edges(to_node_idx, from_node_idx, adjacent_edges_snapshot);
 
             for (Idx const adjacent_edge_idx : adjacent_edges_snapshot) {
                 // re-attach edge and write to matrix
                 replace_and_write(adjacent_edge_idx, from_node_idx, to_node_idx, matrix_row, edges, result.matrix);
 
-                // update adjacency list after re-attachment
-                adjacency_map_at_to_node.erase(adjacent_edge_idx);
-                adjacency_map_at_from_node.insert(adjacent_edge_idx);
-
                 // update edges_history and edges_contracted_to_point (if needed) after re-attachment
                 update_edge_info(adjacent_edge_idx, matrix_row, edges, result.edges_history, edges_contracted_to_point);
             }
@@ -199,27 +313,34 @@ inline auto backward_substitution_free_right_cols(std::span<Idx const> free_col_
 // using the result from the elimination game
 inline void backward_substitution(ReducedEchelonForm& elimination_result) {
     auto free_col_indices = std::span<Idx const>(elimination_result.free_edge_indices);
+    auto& matrix = elimination_result.matrix;
+
+    // flag per column whether it is a free column
+    std::vector<std::uint8_t> is_free_col(free_col_indices.empty() ? 0 : free_col_indices.back() + 1);
+    for (Idx const free_col_idx : free_col_indices) {
+        is_free_col[free_col_idx] = 1;
+    }
+    std::vector<SparseEntry> pivot_row_free_right_entries; // workspace, reused for every pivot
 
     for (auto const pivot_col_idx : backward_substitution_pivots(elimination_result.pivot_edge_indices)) {
         auto const& edge_history = elimination_result.edges_history[pivot_col_idx];
         Idx const pivot_row_idx = edge_history.rows.back();
 
+        // only the free columns to the right of the pivot column are affected by the backward substitution
+        // the entries of the pivot row are traversed instead of all free columns
+        pivot_row_free_right_entries.clear();
+        std::ranges::copy_if(matrix.row(pivot_row_idx), std::back_inserter(pivot_row_free_right_entries),
+                             [&is_free_col, pivot_col_idx](SparseEntry const& entry) {
+                                 return entry.col > pivot_col_idx && entry.col < std::ssize(is_free_col) &&
+                                        is_free_col[entry.col] != 0;
+                             });
+
         for (auto const row_idx : backward_substitution_rows(edge_history.rows)) {
-            auto const multiplier_value =
-                elimination_result.matrix.get_value(row_idx, pivot_col_idx).value(); // must always exist
-            elimination_result.matrix.add_to_value(narrow_cast<IntS>(-multiplier_value), row_idx, pivot_col_idx);
-
-            // only iterate over free columns to the right of the pivot column
-            // as these are the only ones that can be affected by the backward substitution
-            for (auto const backward_col_idx : backward_substitution_free_right_cols(free_col_indices, pivot_col_idx)) {
-                std::ignore =
-                    elimination_result.matrix.get_value(pivot_row_idx, backward_col_idx)
-                        .transform([&elimination_result, multiplier_value, row_idx,
-                                    backward_col_idx](IntS pivot_value) {
-                            elimination_result.matrix.add_to_value(static_cast<IntS>(-multiplier_value * pivot_value),
-                                                                   row_idx, backward_col_idx);
-                            return pivot_value;
-                        });
+            auto const multiplier_value = matrix.get_value(row_idx, pivot_col_idx).value(); // must always exist
+            matrix.add_to_value(narrow_cast<IntS>(-multiplier_value), row_idx, pivot_col_idx);
+
+            for (auto const& [backward_col_idx, pivot_value] : pivot_row_free_right_entries) {
+                matrix.add_to_value(static_cast<IntS>(-multiplier_value * pivot_value), row_idx, backward_col_idx);
             }
             elimination_result.rhs[row_idx] -=
                 static_cast<DoubleComplex>(multiplier_value) * elimination_result.rhs[pivot_row_idx];
@@ -248,7 +369,7 @@ inline ReducedEchelonForm reduced_echelon_form(std::vector<BranchIdx> edges, std
 // The degrees of freedom matrix (dfs_matrix) is associated with the degrees of freedom vector according
 // internal_loads = extended_rhs - dfs_matrix * lambda
 struct SolutionSet {
-    CooSparseMatrix dfs_matrix{};
+    SparseRowMatrix dfs_matrix{};
     std::vector<DoubleComplex> extended_rhs{};
 };
 
@@ -262,20 +383,23 @@ inline SolutionSet set_solution_system(ReducedEchelonForm& result) {
     auto const pivot_indices_size = narrow_cast<Idx>(result.pivot_edge_indices.size());
     auto const free_indices_size = narrow_cast<Idx>(result.free_edge_indices.size());
     Idx const total_indices_size = pivot_indices_size + free_indices_size;
-    dfs_matrix.prepare(free_indices_size);
+    dfs_matrix.prepare(free_indices_size, total_indices_size);
     extended_rhs.resize(total_indices_size);
     constexpr auto const free_matrix_element = IntS{-1};
 
+    // column in the dfs_matrix of each free edge
+    std::vector<Idx> dfs_matrix_cols(total_indices_size, na_Idx);
+    for (auto dfs_matrix_col : std::views::iota(Idx{}, free_indices_size)) {
+        dfs_matrix_cols[result.free_edge_indices[dfs_matrix_col]] = dfs_matrix_col;
+    }
+
     // The part constructed from result.matrix and result.rhs.
     for (auto matrix_row : std::views::iota(Idx{}, pivot_indices_size)) {
         auto const pivot_edge_idx = result.pivot_edge_indices[matrix_row];
-        for (auto dfs_matrix_col : std::views::iota(Idx{}, free_indices_size)) {
-            Idx const free_edge_idx = result.free_edge_indices[dfs_matrix_col];
-            std::ignore = result.matrix.get_value(matrix_row, free_edge_idx)
-                              .transform([&dfs_matrix, pivot_edge_idx, dfs_matrix_col](IntS matrix_element) {
-                                  dfs_matrix.set_value(matrix_element, pivot_edge_idx, dfs_matrix_col);
-                                  return matrix_element;
-                              });
+        for (auto const& [col_idx, matrix_element] : result.matrix.row(matrix_row)) {
+            if (col_idx < total_indices_size && dfs_matrix_cols[col_idx] != na_Idx) {
+                dfs_matrix.set_value(matrix_element, pivot_edge_idx, dfs_matrix_cols[col_idx]);
+            }
         }
         extended_rhs[pivot_edge_idx] = result.rhs[matrix_row];
     }
@@ -289,36 +413,29 @@ inline SolutionSet set_solution_system(ReducedEchelonForm& result) {
     return solution_set;
 };
 
+// the projection system is the normal equation of the dfs_matrix: dfs_matrix^T * dfs_matrix | dfs_matrix^T * rhs
+// it is accumulated row by row, so that only the pairs of non-zero entries in the same row are visited
 inline std::vector<std::vector<DoubleComplex>> set_projection_system(Idx free_indices_number, Idx total_indices_number,
                                                                      SolutionSet& solution_set) {
     std::vector<std::vector<DoubleComplex>> projection_system(free_indices_number,
                                                               std::vector<DoubleComplex>(free_indices_number + 1));
 
-    for (Idx dfs_matrix_col = 0; dfs_matrix_col < free_indices_number; dfs_matrix_col++) {
-        auto dot_product_rhs = DoubleComplex{};
-        for (Idx dfs_matrix_row = 0; dfs_matrix_row < total_indices_number; dfs_matrix_row++) {
-            std::ignore = solution_set.dfs_matrix.get_value(dfs_matrix_row, dfs_matrix_col)
-                              .transform([&dot_product_rhs, &extended_rhs_ = solution_set.extended_rhs,
-                                          &dfs_matrix_row](IntS first_value) {
-                                  dot_product_rhs +=
-                                      static_cast<DoubleComplex>(first_value) * extended_rhs_[dfs_matrix_row];
-                                  return first_value;
-                              });
+    for (Idx dfs_matrix_row = 0; dfs_matrix_row < total_indices_number; dfs_matrix_row++) {
+        auto const row_entries = solution_set.dfs_matrix.row(dfs_matrix_row);
+        for (auto first = row_entries.begin(); first != row_entries.end(); ++first) {
+            auto& projection_system_row = projection_system[first->col];
+            projection_system_row[free_indices_number] +=
+                static_cast<DoubleComplex>(first->value) * solution_set.extended_rhs[dfs_matrix_row];
+            for (auto second = first; second != row_entries.end(); ++second) {
+                projection_system_row[second->col] += static_cast<DoubleComplex>(first->value * second->value);
+            }
         }
-        auto& projection_system_row = projection_system[dfs_matrix_col];
-        projection_system_row[free_indices_number] = dot_product_rhs;
-        for (Idx second_dfs_matrix_col = dfs_matrix_col; second_dfs_matrix_col < free_indices_number;
+    }
+    for (Idx dfs_matrix_col = 0; dfs_matrix_col < free_indices_number; dfs_matrix_col++) {
+        for (Idx second_dfs_matrix_col = dfs_matrix_col + 1; second_dfs_matrix_col < free_indices_number;
              second_dfs_matrix_col++) {
-            auto dot_product_matrix = DoubleComplex{};
-            for (Idx dfs_matrix_row = 0; dfs_matrix_row < total_indices_number; dfs_matrix_row++) {
-                auto const first_value = solution_set.dfs_matrix.get_value(dfs_matrix_row, dfs_matrix_col);
-                auto const second_value = solution_set.dfs_matrix.get_value(dfs_matrix_row, second_dfs_matrix_col);
-                if (first_value && second_value) {
-                    dot_product_matrix += static_cast<DoubleComplex>(first_value.value() * second_value.value());
-                }
-            }
-            projection_system_row[second_dfs_matrix_col] = dot_product_matrix;
-            projection_system[second_dfs_matrix_col][dfs_matrix_col] = dot_product_matrix;
+            projection_system[second_dfs_matrix_col][dfs_matrix_col] =
+                projection_system[dfs_matrix_col][second_dfs_matrix_col];
         }
     }
     return projection_system;
@@ -368,12 +485,10 @@ inline std::vector<DoubleComplex> compute_internal_loads(SolutionSet const& solu
     for (auto const row : IdxRange{number_of_rows}) {
         internal_loads[row] = solution_set.extended_rhs[row];
         auto sum_value = DoubleComplex{};
-        for (auto const column : IdxRange{number_of_columns}) {
-            std::ignore =
-                solution_set.dfs_matrix.get_value(row, column).transform([&sum_value, &system, column](IntS value) {
-                    sum_value += static_cast<DoubleComplex>(value) * system[column].back();
-                    return value;
-                });
+        for (auto const& [column, value] : solution_set.dfs_matrix.row(row)) {
+            if (column < number_of_columns) {
+                sum_value += static_cast<DoubleComplex>(value) * system[column].back();
+            }
         }
         internal_loads[row] -= sum_value;
     }
@@ -389,7 +504,7 @@ inline std::vector<DoubleComplex> compute_loads_link_elements(std::vector<Branch
     auto reduced_echelon_result = reduced_echelon_form(std::move(edges), std::move(node_loads));
     auto solution_set = set_solution_system(reduced_echelon_result);
 
-    if (solution_set.dfs_matrix.data_map.empty()) {
+    if (solution_set.dfs_matrix.nnz() == 0) {
         return solution_set.extended_rhs;
     }
 
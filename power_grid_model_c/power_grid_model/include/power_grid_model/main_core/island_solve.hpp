@@ -0,0 +1,137 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+
+// prepare and solve the independent math models (islands) of a single calculation
+
+#include "../common/calculation_info.hpp"
+#include "../common/common.hpp"
+#include "../common/logging.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <exception>
+#include <functional>
+#include <numeric>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace power_grid_model::main_core {
+
+// solving order of the islands: largest first, so that the largest islands do not end up on the critical path
+// islands of equal size keep their original order
+inline std::vector<Idx> largest_island_first_order(std::vector<Idx> const& island_sizes) {
+    std::vector<Idx> order(island_sizes.size());
+    std::iota(order.begin(), order.end(), Idx{0});
+    std::ranges::stable_sort(order, std::ranges::greater{}, [&island_sizes](Idx island) {
+        return island_sizes[static_cast<size_t>(island)];
+    });
+    return order;
+}
+
+// island_fn(island) is called for all islands on n_thread threads, including the calling thread, in the given order
+//
+// returns the exception of the first failing island (in island order) once all threads are done, or a null pointer if
+// no island throws
+template <std::invocable<Idx> IslandFn>
+std::exception_ptr for_each_island_parallel(IslandFn const& island_fn, std::vector<Idx> const& order, Idx n_thread) {
+    auto const n_islands = static_cast<Idx>(order.size());
+
+    std::vector<std::exception_ptr> exceptions(order.size());
+    std::atomic<Idx> next{0};
+
+    auto const run_next_islands = [&] {
+        for (Idx pos = next.fetch_add(1, std::memory_order_relaxed); pos < n_islands;
+             pos = next.fetch_add(1, std::memory_order_relaxed)) {
+            auto const island = order[static_cast<size_t>(pos)];
+            try {
+                island_fn(island);
+            } catch (...) { // NOSONAR(S2738)
+                exceptions[static_cast<size_t>(island)] = std::current_exception();
+            }
+        }
+    };
+
+    {
+        std::vector<std::jthread> threads;
+        auto const n_extra_thread = std::clamp(n_thread, Idx{1}, std::max(n_islands, Idx{1})) - 1;
+        threads.reserve(static_cast<size_t>(n_extra_thread));
+        for (Idx thread_number = 0; thread_number != n_extra_thread; ++thread_number) {
+            threads.emplace_back(run_next_islands);
+        }
+        run_next_islands();
+    } // join
+
+    if (auto const it = std::ranges::find_if(exceptions, [](auto const& ex) { return ex != nullptr; });
+        it != exceptions.end()) {
+        return *it;
+    }
+    return nullptr;
+}
+
+// solve_island(island, logger) is called for all islands on n_thread threads, including the calling thread.
+//
+// the output is in island order, regardless of the order in which the islands were solved
+// every island logs to its own logger; the logs are merged into logger in island order afterwards
+// if any island throws, the exception of the first failing island (in island order) is rethrown once all threads are
+// done, which is the same exception a sequential run would throw
+template <typename SolveIslandFn>
+    requires std::invocable<SolveIslandFn const&, Idx, Logger&> &&
+             std::default_initializable<std::invoke_result_t<SolveIslandFn const&, Idx, Logger&>>
+auto solve_islands_parallel(SolveIslandFn const& solve_island, std::vector<Idx> const& island_sizes, Idx n_thread,
+                            Logger& logger) {
+    using SolverOutputType = std::invoke_result_t<SolveIslandFn const&, Idx, Logger&>;
+
+    std::vector<SolverOutputType> solver_output(island_sizes.size());
+    std::vector<CalculationInfo> island_logs(island_sizes.size());
+
+    auto const exception = for_each_island_parallel(
+        [&solve_island, &solver_output, &island_logs](Idx island) {
+            auto const island_idx = static_cast<size_t>(island);
+            solver_output[island_idx] = solve_island(island, island_logs[island_idx]);
+        },
+        largest_island_first_order(island_sizes), n_thread);
+
+    for (auto const& island_log : island_logs) {
+        island_log.merge_into(logger);
+    }
+    if (exception != nullptr) {
+        std::rethrow_exception(exception);
+    }
+    return solver_output;
+}
+
+// build_island(island) is called for all islands on n_thread threads, including the calling thread, and returns the
+// object of that island, e.g. its y bus or solver
+//
+// the objects are returned in island order; they do not need to be default constructible
+// if any island throws, the exception of the first failing island (in island order) is rethrown once all threads are
+// done
+template <typename BuildIslandFn>
+    requires std::invocable<BuildIslandFn const&, Idx> &&
+             std::move_constructible<std::invoke_result_t<BuildIslandFn const&, Idx>>
+auto build_islands_parallel(BuildIslandFn const& build_island, std::vector<Idx> const& island_sizes, Idx n_thread) {
+    using IslandType = std::invoke_result_t<BuildIslandFn const&, Idx>;
+
+    std::vector<std::optional<IslandType>> built(island_sizes.size());
+    if (auto const exception = for_each_island_parallel(
+            [&build_island, &built](Idx island) { built[static_cast<size_t>(island)].emplace(build_island(island)); },
+            largest_island_first_order(island_sizes), n_thread);
+        exception != nullptr) {
+        std::rethrow_exception(exception);
+    }
+
+    std::vector<IslandType> result;
+    result.reserve(island_sizes.size());
+    for (auto& island : built) {
+        result.push_back(std::move(*island));
+    }
+    return result;
+}
+
+} // namespace power_grid_model::main_core
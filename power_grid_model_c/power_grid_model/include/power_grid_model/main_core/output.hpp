@@ -440,9 +440,16 @@ template <std::derived_from<Base> Component, class ComponentContainer, solver_ou
              }
 constexpr void output_result(MainModelState<ComponentContainer> const& state,
                              MathOutput<std::vector<SolverOutputType>> const& math_output, ComponentOutput output) {
-    detail::produce_output<Component, Idx2D>(state, output, [&math_output](Component const& component, Idx2D math_id) {
-        return output_result<Component>(component, math_output.solver_output, math_id);
-    });
+    detail::produce_output<Component, Idx2D>(
+        state, output, [&state, &math_output](Component const& component, Idx2D math_id) {
+            // a branch outage in contingency mode keeps the branch in the math model of the base case
+            if constexpr (std::derived_from<Component, Branch>) {
+                if (state.has_branch_outages && !component.energized(true)) {
+                    math_id = Idx2D{.group = disconnected, .pos = disconnected};
+                }
+            }
+            return output_result<Component>(component, math_output.solver_output, math_id);
+        });
 }
 template <std::derived_from<Base> Component, class ComponentContainer, solver_output_type SolverOutputType,
           non_owning_view_c ComponentOutput>
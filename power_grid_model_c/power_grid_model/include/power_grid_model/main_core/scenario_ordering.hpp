@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+
+// order the scenarios of a batch such that scenarios with the same topology changes are calculated consecutively
+
+#include "../auxiliary/dataset.hpp"
+#include "../auxiliary/meta_data.hpp"
+#include "../common/common.hpp"
+#include "../common/hash.hpp"
+#include "../component/branch.hpp"
+#include "../component/branch3.hpp"
+#include "../component/source.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <string_view>
+#include <vector>
+
+namespace power_grid_model::main_core::update {
+
+namespace detail {
+// components of which an update can change the topology, i.e. their connection statuses
+template <typename CompType>
+concept topology_update_component_c =
+    std::derived_from<CompType, Branch> || std::derived_from<CompType, Branch3> || std::same_as<CompType, Source>;
+
+template <topology_update_component_c CompType>
+inline void hash_topology_update(std::size_t& seed, typename CompType::UpdateType const& update, Idx position) {
+    // updates without id refer to the component by position (independent update data)
+    combine_hash(seed, std::hash<Idx>{}(is_nan(update.id) ? position : Idx{update.id}));
+    if constexpr (std::derived_from<CompType, Branch>) {
+        combine_hash(seed, std::hash<IntS>{}(update.from_status));
+        combine_hash(seed, std::hash<IntS>{}(update.to_status));
+    } else if constexpr (std::derived_from<CompType, Branch3>) {
+        combine_hash(seed, std::hash<IntS>{}(update.status_1));
+        combine_hash(seed, std::hash<IntS>{}(update.status_2));
+        combine_hash(seed, std::hash<IntS>{}(update.status_3));
+    } else {
+        combine_hash(seed, std::hash<IntS>{}(update.status));
+    }
+}
+
+template <topology_update_component_c CompType>
+inline void hash_topology_updates(std::size_t& seed, ConstDataset const& update_data, Idx scenario_idx) {
+    auto const hash_elements = [&seed](auto const& elements) {
+        Idx position = 0;
+        for (auto const& element : elements) {
+            hash_topology_update<CompType>(seed, element, position);
+            ++position;
+        }
+    };
+    if (update_data.is_columnar(CompType::name)) {
+        hash_elements(update_data.get_columnar_buffer_span<meta_data::update_getter_s, CompType>(scenario_idx));
+    } else {
+        hash_elements(update_data.get_buffer_span<meta_data::update_getter_s, CompType>(scenario_idx));
+    }
+}
+} // namespace detail
+
+// fingerprint of the updates in a scenario that may change the topology
+// scenarios with equal fingerprints (up to hash collisions) set the same connection statuses on the same components
+template <class ModelType> inline std::size_t topology_fingerprint(ConstDataset const& update_data, Idx scenario_idx) {
+    std::size_t seed{0};
+    ModelType::run_functor_with_all_component_types_return_void([&seed, &update_data, scenario_idx]<typename CT>() {
+        if constexpr (detail::topology_update_component_c<CT>) {
+            if (update_data.contains_component(CT::name)) {
+                combine_hash(seed, std::hash<std::string_view>{}(CT::name));
+                detail::hash_topology_updates<CT>(seed, update_data, scenario_idx);
+            }
+        }
+    });
+    return seed;
+}
+
+// execution order of the scenarios in which scenarios with the same topology changes are grouped together
+// within a group, the original order is kept
+// an empty order is returned if the update data does not contain any component that can change the topology,
+// i.e. the original order is already optimal
+template <class ModelType> inline IdxVector topology_grouped_scenario_order(ConstDataset const& update_data) {
+    bool has_topology_updates = false;
+    ModelType::run_functor_with_all_component_types_return_void([&has_topology_updates, &update_data]<typename CT>() {
+        if constexpr (detail::topology_update_component_c<CT>) {
+            has_topology_updates = has_topology_updates || update_data.contains_component(CT::name);
+        }
+    });
+    if (!has_topology_updates) {
+        return {};
+    }
+
+    Idx const n_scenarios = update_data.batch_size();
+    std::vector<std::size_t> fingerprints(n_scenarios);
+    for (Idx scenario_idx = 0; scenario_idx != n_scenarios; ++scenario_idx) {
+        fingerprints[scenario_idx] = topology_fingerprint<ModelType>(update_data, scenario_idx);
+    }
+
+    IdxVector order(n_scenarios);
+    std::iota(order.begin(), order.end(), Idx{0});
+    std::ranges::stable_sort(order, {}, [&fingerprints](Idx scenario_idx) { return fingerprints[scenario_idx]; });
+    return order;
+}
+
+} // namespace power_grid_model::main_core::update
@@ -6,6 +6,7 @@
 
 #include "../calculation_parameters.hpp"
 #include "../container_fwd.hpp"
+#include "topology_cache.hpp"
 
 #include <concepts>
 #include <memory>
@@ -21,9 +22,19 @@ template <class CompContainer> struct MainModelState {
     // calculation parameters
     std::shared_ptr<ComponentTopology const> comp_topo;
     std::shared_ptr<ReducedTopology const> reduced_topology;
+    // component connections that the current math topology is built from
+    std::shared_ptr<ComponentConnections const> comp_conn;
+    // whether branches are disconnected compared to comp_conn, while its math topology is kept (contingency mode)
+    bool has_branch_outages{false};
 
     std::vector<std::shared_ptr<MathModelTopology const>> math_topology;
     std::shared_ptr<TopologicalComponentToMathCoupling const> topo_comp_coup;
+    // y bus structures of the math topology, only pre-built if the topology comes from the topology cache
+    std::vector<std::shared_ptr<math_solver::YBusStructure const>> y_bus_structure;
+    // topologies of previously seen switching states, shared between all copies of the model
+    std::shared_ptr<TopologyCache> topology_cache;
+    // topology of the base case of branch outages in contingency mode
+    std::shared_ptr<TopologyCacheEntry const> base_topology;
 
     ComponentToMathCoupling comp_coup;
 };
@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+
+// cache of the math topologies built for the switching states of a model
+
+#include "../calculation_parameters.hpp"
+#include "../common/common.hpp"
+#include "../common/hash.hpp"
+#include "../common/lru_cache.hpp"
+#include "../math_solver/y_bus.hpp"
+#include "../sparse_ordering.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace power_grid_model::main_core {
+
+namespace detail {
+template <typename T> inline void hash_topology_values(std::size_t& seed, std::vector<T> const& values) {
+    combine_hash(seed, std::hash<std::size_t>{}(values.size()));
+    for (auto const& value : values) {
+        if constexpr (requires { std::tuple_size<T>::value; }) {
+            for (auto const& element : value) {
+                combine_hash(seed, std::hash<typename T::value_type>{}(element));
+            }
+        } else {
+            combine_hash(seed, std::hash<T>{}(value));
+        }
+    }
+}
+} // namespace detail
+
+// hash of the switching state, i.e. the connection statuses of the branches, branch3s and sources
+// the phase shifts are included as well, because they are also part of the math topology
+inline std::size_t hash_component_connections(ComponentConnections const& comp_conn) {
+    std::size_t seed{0};
+    detail::hash_topology_values(seed, comp_conn.branch_connected);
+    detail::hash_topology_values(seed, comp_conn.branch3_connected);
+    detail::hash_topology_values(seed, comp_conn.link_connected);
+    detail::hash_topology_values(seed, comp_conn.branch_phase_shift);
+    detail::hash_topology_values(seed, comp_conn.branch3_phase_shift);
+    detail::hash_topology_values(seed, comp_conn.source_connected);
+    return seed;
+}
+
+// hash of the parts of a math topology that the y bus structure is built from
+inline std::size_t hash_y_bus_structure_topology(MathModelTopology const& math_topo) {
+    std::size_t seed{0};
+    combine_hash(seed, std::hash<Idx>{}(math_topo.n_bus()));
+    combine_hash(seed, std::hash<Idx>{}(math_topo.n_shunt()));
+    detail::hash_topology_values(seed, math_topo.branch_bus_idx);
+    detail::hash_topology_values(seed, math_topo.fill_in);
+    return seed;
+}
+
+// whether the y bus structures of two math topologies are the same
+inline bool same_y_bus_structure_topology(MathModelTopology const& x, MathModelTopology const& y) {
+    return x.n_bus() == y.n_bus() && x.branch_bus_idx == y.branch_bus_idx && x.fill_in == y.fill_in &&
+           x.shunts_per_bus == y.shunts_per_bus;
+}
+
+// everything that is built from the component connections of a model and that does not depend on the parameters
+struct TopologyCacheEntry {
+    std::size_t hash{};
+    std::shared_ptr<ComponentConnections const> comp_conn;
+    std::shared_ptr<ReducedTopology const> reduced_topology;
+    std::vector<std::shared_ptr<MathModelTopology const>> math_topology;
+    std::shared_ptr<TopologicalComponentToMathCoupling const> topo_comp_coup;
+    std::vector<std::shared_ptr<math_solver::YBusStructure const>> y_bus_structure;
+};
+
+// bounded least-recently-used cache of topologies, keyed by the switching state
+//
+// the cache belongs to a single component topology and is shared between all copies of a model, e.g. the batch
+// workers, which is safe because the caches are guarded by a mutex and the entries are immutable
+class TopologyCache {
+  public:
+    static constexpr Idx default_capacity = 16;
+    // the structures of the islands are cached separately, to be reused in other switching states
+    static constexpr Idx default_structure_capacity = 64;
+
+    explicit TopologyCache(Idx capacity = default_capacity, Idx structure_capacity = default_structure_capacity)
+        : entries_{capacity}, y_bus_structures_{structure_capacity}, sparse_ordering_cache_{structure_capacity} {}
+
+    std::shared_ptr<TopologyCacheEntry const> find(ComponentConnections const& comp_conn, std::size_t hash) {
+        return entries_.find(hash,
+                             [&comp_conn](TopologyCacheEntry const& entry) { return *entry.comp_conn == comp_conn; });
+    }
+
+    // another worker may have built the same topology in the meantime, in which case that one is kept
+    void insert(std::shared_ptr<TopologyCacheEntry const> entry) {
+        assert(entry != nullptr);
+        std::size_t const hash = entry->hash;
+        ComponentConnections const& comp_conn = *entry->comp_conn;
+        entries_.insert(hash, std::move(entry),
+                        [&comp_conn](TopologyCacheEntry const& cached) { return *cached.comp_conn == comp_conn; });
+    }
+
+    // the y bus structure of a math topology, shared with an earlier math topology of the same structure if possible
+    // the islands of a grid are mostly the same in many switching states, also if the switching state as a whole is not
+    // in the cache
+    std::shared_ptr<math_solver::YBusStructure const>
+    get_y_bus_structure(std::shared_ptr<MathModelTopology const> const& math_topo) {
+        assert(math_topo != nullptr);
+        std::size_t const hash = hash_y_bus_structure_topology(*math_topo);
+        auto const same_structure = [&math_topo](YBusStructureEntry const& entry) {
+            return same_y_bus_structure_topology(*entry.math_topology, *math_topo);
+        };
+        if (auto cached = y_bus_structures_.find(hash, same_structure); cached != nullptr) {
+            return cached->y_bus_structure;
+        }
+        // the structure is built outside of the lock
+        auto entry = std::make_shared<YBusStructureEntry const>(
+            YBusStructureEntry{.math_topology = math_topo,
+                               .y_bus_structure = std::make_shared<math_solver::YBusStructure const>(*math_topo)});
+        return y_bus_structures_.insert(hash, std::move(entry), same_structure)->y_bus_structure;
+    }
+
+    SparseOrderingCache& sparse_ordering_cache() { return sparse_ordering_cache_; }
+
+    Idx size() const { return entries_.size(); }
+    Idx capacity() const { return entries_.capacity(); }
+    Idx y_bus_structure_size() const { return y_bus_structures_.size(); }
+
+  private:
+    struct YBusStructureEntry {
+        std::shared_ptr<MathModelTopology const> math_topology;
+        std::shared_ptr<math_solver::YBusStructure const> y_bus_structure;
+    };
+
+    LruCache<TopologyCacheEntry> entries_;
+    LruCache<YBusStructureEntry> y_bus_structures_;
+    SparseOrderingCache sparse_ordering_cache_;
+};
+
+} // namespace power_grid_model::main_core
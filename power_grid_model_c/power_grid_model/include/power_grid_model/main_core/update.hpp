@@ -15,13 +15,19 @@
 #include "../container_fwd.hpp"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
 #include <concepts>
+#include <cstring>
+#include <exception>
 #include <iterator>
 #include <ranges>
 #include <span>
 #include <string>
+#include <thread>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace power_grid_model::main_core::update {
@@ -254,6 +260,108 @@ get_all_sequence_idx_map(typename ModelType::ComponentContainer const& component
         });
 }
 
+// sequence idx maps of all scenarios of the components that cannot be cached
+// the sequence of a component in a scenario is a slice of one flat sequence of that component:
+// [scenario_offsets[scenario_idx], scenario_offsets[scenario_idx + 1]), or empty if the offsets of that component are
+// empty
+template <class ModelType> struct AllScenariosSequenceIdx {
+    ModelType::SequenceIdx sequence{};
+    std::array<IdxVector, ModelType::n_types> scenario_offsets{};
+
+    ModelType::SequenceIdxView scenario_sequence(Idx scenario_idx) const {
+        typename ModelType::SequenceIdxView result{};
+        for (auto&& [comp_sequence, offsets, comp_result] : std::views::zip(sequence, scenario_offsets, result)) {
+            if (!offsets.empty()) {
+                comp_result = std::span<Idx2D const>{std::next(comp_sequence.cbegin(), offsets[scenario_idx]),
+                                                     std::next(comp_sequence.cbegin(), offsets[scenario_idx + 1])};
+            }
+        }
+        return result;
+    }
+};
+
+// resolve the sequence idx maps of all scenarios at once for the components that cannot be cached, so that the ids
+// do not need to be looked up anymore during the calculation of the scenarios
+// the scenarios are divided over n_thread threads. The error of a scenario is stored in exceptions[scenario_idx], so
+// that all scenarios with e.g. unknown ids can be reported before any calculation starts.
+template <class ModelType>
+inline AllScenariosSequenceIdx<ModelType>
+resolve_all_scenarios_sequence_idx_map(typename ModelType::ComponentContainer const& components,
+                                       ConstDataset const& update_data,
+                                       typename ModelType::ComponentFlags const& components_to_store,
+                                       typename ModelType::UpdateIndependence const& independence, Idx n_thread,
+                                       std::vector<std::string>& exceptions) {
+    Idx const n_scenarios = update_data.batch_size();
+    assert(std::ssize(exceptions) == n_scenarios);
+
+    AllScenariosSequenceIdx<ModelType> result;
+
+    // offsets of the scenarios in the flat sequences
+    ModelType::run_functor_with_all_component_types_return_void(
+        [&result, &update_data, &components_to_store, &independence, n_scenarios]<typename CompType>() {
+            constexpr auto comp_idx = ModelType::template index_of_component<CompType>;
+            if (std::get<comp_idx>(independence).is_independent() || !std::get<comp_idx>(components_to_store)) {
+                return;
+            }
+            auto& offsets = std::get<comp_idx>(result.scenario_offsets);
+            offsets.resize(n_scenarios + 1);
+            auto const n_elements = [](auto const& span) { return std::ranges::ssize(span); };
+            for (Idx scenario_idx = 0; scenario_idx != n_scenarios; ++scenario_idx) {
+                offsets[scenario_idx + 1] =
+                    offsets[scenario_idx] +
+                    update_data.for_each_component<meta_data::update_getter_s, CompType>(n_elements, scenario_idx);
+            }
+            std::get<comp_idx>(result.sequence).resize(offsets.back());
+        });
+
+    auto const resolve_scenario = [&result, &components, &update_data, &independence](Idx scenario_idx) {
+        ModelType::run_functor_with_all_component_types_return_void(
+            [&result, &components, &update_data, &independence, scenario_idx]<typename CompType>() {
+                constexpr auto comp_idx = ModelType::template index_of_component<CompType>;
+                auto const& offsets = std::get<comp_idx>(result.scenario_offsets);
+                if (offsets.empty()) {
+                    return;
+                }
+                auto const& component_properties = std::get<comp_idx>(independence);
+                independence::validate_update_data_independence(component_properties, CompType::name);
+                update_data.for_each_component<meta_data::update_getter_s, CompType>(
+                    [&components, &component_properties,
+                     destination = std::next(std::get<comp_idx>(result.sequence).begin(), offsets[scenario_idx])](
+                        auto const& span) {
+                        detail::get_component_sequence_impl<CompType>(components, span, destination,
+                                                                      component_properties.get_n_elements());
+                    },
+                    scenario_idx);
+            });
+    };
+
+    // the id lookups only read the components, so the scenarios can be resolved concurrently
+    std::atomic<Idx> next{0};
+    auto const resolve_next_scenarios = [&resolve_scenario, &exceptions, &next, n_scenarios] {
+        for (Idx scenario_idx = next.fetch_add(1, std::memory_order_relaxed); scenario_idx < n_scenarios;
+             scenario_idx = next.fetch_add(1, std::memory_order_relaxed)) {
+            try {
+                resolve_scenario(scenario_idx);
+            } catch (std::exception const& ex) { // NOSONAR(S1181)
+                exceptions[scenario_idx] = ex.what();
+            } catch (...) { // NOSONAR(S2738)
+                exceptions[scenario_idx] = "unknown exception";
+            }
+        }
+    };
+    {
+        std::vector<std::jthread> threads;
+        auto const n_extra_thread = std::clamp(n_thread, Idx{1}, std::max(n_scenarios, Idx{1})) - 1;
+        threads.reserve(static_cast<size_t>(n_extra_thread));
+        for (Idx thread_number = 0; thread_number != n_extra_thread; ++thread_number) {
+            threads.emplace_back(resolve_next_scenarios);
+        }
+        resolve_next_scenarios();
+    } // join
+
+    return result;
+}
+
 // template to update components
 // using forward interators
 // different selection based on component type
@@ -318,4 +426,81 @@ inline void update_inverse(ComponentContainer const& components, Updates updates
                                      detail::get_component_sequence_by_iter<Component>(components, updates));
 }
 
+namespace detail {
+// set the nan attributes of target to the values of the same attributes in source
+// asymmetric values are filled per phase, because an update may set only some of the phases
+inline void fill_nan_attributes(meta_data::MetaComponent const& meta_component, RawDataPtr target,
+                                RawDataConstPtr source) {
+    for (auto const& attribute : meta_component.attributes) {
+        if (attribute.ctype == CType::c_double3) {
+            auto& target_value = attribute.get_attribute<RealValue<asymmetric_t>>(target);
+            auto const& source_value = attribute.get_attribute<RealValue<asymmetric_t> const>(source);
+            for (Idx phase = 0; phase != 3; ++phase) {
+                if (is_nan(target_value(phase))) {
+                    target_value(phase) = source_value(phase);
+                }
+            }
+        } else if (attribute.check_nan(target, 0)) {
+            attribute.set_value(target, static_cast<char const*>(source) + attribute.offset, 0);
+        }
+    }
+}
+
+inline bool equal_attributes(meta_data::MetaComponent const& meta_component, RawDataConstPtr x, RawDataConstPtr y) {
+    return std::ranges::all_of(meta_component.attributes, [x, y](auto const& attribute) {
+        return std::memcmp(static_cast<char const*>(x) + attribute.offset,
+                           static_cast<char const*>(y) + attribute.offset, attribute.size) == 0;
+    });
+}
+} // namespace detail
+
+// transition components directly from the currently applied cached update to the next update of the same components,
+// without restoring the original values in between
+//
+// inverse_updates holds the original values of all attributes that were changed since the last restore; it is
+// extended with the original values of the attributes that the next update changes for the first time
+// attributes that were changed before but are not part of the next update are restored to their original values
+// components of which the state does not change are skipped, so that they are not reported as changed
+template <component_c Component, class ComponentContainer, non_owning_view_c Updates,
+          std::output_iterator<Idx2D> OutputIterator>
+    requires common::component_container_c<ComponentContainer, Component>
+inline UpdateChange transition_component(ComponentContainer& components, Updates next_updates,
+                                         std::vector<typename Component::UpdateType>& inverse_updates,
+                                         OutputIterator changed_it, std::span<Idx2D const> sequence_idx,
+                                         meta_data::MetaComponent const& meta_component) {
+    using UpdateType = Component::UpdateType;
+
+    assert(std::ranges::ssize(inverse_updates) == std::ranges::ssize(sequence_idx));
+
+    UpdateChange state_changed;
+    Idx seq = 0;
+
+    detail::iterate_component_sequence<Component>(
+        [&state_changed, &changed_it, &components, &inverse_updates, &meta_component,
+         &seq](UpdateType const& next_update, Idx2D const& sequence_single) {
+            // read through the const container, so that the storage of unchanged components is not unshared
+            auto const& const_comp = get_component<Component>(std::as_const(components), sequence_single);
+            auto& original = inverse_updates[seq++];
+            assert(components.get_id_by_idx(sequence_single) == const_comp.id());
+
+            UpdateType transition = next_update;
+            detail::fill_nan_attributes(meta_component, &transition, &original);
+            UpdateType const current = const_comp.inverse(transition);
+            detail::fill_nan_attributes(meta_component, &original, &current);
+            if (detail::equal_attributes(meta_component, &transition, &current)) {
+                return;
+            }
+
+            auto const comp_changed = get_component<Component>(components, sequence_single).update(transition);
+            state_changed = state_changed || comp_changed;
+
+            if (comp_changed.param || comp_changed.topo) {
+                *changed_it++ = sequence_single;
+            }
+        },
+        next_updates, sequence_idx);
+
+    return state_changed;
+}
+
 } // namespace power_grid_model::main_core::update
@@ -12,11 +12,13 @@
 #include "../component/component.hpp"
 #include "../math_solver/y_bus.hpp"
 #include "container_queries.hpp"
+#include "island_solve.hpp"
 #include "math_state.hpp"
 #include "state.hpp"
 
 #include <algorithm>
 #include <concepts>
+#include <memory>
 #include <vector>
 
 namespace power_grid_model::main_core {
@@ -139,9 +141,18 @@ constexpr void add_to_increment(std::vector<MathModelParamIncrement<sym>> const&
 }
 } // namespace detail
 
+// number of buses of each math model, as a measure of the work per island
+inline std::vector<Idx>
+get_math_model_sizes(std::vector<std::shared_ptr<MathModelTopology const>> const& math_topology) {
+    std::vector<Idx> sizes(math_topology.size());
+    std::ranges::transform(math_topology, sizes.begin(), [](auto const& math_topo) { return math_topo->n_bus(); });
+    return sizes;
+}
+
+// the y bus of the math models are built on n_thread threads
 template <symmetry_tag sym, typename MainModelType>
 inline void prepare_y_bus(typename MainModelType::MainModelState const& state_, Idx n_math_solvers_,
-                          MathState& math_state_) {
+                          MathState& math_state_, Idx n_thread = 1) {
     std::vector<YBus<sym>>& y_bus_vec = main_core::get_y_bus<sym>(math_state_);
     // also get the vector of other Y_bus (sym -> asym, or asym -> sym)
     std::vector<YBus<other_symmetry_t<sym>>>& other_y_bus_vec =
@@ -149,16 +160,26 @@ inline void prepare_y_bus(typename MainModelType::MainModelState const& state_,
     // If no Ybus exists, build them
     if (y_bus_vec.empty()) {
         bool const other_y_bus_exist = (!other_y_bus_vec.empty());
-        y_bus_vec.reserve(n_math_solvers_);
         auto math_params = get_math_param<sym>(state_, n_math_solvers_);
 
-        for (Idx i = 0; i != n_math_solvers_; ++i) {
+        auto const build_y_bus = [&state_, &other_y_bus_vec, &math_params, other_y_bus_exist](Idx i) {
             // construct from existing Y_bus structure if possible
             if (other_y_bus_exist) {
-                y_bus_vec.emplace_back(*state_.math_topology[i], std::move(math_params[i]),
-                                       other_y_bus_vec[i].shared_y_bus_structure());
-            } else {
-                y_bus_vec.emplace_back(*state_.math_topology[i], std::move(math_params[i]));
+                return YBus<sym>{*state_.math_topology[i], std::move(math_params[i]),
+                                 other_y_bus_vec[i].shared_y_bus_structure()};
+            }
+            if (!state_.y_bus_structure.empty()) {
+                return YBus<sym>{*state_.math_topology[i], std::move(math_params[i]), state_.y_bus_structure[i]};
+            }
+            return YBus<sym>{*state_.math_topology[i], std::move(math_params[i])};
+        };
+
+        if (n_thread > 1) {
+            y_bus_vec = build_islands_parallel(build_y_bus, get_math_model_sizes(state_.math_topology), n_thread);
+        } else {
+            y_bus_vec.reserve(n_math_solvers_);
+            for (Idx i = 0; i != n_math_solvers_; ++i) {
+                y_bus_vec.push_back(build_y_bus(i));
             }
         }
     }
@@ -99,12 +99,27 @@ class MainModel {
         < 0 sequential
         = 0 parallel, use number of hardware threads
         > 0 specify number of parallel threads
+    batch_scheduling
+        static_stride: fixed assignment of scenarios to threads (reproducible per-thread order)
+        dynamic: threads pull chunks of scenarios on demand to balance uneven scenario run times
+    executor
+        if set, the batch runs on its persistent worker threads instead of freshly created ones;
+        the workers keep their model copy for the next batch on the same model revision
+    island_parallelism
+        sequential: the islands of a scenario are solved one after another
+        parallel: the islands of a scenario are solved concurrently, largest first, using the threads that are left
+                  by the batch (all threads for a single calculation)
     raise a BatchCalculationError if any of the calculations in the batch raised an exception
     */
     BatchParameter calculate(Options const& options, MutableDataset const& result_data,
                              ConstDataset const& update_data) {
-        JobAdapter<Impl> adapter{std::ref(impl()), std::ref(options)};
-        return JobDispatch::batch_calculation(adapter, result_data, update_data, options.threading, logger_.get());
+        auto scenario_options = options; // copy
+        if (!update_data.empty()) {
+            scenario_options.threading = JobDispatch::nested_threading(update_data.batch_size(), options.threading);
+        }
+        JobAdapter<Impl> adapter{std::ref(impl()), std::ref(scenario_options)};
+        return JobDispatch::batch_calculation(adapter, result_data, update_data, options.threading, logger_.get(),
+                                              options.batch_scheduling, options.executor);
     }
 
     void check_no_experimental_features_used(Options const& options, ConstDataset const* batch_dataset) const {
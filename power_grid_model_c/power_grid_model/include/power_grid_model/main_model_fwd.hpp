@@ -7,17 +7,62 @@
 #include "common/common.hpp"
 #include "common/enum.hpp"
 
+#include <atomic>
 #include <concepts>
+#include <cstdint>
 #include <type_traits>
+#include <utility>
 
 namespace power_grid_model {
 
+class JobExecutor;
+
 struct cached_update_t : std::true_type {};
 struct permanent_update_t : std::false_type {};
 
 template <typename T>
 concept cache_type_c = std::same_as<T, cached_update_t> || std::same_as<T, permanent_update_t>;
 
+// identifies the component data of a model instance
+// a copy is a new instance; every permanent update creates a new revision
+struct ModelRevisionKey {
+    std::uint64_t instance_id{0};
+    std::uint64_t revision{0};
+
+    friend constexpr bool operator==(ModelRevisionKey const&, ModelRevisionKey const&) = default;
+};
+
+class ModelRevision {
+  public:
+    ModelRevision() = default;
+    ModelRevision(ModelRevision const& /*other*/) {}
+    ModelRevision& operator=(ModelRevision const& other) {
+        if (this != &other) {
+            key_ = {.instance_id = next_instance_id(), .revision = 0};
+        }
+        return *this;
+    }
+    ModelRevision(ModelRevision&& other) noexcept : key_{std::exchange(other.key_, {})} {}
+    ModelRevision& operator=(ModelRevision&& other) noexcept {
+        if (this != &other) {
+            key_ = std::exchange(other.key_, {});
+        }
+        return *this;
+    }
+    ~ModelRevision() = default;
+
+    ModelRevisionKey key() const { return key_; }
+    void increment() { ++key_.revision; }
+
+  private:
+    ModelRevisionKey key_{.instance_id = next_instance_id(), .revision = 0};
+
+    static std::uint64_t next_instance_id() {
+        static std::atomic<std::uint64_t> counter{0};
+        return ++counter;
+    }
+};
+
 struct MainModelOptions {
     static constexpr Idx sequential = -1;
 
@@ -30,6 +75,16 @@ struct MainModelOptions {
     double err_tol{1e-8};
     Idx max_iter{20};
     Idx threading{sequential};
+    BatchScheduling batch_scheduling{BatchScheduling::static_stride};
+    ScenarioOrdering scenario_ordering{ScenarioOrdering::input_order};
+    ScenarioTransition scenario_transition{ScenarioTransition::restore};
+    PowerFlowInitialization power_flow_initialization{PowerFlowInitialization::default_initialization};
+    ContingencyMode contingency_mode{ContingencyMode::full_rebuild};
+    FactorizationPrecision factorization_precision{FactorizationPrecision::double_precision};
+    // optional persistent worker pool for batch calculations; not owned
+    JobExecutor* executor{nullptr};
+    IslandParallelism island_parallelism{IslandParallelism::sequential};
+    BatchLockstep batch_lockstep{BatchLockstep::disabled};
 
     ShortCircuitVoltageScaling short_circuit_voltage_scaling{ShortCircuitVoltageScaling::maximum};
 };
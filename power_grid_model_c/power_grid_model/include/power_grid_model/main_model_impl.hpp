@@ -9,6 +9,7 @@
 // main include
 #include "calculation_parameters.hpp"
 #include "calculation_preparation.hpp"
+#include "job_executor.hpp"
 #include "main_model_fwd.hpp"
 #include "math_solver/y_bus.hpp"
 
@@ -35,6 +36,7 @@
 #include "calculation.hpp"
 #include "main_core/core_utils.hpp"
 #include "main_core/input.hpp"
+#include "main_core/island_solve.hpp"
 #include "main_core/main_model_type.hpp"
 #include "main_core/output.hpp"
 #include "main_core/topological_node_output.hpp"
@@ -46,6 +48,7 @@
 #include <array>
 #include <cassert>
 #include <concepts>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <ranges>
@@ -180,6 +183,9 @@ class MainModelImpl {
     template <cache_type_c CacheType, typename SequenceIdxMap>
         requires(std::same_as<SequenceIdxMap, SequenceIdx> || std::same_as<SequenceIdxMap, SequenceIdxView>)
     void update_components(ConstDataset const& update_data, Idx pos, SequenceIdxMap const& sequence_idx_map) {
+        if constexpr (!CacheType::value) {
+            revision_.increment();
+        }
         ModelType::run_functor_with_all_component_types_return_void(
             [this, pos, &update_data, &sequence_idx_map]<typename CT>() {
                 this->update_component_row_col<CT, CacheType>(
@@ -209,6 +215,7 @@ class MainModelImpl {
         state_.components.set_construction_complete();
         state_.comp_topo =
             std::make_shared<ComponentTopology const>(main_core::construct_topology<ModelType>(state_.components));
+        state_.topology_cache = std::make_shared<main_core::TopologyCache>();
     }
 
   public:
@@ -260,7 +267,47 @@ class MainModelImpl {
         cached_state_changes_ = {};
     }
 
+    // go from the currently applied cached update directly to the update of scenario pos, without restoring first
+    // the updated components must be the same as the ones of the cached update, in the same order
+    void transition_components(ConstDataset const& update_data, Idx pos, SequenceIdxView const& sequence_idx) {
+        ModelType::run_functor_with_all_component_types_return_void(
+            [this, pos, &update_data, &sequence_idx]<typename CompType>() {
+                this->transition_component_row_col<CompType>(
+                    update_data, pos, std::get<ModelType::template index_of_component<CompType>>(sequence_idx));
+            });
+    }
+
   private:
+    template <class CompType>
+    void transition_component_row_col(ConstDataset const& update_data, Idx pos, std::span<Idx2D const> sequence_idx) {
+        constexpr auto comp_index = ModelType::template index_of_component<CompType>;
+
+        assert(construction_complete_);
+        assert(update_data.get_description().dataset->name == std::string_view("update"));
+
+        auto& cached_inverse_update = std::get<comp_index>(cached_inverse_update_);
+        if (sequence_idx.empty()) {
+            assert(cached_inverse_update.empty());
+            return;
+        }
+
+        auto const transition = [this, &cached_inverse_update, sequence_idx,
+                                 &meta_component = update_data.get_description().dataset->get_component(
+                                     CompType::name)](non_owning_view_c auto next_updates) {
+            UpdateChange const changed = main_core::update::transition_component<CompType>(
+                state_.components, next_updates, cached_inverse_update,
+                std::back_inserter(std::get<comp_index>(solvers_cache_status_.changed_components_indices())),
+                sequence_idx, meta_component);
+            solvers_cache_status_.update(changed);
+            cached_state_changes_ = cached_state_changes_ || changed;
+        };
+        if (update_data.is_columnar(CompType::name)) {
+            transition(update_data.get_columnar_buffer_span<meta_data::update_getter_s, CompType>(pos));
+        } else {
+            transition(update_data.get_buffer_span<meta_data::update_getter_s, CompType>(pos));
+        }
+    }
+
     void restore_components(SequenceIdxRefWrappers const& sequence_idx) {
         ModelType::run_functor_with_all_component_types_return_void([this, &sequence_idx]<typename CompType>() {
             this->restore_component<CompType>(std::array{std::span<Idx2D const>{
@@ -280,40 +327,88 @@ class MainModelImpl {
                  std::ranges::range<std::invoke_result_t<PrepareInputFn, Idx /*n_math_solvers*/>> &&
                  std::invocable<
                      std::remove_cvref_t<SolveFn>, MathSolverType&, YBus const&,
-                     typename std::invoke_result_t<PrepareInputFn, Idx /*n_math_solvers*/>::const_reference> &&
+                     typename std::invoke_result_t<PrepareInputFn, Idx /*n_math_solvers*/>::const_reference, Logger&> &&
                  solver_output_type<std::invoke_result_t<
                      SolveFn, MathSolverType&, YBus const&,
-                     typename std::invoke_result_t<PrepareInputFn, Idx /*n_math_solvers*/>::const_reference>>
+                     typename std::invoke_result_t<PrepareInputFn, Idx /*n_math_solvers*/>::const_reference, Logger&>>
 
-    auto calculate_(PrepareInputFn prepare_input, SolveFn solve, Logger& logger) {
+    auto calculate_(PrepareInputFn prepare_input, SolveFn solve, Options const& options, Logger& logger) {
         using InputType = std::invoke_result_t<PrepareInputFn, Idx /*n_math_solvers*/>::const_reference;
-        using SolverOutputType = std::invoke_result_t<SolveFn, MathSolverType&, YBus const&, InputType>;
+        using SolverOutputType = std::invoke_result_t<SolveFn, MathSolverType&, YBus const&, InputType, Logger&>;
         using sym = decode_symmetry_v<SolverOutputType>;
 
         assert(construction_complete_);
+        // the sensors of disconnected branches are only handled by a rebuilt topology
+        ContingencyMode const contingency_mode = options.calculation_type == CalculationType::state_estimation
+                                                     ? ContingencyMode::full_rebuild
+                                                     : options.contingency_mode;
         // prepare
-        auto const& input = [this, &logger, prepare_input_ = prepare_input] {
+        auto const& input = [this, &logger, &options, contingency_mode, prepare_input_ = prepare_input] {
             Timer const timer{logger, LogEvent::prepare};
             assert(construction_complete_);
-            prepare_solvers<sym>(state_, solver_preparation_context_, solvers_cache_status_);
+            // the islands are prepared on as many threads as they are solved with
+            // the number of islands is only known once the topology is built, the threads are limited to it then
+            prepare_solvers<sym>(state_, solver_preparation_context_, solvers_cache_status_, contingency_mode,
+                                 n_island_threads(options, std::numeric_limits<Idx>::max()));
             assert(solvers_cache_status_.is_topology_valid());
             assert(solvers_cache_status_.template is_parameter_valid<sym>());
             return prepare_input_(get_n_math_solvers<ModelType>(state_));
         }();
         // calculate
-        return [this, &logger, &input, &solve_ = solve] {
+        return [this, &logger, &input, &solve_ = solve, &options, contingency_mode] {
             Timer const timer{logger, LogEvent::math_calculation};
             auto& solvers = main_core::get_solvers<sym>(solver_preparation_context_.math_state);
             auto& y_bus_vec = main_core::get_y_bus<sym>(solver_preparation_context_.math_state);
+            Idx const n_math_solvers = get_n_math_solvers<ModelType>(state_);
+            Idx const n_thread = n_island_threads(options, n_math_solvers);
+            configure_solvers(solvers, y_bus_vec, n_thread > 1 ? 1 : n_level_threads(options), contingency_mode);
+
+            if (n_thread > 1) {
+                std::vector<Idx> island_sizes(n_math_solvers);
+                std::ranges::transform(y_bus_vec, island_sizes.begin(), [](YBus const& y_bus) { return y_bus.size(); });
+                return main_core::solve_islands_parallel(
+                    [&solvers, &y_bus_vec, &input, &solve_](Idx i, Logger& island_logger) {
+                        return solve_(solvers[i], y_bus_vec[i], input[i], island_logger);
+                    },
+                    island_sizes, n_thread, logger);
+            }
+
             std::vector<SolverOutputType> solver_output;
-            solver_output.reserve(get_n_math_solvers<ModelType>(state_));
-            for (Idx i = 0; i != get_n_math_solvers<ModelType>(state_); ++i) {
-                solver_output.emplace_back(solve_(solvers[i], y_bus_vec[i], input[i]));
+            solver_output.reserve(n_math_solvers);
+            for (Idx i = 0; i != n_math_solvers; ++i) {
+                solver_output.emplace_back(solve_(solvers[i], y_bus_vec[i], input[i], logger));
             }
             return solver_output;
         }();
     }
 
+    // number of threads to solve the islands with; same rules as the threading option of a batch calculation
+    static Idx n_island_threads(Options const& options, Idx n_math_solvers) {
+        if (options.island_parallelism == IslandParallelism::sequential || n_math_solvers < 2) {
+            return 1;
+        }
+        return n_job_threads(n_math_solvers, options.threading);
+    }
+
+    // number of threads for the sparse LU factorization and solve of large islands, if the islands are not solved in
+    // parallel; same rules as the threading option of a batch calculation
+    static Idx n_level_threads(Options const& options) {
+        return n_job_threads(std::numeric_limits<Idx>::max(), options.threading);
+    }
+
+    // the workers are only created if an island is large enough to be factorized level by level
+    template <symmetry_tag sym>
+    void configure_solvers(std::vector<MathSolverProxy<sym>>& solvers, std::vector<YBus<sym>> const& y_bus_vec,
+                           Idx n_thread, ContingencyMode contingency_mode) {
+        bool const has_level_schedule = std::ranges::any_of(
+            y_bus_vec, [](YBus<sym> const& y_bus) { return y_bus.lu_symbolic()->has_level_schedule(); });
+        JobExecutor* const executor = n_thread > 1 && has_level_schedule ? &level_executor_.get(n_thread) : nullptr;
+        for (auto& solver : solvers) {
+            solver.get().set_level_parallelism(executor, n_thread);
+            solver.get().set_contingency_mode(contingency_mode);
+        }
+    }
+
     // Calculate with optimization, e.g., automatic tap changer
     template <calculation_type_tag calculation_type, symmetry_tag sym>
     auto calculate_with_optimizer(Options const& options, bool cache_run, Logger& logger) {
@@ -328,9 +423,9 @@ class MainModelImpl {
                 (void)state; // to avoid unused-lambda-capture when in Release build
                 assert(&state == &state_);
 
-                return calculate_<MathSolverProxy<sym>, YBus<sym>>(
-                    Calc::preparer(state, mutable_comp_coup, options),
-                    Calc::solver(calculation_method, options, cache_run, logger), logger);
+                return calculate_<MathSolverProxy<sym>, YBus<sym>>(Calc::preparer(state, mutable_comp_coup, options),
+                                                                   Calc::solver(calculation_method, options, cache_run),
+                                                                   options, logger);
             };
         };
 
@@ -359,11 +454,7 @@ class MainModelImpl {
                 is_three_phase ? CalculationSymmetry::symmetric : CalculationSymmetry::asymmetric;
         }
 
-        if (options.calculation_type == CalculationType::power_flow &&
-            options.calculation_method != CalculationMethod::newton_raphson &&
-            state_.components.template size<VoltageRegulator>() > 0) {
-            throw InvalidCalculationMethod{};
-        }
+        check_power_flow_calculation_method(options);
 
         calculation_type_symmetry_func_selector(
             options.calculation_type, options.calculation_symmetry,
@@ -377,7 +468,141 @@ class MainModelImpl {
             *this, options, result_data, logger);
     }
 
+    void check_power_flow_calculation_method(Options const& options) const {
+        if (options.calculation_type == CalculationType::power_flow &&
+            options.calculation_method != CalculationMethod::newton_raphson &&
+            state_.components.template size<VoltageRegulator>() > 0) {
+            throw InvalidCalculationMethod{};
+        }
+    }
+
+    // see calculate_power_flow_lockstep
+    template <symmetry_tag sym, typename ApplyFn, typename RestoreFn, typename HandleExceptionFn>
+    void calculate_power_flow_lockstep_(Options const& options, std::span<MutableDataset const> result_data,
+                                        ApplyFn& apply, RestoreFn& restore, HandleExceptionFn& handle_exception,
+                                        Logger& logger) {
+        IdxVector lockstep_lanes;
+        IdxVector single_lanes;
+        // inputs of the lockstep lanes, per math model
+        std::vector<std::vector<PowerFlowInput<sym>>> input;
+
+        // do something with the scenario of a lane applied to the model
+        auto const with_lane = [&apply, &restore, &handle_exception](Idx lane, auto const& func) {
+            try {
+                apply(lane);
+                func();
+            } catch (...) { // NOSONAR(S2738)
+                handle_exception(lane);
+            }
+            restore();
+        };
+
+        // prepare
+        // the solvers are prepared for the first lane; the lanes after it only share them if neither the topology
+        // nor the parameters changed in the meantime
+        for (Idx lane = 0; lane != std::ssize(result_data); ++lane) {
+            with_lane(lane, [this, &options, &lockstep_lanes, &single_lanes, &input, &logger, lane] {
+                Timer const timer{logger, LogEvent::prepare};
+                check_power_flow_calculation_method(options);
+                if (lockstep_lanes.empty()) {
+                    prepare_solvers<sym>(state_, solver_preparation_context_, solvers_cache_status_,
+                                         options.contingency_mode,
+                                         n_island_threads(options, std::numeric_limits<Idx>::max()));
+                } else if (!solvers_cache_status_.is_topology_valid() ||
+                           !solvers_cache_status_.template is_parameter_valid<sym>()) {
+                    single_lanes.push_back(lane);
+                    return;
+                }
+                auto lane_input =
+                    main_core::prepare_power_flow_input<sym>(state_, get_n_math_solvers<ModelType>(state_));
+                input.resize(lane_input.size());
+                for (auto&& [math_model_input, math_model_lane_input] : std::views::zip(input, lane_input)) {
+                    math_model_input.push_back(std::move(math_model_lane_input));
+                }
+                lockstep_lanes.push_back(lane);
+            });
+        }
+
+        // calculate
+        // if that fails, e.g. because one of the lanes does not converge, every lane is calculated on its own to find
+        // out which one fails
+        std::vector<std::vector<SolverOutput<sym>>> solver_output(lockstep_lanes.size());
+        if (!lockstep_lanes.empty()) {
+            try {
+                Timer const timer{logger, LogEvent::math_calculation};
+                auto& solvers = main_core::get_solvers<sym>(solver_preparation_context_.math_state);
+                auto& y_bus_vec = main_core::get_y_bus<sym>(solver_preparation_context_.math_state);
+                configure_solvers(solvers, y_bus_vec, n_level_threads(options), options.contingency_mode);
+                for (auto&& [solver, y_bus, math_model_input] : std::views::zip(solvers, y_bus_vec, input)) {
+                    auto math_model_output =
+                        solver.get().run_power_flow_lockstep(math_model_input, options.err_tol, options.max_iter,
+                                                             logger, options.calculation_method, y_bus);
+                    for (auto&& [lane_output, output] : std::views::zip(solver_output, math_model_output)) {
+                        lane_output.push_back(std::move(output));
+                    }
+                }
+            } catch (PowerGridError const&) {
+                std::ranges::copy(lockstep_lanes, std::back_inserter(single_lanes));
+                lockstep_lanes.clear();
+                solver_output.clear();
+            }
+        }
+
+        // output
+        for (Idx idx = 0; idx != std::ssize(lockstep_lanes); ++idx) {
+            Idx const lane = lockstep_lanes[idx];
+            with_lane(lane, [this, &result_data, &solver_output, &logger, idx, lane] {
+                output_result(MathOutput<std::vector<SolverOutput<sym>>>{.solver_output = std::move(solver_output[idx]),
+                                                                         .optimizer_output = {},
+                                                                         .supernode_output = {}},
+                              result_data[lane], logger);
+            });
+        }
+
+        std::ranges::sort(single_lanes);
+        for (Idx const lane : single_lanes) {
+            with_lane(lane, [this, &options, &result_data, &logger, lane] {
+                calculate(options, false, result_data[lane], logger);
+            });
+        }
+    }
+
   public:
+    // number of scenarios of a batch that are calculated in lockstep, the lanes of the lockstep solver
+    static constexpr Idx lockstep_group_size = 4;
+
+    // whether the scenarios of a batch are calculated in lockstep, see calculate_power_flow_lockstep
+    static bool is_lockstep_calculation(Options const& options) {
+        using enum CalculationMethod;
+        return options.batch_lockstep == BatchLockstep::enabled &&
+               options.calculation_type == CalculationType::power_flow &&
+               options.optimizer_type == OptimizerType::no_optimization &&
+               options.power_flow_initialization == PowerFlowInitialization::default_initialization &&
+               (options.calculation_method == default_method || options.calculation_method == newton_raphson ||
+                options.calculation_method == linear);
+    }
+
+    // power flow of the scenarios of a batch, of which the ones with the same y bus are solved in lockstep
+    // apply(lane) applies the scenario of a lane to the model, and restore() restores the model afterwards. Every
+    // scenario is applied twice: once to prepare the input of the solvers, and once to produce its output. The
+    // scenarios that cannot share the solvers of the first one are calculated on their own afterwards.
+    // errors of a scenario are reported by handle_exception(lane); errors of restore() are thrown
+    template <typename ApplyFn, typename RestoreFn, typename HandleExceptionFn>
+        requires std::invocable<std::remove_cvref_t<ApplyFn>, Idx> && std::invocable<std::remove_cvref_t<RestoreFn>> &&
+                 std::invocable<std::remove_cvref_t<HandleExceptionFn>, Idx>
+    void calculate_power_flow_lockstep(Options const& options, std::span<MutableDataset const> result_data,
+                                       ApplyFn apply, RestoreFn restore, HandleExceptionFn handle_exception,
+                                       Logger& logger) {
+        assert(construction_complete_);
+        assert(is_lockstep_calculation(options));
+
+        calculation_symmetry_func_selector(
+            options.calculation_symmetry,
+            [this, &options, result_data, &apply, &restore, &handle_exception, &logger]<symmetry_tag sym>() {
+                calculate_power_flow_lockstep_<sym>(options, result_data, apply, restore, handle_exception, logger);
+            });
+    }
+
     static auto calculator(Options const& options, MainModelImpl& model, MutableDataset const& target_data,
                            bool cache_run, Logger& logger) {
         auto sub_opt = options; // copy
@@ -390,11 +615,17 @@ class MainModelImpl {
         assert(construction_complete_);
         return state_;
     }
+    // the y bus and solvers of the math models
+    auto const& math_state() const {
+        assert(construction_complete_);
+        return solver_preparation_context_.math_state;
+    }
     auto const& meta_data() const {
         assert(construction_complete_);
         assert(meta_data_ != nullptr);
         return *meta_data_;
     }
+    ModelRevisionKey revision_key() const { return revision_.key(); }
 
     void check_no_experimental_features_used(Options const& options, ConstDataset const* batch_dataset) const {
         bool const is_asymmetric_power_flow = options.calculation_type == CalculationType::power_flow &&
@@ -471,6 +702,9 @@ class MainModelImpl {
 
     OwnedUpdateDataset cached_inverse_update_{};
     UpdateChange cached_state_changes_{};
+    ModelRevision revision_{};
+    // workers for the sparse LU of large islands
+    LazyJobExecutor level_executor_{};
 #ifndef NDEBUG
     // construction_complete is used for debug assertions only
     bool construction_complete_{false};
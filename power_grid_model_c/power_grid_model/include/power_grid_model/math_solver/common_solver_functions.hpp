@@ -5,6 +5,7 @@
 #pragma once
 
 #include "measured_values.hpp"
+#include "sparse_lu_solver.hpp"
 #include "y_bus.hpp"
 
 #include "../calculation_parameters.hpp"
@@ -23,6 +24,7 @@
 #include <concepts>
 #include <functional>
 #include <map>
+#include <memory>
 #include <numeric>
 #include <ranges>
 #include <type_traits>
@@ -50,21 +52,36 @@ inline void add_linear_loads(IdxRange const& load_gens_per_bus, Idx /* bus_numbe
     }
 }
 
+// the diagonal of the linear matrix per bus, i.e. the diagonal of the y bus with the loads and sources added
+// the off-diagonal elements are the ones of the y bus
 template <symmetry_tag sym>
-inline void prepare_linear_matrix_and_rhs(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input,
-                                          grouped_idx_vector_type auto const& load_gens_per_bus,
-                                          grouped_idx_vector_type auto const& sources_per_bus,
-                                          SolverOutput<sym>& output, ComplexTensorVector<sym>& mat_data) {
-    IdxVector const& bus_entry = y_bus.lu_diag();
+inline void prepare_linear_diagonal_and_rhs(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input,
+                                            grouped_idx_vector_type auto const& load_gens_per_bus,
+                                            grouped_idx_vector_type auto const& sources_per_bus,
+                                            SolverOutput<sym>& output, ComplexTensorVector<sym>& diagonal) {
+    ComplexTensorVector<sym> const& ydata = y_bus.admittance();
+    IdxVector const& bus_entry = y_bus.bus_entry();
     for (auto const& [bus_number, load_gens, sources] : enumerated_zip_sequence(load_gens_per_bus, sources_per_bus)) {
-        Idx const diagonal_position = bus_entry[bus_number];
-        auto& diagonal_element = mat_data[diagonal_position];
+        auto& diagonal_element = diagonal[bus_number];
+        diagonal_element = ydata[bus_entry[bus_number]];
         auto& u_bus = output.u[bus_number];
         add_linear_loads(load_gens, bus_number, input, diagonal_element);
         add_sources(sources, bus_number, y_bus, input.source, diagonal_element, u_bus);
     }
 }
 
+// exact comparison of matrix elements, e.g. to check whether a factorization can be reused
+template <symmetry_tag sym>
+inline bool equal_elements(ComplexTensorVector<sym> const& lhs, ComplexTensorVector<sym> const& rhs) {
+    return std::ranges::equal(lhs, rhs, [](ComplexTensor<sym> const& x, ComplexTensor<sym> const& y) {
+        if constexpr (is_symmetric_v<sym>) {
+            return x == y;
+        } else {
+            return (x == y).all();
+        }
+    });
+}
+
 template <symmetry_tag sym> inline void copy_y_bus(YBus<sym> const& y_bus, ComplexTensorVector<sym>& mat_data) {
     ComplexTensorVector<sym> const& ydata = y_bus.admittance();
     std::ranges::transform(y_bus.map_lu_y_bus(), mat_data.begin(), [&](Idx k) {
@@ -75,6 +92,102 @@ template <symmetry_tag sym> inline void copy_y_bus(YBus<sym> const& y_bus, Compl
     });
 }
 
+// factorization of the matrix of a linear solver, in the LU pattern of the y bus
+// the matrix is assembled in matrix() and factorized by factorize()
+// the factorization is never changed in place, so the copies of a solver, e.g. the ones of the batch workers or the
+// copy in IterativePFSolver::iterate_power_flow, share it until one of them factorizes a new matrix
+//
+// in the low-rank contingency mode, the factorization of a base matrix is kept for the matrices that only differ from
+// it in a few buses, e.g. by the outage of a branch or by another fault. Those are solved as a low-rank update of the
+// base matrix instead of being factorized again.
+template <symmetry_tag sym> class LowRankUpdatedFactorization {
+  public:
+    using SparseSolverType = SparseLUSolver<ComplexTensor<sym>, ComplexValue<sym>, ComplexValue<sym>>;
+    using BlockPermArray = SparseSolverType::BlockPermArray;
+    static constexpr Idx max_low_rank_buses = 8;
+
+    explicit LowRankUpdatedFactorization(YBus<sym> const& y_bus)
+        : sparse_solver_{y_bus.row_indptr_lu(), y_bus.col_indices_lu(), y_bus.lu_diag(), y_bus.lu_symbolic()},
+          size_{y_bus.size()},
+          nnz_lu_{y_bus.nnz_lu()} {}
+
+    // returns whether the mode changed, in which case the matrix needs to be assembled and factorized again
+    bool set_contingency_mode(ContingencyMode contingency_mode) {
+        if (contingency_mode == contingency_mode_) {
+            return false;
+        }
+        contingency_mode_ = contingency_mode;
+        factorization_.reset();
+        low_rank_update_.rows.clear();
+        return true;
+    }
+
+    void set_level_parallelism(JobExecutor* executor, Idx n_thread) {
+        sparse_solver_.set_level_parallelism(executor, n_thread);
+    }
+
+    // the (unfactorized) matrix to factorize
+    // it is only allocated while it is assembled, the factorization takes it over
+    ComplexTensorVector<sym>& matrix() {
+        matrix_.resize(nnz_lu_);
+        return matrix_;
+    }
+
+    void factorize() {
+        assert(std::ssize(matrix_) == nnz_lu_);
+        if (contingency_mode_ == ContingencyMode::low_rank_update && factorization_ != nullptr &&
+            sparse_solver_.prepare_low_rank_update(factorization_->lu_data, factorization_->perm,
+                                                   factorization_->base_matrix, matrix_, max_low_rank_buses,
+                                                   low_rank_update_)) {
+            matrix_.clear();
+            return;
+        }
+        // in case the factorization fails, the next matrix is factorized again
+        factorization_.reset();
+        low_rank_update_.rows.clear();
+        Factorization factorization{.lu_data = std::move(matrix_), .perm = BlockPermArray(size_), .base_matrix = {}};
+        matrix_.clear();
+        if (contingency_mode_ == ContingencyMode::low_rank_update) {
+            factorization.base_matrix = factorization.lu_data;
+        }
+        ++n_factorization_;
+        sparse_solver_.prefactorize(factorization.lu_data, factorization.perm);
+        factorization_ = std::make_shared<Factorization const>(std::move(factorization));
+    }
+
+    // number of buses in which the matrix differs from the factorized base matrix
+    Idx low_rank_update_size() const { return std::ssize(low_rank_update_.rows); }
+    // number of sparse LU factorizations, i.e. without the reused factorizations and the low-rank updates
+    Idx n_factorization() const { return n_factorization_; }
+
+    void solve(ComplexValueVector<sym> const& rhs, ComplexValueVector<sym>& x) {
+        assert(factorization_ != nullptr);
+        if (low_rank_update_.rows.empty()) {
+            sparse_solver_.solve_with_prefactorized_matrix(factorization_->lu_data, factorization_->perm, rhs, x);
+        } else {
+            sparse_solver_.solve_with_low_rank_update(factorization_->lu_data, factorization_->perm, low_rank_update_,
+                                                      rhs, x);
+        }
+    }
+
+  private:
+    struct Factorization {
+        ComplexTensorVector<sym> lu_data;
+        BlockPermArray perm;
+        // low-rank contingency mode only: the unfactorized matrix
+        ComplexTensorVector<sym> base_matrix;
+    };
+
+    SparseSolverType sparse_solver_;
+    Idx size_;
+    Idx nnz_lu_;
+    ComplexTensorVector<sym> matrix_;
+    ContingencyMode contingency_mode_{ContingencyMode::full_rebuild};
+    std::shared_ptr<Factorization const> factorization_;
+    SparseSolverType::LowRankUpdate low_rank_update_;
+    Idx n_factorization_{0};
+};
+
 /// @brief Calculates current and power injection of source i for multiple symmetric sources at a node.
 /// The current injection of source i to the bus in phase space is:
 ///     i_inj_i = (y_ref_i * z_ref_t) [ (u_ref_i * y_ref_t - i_ref_t) + i_inj_t]
@@ -67,7 +67,6 @@ Nomenclature:
 #include <algorithm>
 #include <cmath>
 #include <complex>
-#include <memory>
 #include <vector>
 
 namespace power_grid_model::math_solver {
@@ -81,15 +80,12 @@ class IterativeCurrentPFSolver : public IterativePFSolver<sym_type, IterativeCur
   public:
     using sym = sym_type;
 
-    using SparseSolverType = SparseLUSolver<ComplexTensor<sym>, ComplexValue<sym>, ComplexValue<sym>>;
-    using BlockPermArray = SparseSolverType::BlockPermArray;
-
     static constexpr auto is_iterative = true;
 
     IterativeCurrentPFSolver(YBus<sym> const& y_bus, MathModelTopology const& topo)
         : IterativePFSolver<sym, IterativeCurrentPFSolver>{y_bus, topo},
           rhs_u_(y_bus.size()),
-          sparse_solver_{y_bus.row_indptr_lu(), y_bus.col_indices_lu(), y_bus.lu_diag()} {}
+          factorization_{y_bus} {}
 
     // Add source admittance to Y bus and set variable for prepared y bus to true
     void initialize_derived_solver(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input,
@@ -101,7 +97,7 @@ class IterativeCurrentPFSolver : public IterativePFSolver<sym_type, IterativeCur
         // if Y bus is not up to date
         // re-build matrix and prefactorize Build y bus data with source admittance
         if (parameters_changed_) {
-            ComplexTensorVector<sym> mat_data(y_bus.nnz_lu());
+            ComplexTensorVector<sym>& mat_data = factorization_.matrix();
             detail::copy_y_bus<sym>(y_bus, mat_data);
 
             for (auto const& [bus_number, sources] : enumerated_zip_sequence(sources_per_bus)) {
@@ -113,11 +109,7 @@ class IterativeCurrentPFSolver : public IterativePFSolver<sym_type, IterativeCur
                 }
             }
             // prefactorize
-            BlockPermArray perm(this->n_bus_);
-            sparse_solver_.prefactorize(mat_data, perm);
-            // move pre-factorized version into shared ptr
-            mat_data_ = std::make_shared<ComplexTensorVector<sym> const>(std::move(mat_data));
-            perm_ = std::make_shared<BlockPermArray const>(std::move(perm));
+            factorization_.factorize();
         }
         parameters_changed_ = false;
     }
@@ -142,7 +134,7 @@ class IterativeCurrentPFSolver : public IterativePFSolver<sym_type, IterativeCur
 
     // Solve the linear equations I_inj = YU
     // inplace
-    void solve_matrix() { sparse_solver_.solve_with_prefactorized_matrix(*mat_data_, *perm_, rhs_u_, rhs_u_); }
+    void solve_matrix() { factorization_.solve(rhs_u_, rhs_u_); }
 
     // Find maximum deviation in voltage among all buses
     double iterate_unknown(ComplexValueVector<sym>& u, double /*err_tol*/, bool /*cache_run*/) {
@@ -161,12 +153,26 @@ class IterativeCurrentPFSolver : public IterativePFSolver<sym_type, IterativeCur
 
     void parameters_changed(bool changed) { parameters_changed_ = parameters_changed_ || changed; }
 
+    // keep the factorization of the copy that ran the calculation, see iterate_power_flow
+    void keep_factorization(IterativeCurrentPFSolver const& calculated_solver) {
+        factorization_ = calculated_solver.factorization_;
+        parameters_changed_ = calculated_solver.parameters_changed_;
+    }
+
+    void set_contingency_mode(ContingencyMode contingency_mode) {
+        parameters_changed(factorization_.set_contingency_mode(contingency_mode));
+    }
+
+    void set_level_parallelism(JobExecutor* executor, Idx n_thread) {
+        factorization_.set_level_parallelism(executor, n_thread);
+    }
+
+    Idx low_rank_update_size() const { return factorization_.low_rank_update_size(); }
+
   private:
     ComplexValueVector<sym> rhs_u_;
-    std::shared_ptr<ComplexTensorVector<sym> const> mat_data_;
-    // sparse solver
-    SparseSolverType sparse_solver_;
-    std::shared_ptr<BlockPermArray const> perm_;
+    // sparse linear equation and its factorization, possibly with a low-rank update
+    detail::LowRankUpdatedFactorization<sym> factorization_;
     bool parameters_changed_ = true;
 
     void add_loads(IdxRange const& load_gens, Idx bus_number, PowerFlowInput<sym> const& input,
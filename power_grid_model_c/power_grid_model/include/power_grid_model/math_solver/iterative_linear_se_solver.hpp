@@ -91,11 +91,15 @@ template <symmetry_tag sym_type> class IterativeLinearSESolver {
           math_topo_{topo},
           data_gain_(y_bus.nnz_lu()),
           x_rhs_(y_bus.size()),
-          sparse_solver_{y_bus.row_indptr_lu(), y_bus.col_indices_lu(), y_bus.lu_diag()},
+          sparse_solver_{y_bus.row_indptr_lu(), y_bus.col_indices_lu(), y_bus.lu_diag(), y_bus.lu_symbolic()},
           perm_(y_bus.size()) {}
 
-    SolverOutput<sym> run_state_estimation(YBus<sym> const& y_bus, StateEstimationInput<sym> const& input,
-                                           double err_tol, Idx max_iter, Logger& log) {
+    SolverOutput<sym>
+    run_state_estimation(YBus<sym> const& y_bus, StateEstimationInput<sym> const& input, double err_tol, Idx max_iter,
+                         Logger& log,
+                         FactorizationPrecision factorization_precision = FactorizationPrecision::double_precision) {
+        sparse_solver_.set_factorization_precision(factorization_precision);
+
         // prepare
         Timer main_timer;
         Timer sub_timer;
@@ -154,6 +158,10 @@ template <symmetry_tag sym_type> class IterativeLinearSESolver {
         return output;
     }
 
+    void set_level_parallelism(JobExecutor* executor, Idx n_thread) {
+        sparse_solver_.set_level_parallelism(executor, n_thread);
+    }
+
   private:
     // array selection function pointer
     static constexpr std::array has_branch_power_{&MeasuredValues<sym>::has_branch_from_power,
@@ -10,6 +10,7 @@
 
 // Check if all includes needed
 #include "common_solver_functions.hpp"
+#include "sparse_lu_lockstep_solver.hpp"
 #include "y_bus.hpp"
 
 #include "../calculation_parameters.hpp"
@@ -20,8 +21,12 @@
 #include "../common/logging.hpp"
 #include "../common/timer.hpp"
 
+#include <algorithm>
+#include <cassert>
 #include <functional>
+#include <iterator>
 #include <limits>
+#include <span>
 #include <vector>
 
 namespace power_grid_model::math_solver {
@@ -30,8 +35,76 @@ namespace power_grid_model::math_solver {
 template <symmetry_tag sym, typename DerivedSolver> class IterativePFSolver {
   public:
     friend DerivedSolver;
-    SolverOutput<sym> run_power_flow(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input, double err_tol,
-                                     Idx max_iter, bool cache_run, Logger& log) {
+    SolverOutput<sym>
+    run_power_flow(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input, double err_tol, Idx max_iter,
+                   bool cache_run, Logger& log,
+                   PowerFlowInitialization initialization = PowerFlowInitialization::default_initialization) {
+        bool const warm_start = initialization == PowerFlowInitialization::warm_start && !cache_run;
+
+        // start from the solution of the previous calculation on this solver
+        // if that does not converge, e.g. because the previous scenario was too different, start all over
+        if (warm_start && std::ssize(previous_u_) == n_bus_) {
+            try {
+                auto output = iterate_power_flow(y_bus, input, err_tol, max_iter, cache_run, log, &previous_u_);
+                previous_u_ = output.u;
+                return output;
+            } catch (IterationDiverge const&) { // NOLINT(bugprone-empty-catch) // NOSONAR
+                // fall back to the default initialization
+            } catch (SparseMatrixError const&) { // NOLINT(bugprone-empty-catch) // NOSONAR
+                // fall back to the default initialization
+            }
+        }
+
+        auto output = iterate_power_flow(y_bus, input, err_tol, max_iter, cache_run, log, nullptr);
+        if (warm_start) {
+            previous_u_ = output.u;
+        }
+        return output;
+    }
+
+    // solve the power flow of several scenarios on the same topology and parameters, e.g. the scenarios of a time
+    // series batch. Up to lockstep_lanes scenarios iterate in lockstep: each iteration prepares the linear equations of
+    // the scenarios that did not converge yet, and solves them at once if the derived solver supports a lockstep solve.
+    // Each scenario stops iterating as soon as it converges.
+    std::vector<SolverOutput<sym>> run_power_flow_lockstep(YBus<sym> const& y_bus,
+                                                           std::span<PowerFlowInput<sym> const> inputs, double err_tol,
+                                                           Idx max_iter, Logger& log) {
+        std::vector<SolverOutput<sym>> outputs;
+        outputs.reserve(inputs.size());
+        for (Idx first = 0; first < std::ssize(inputs); first += lockstep_lanes) {
+            Idx const n_lanes = std::min(lockstep_lanes, std::ssize(inputs) - first);
+            auto lane_outputs =
+                iterate_power_flow_lockstep(y_bus, inputs.subspan(first, n_lanes), err_tol, max_iter, log);
+            std::ranges::move(lane_outputs, std::back_inserter(outputs));
+        }
+        return outputs;
+    }
+
+    void calculate_result(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input, SolverOutput<sym>& output) {
+        detail::calculate_pf_result(y_bus, input, sources_per_bus_.get(), load_gens_per_bus_.get(), output,
+                                    [this](Idx i) { return (load_gen_type_.get())[i]; });
+    }
+
+  private:
+    Idx n_bus_;
+    std::reference_wrapper<DoubleVector const> phase_shift_;
+    std::reference_wrapper<SparseGroupedIdxVector const> load_gens_per_bus_;
+    std::reference_wrapper<DenseGroupedIdxVector const> sources_per_bus_;
+    std::reference_wrapper<std::vector<LoadGenType> const> load_gen_type_;
+    // converged voltages of the previous warm-started calculation
+    ComplexValueVector<sym> previous_u_;
+
+    IterativePFSolver(YBus<sym> const& y_bus, MathModelTopology const& topo)
+        : n_bus_{y_bus.size()},
+          phase_shift_{std::cref(topo.phase_shift)},
+          load_gens_per_bus_{std::cref(topo.load_gens_per_bus)},
+          sources_per_bus_{std::cref(topo.sources_per_bus)},
+          load_gen_type_{std::cref(topo.load_gen_type)} {}
+
+    // initial_u overrides the initial voltages of the derived solver if provided
+    SolverOutput<sym> iterate_power_flow(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input, double err_tol,
+                                         Idx max_iter, bool cache_run, Logger& log,
+                                         ComplexValueVector<sym> const* initial_u) {
         // keep copy, as reference might break batching
         auto derived_solver = static_cast<DerivedSolver&>(*this);
 
@@ -47,6 +120,16 @@ template <symmetry_tag sym, typename DerivedSolver> class IterativePFSolver {
             Timer const sub_timer{log, LogEvent::initialize_calculation};
             // Further initialization specific to the derived solver
             derived_solver.initialize_derived_solver(y_bus, input, output);
+            // the factorization of the copy only depends on the parameters, so it is kept for the next calculation
+            if constexpr (requires { derived_solver.keep_factorization(derived_solver); }) {
+                static_cast<DerivedSolver&>(*this).keep_factorization(derived_solver);
+            }
+            if (initial_u != nullptr) {
+                output.u = *initial_u;
+                if constexpr (requires { derived_solver.set_initial_voltage(output.u); }) {
+                    derived_solver.set_initial_voltage(output.u);
+                }
+            }
         }
 
         // start calculation
@@ -89,23 +172,114 @@ template <symmetry_tag sym, typename DerivedSolver> class IterativePFSolver {
         return output;
     }
 
-    void calculate_result(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input, SolverOutput<sym>& output) {
-        detail::calculate_pf_result(y_bus, input, sources_per_bus_.get(), load_gens_per_bus_.get(), output,
-                                    [this](Idx i) { return (load_gen_type_.get())[i]; });
-    }
+    // same iteration as iterate_power_flow, for each of the inputs on its own copy of the derived solver
+    std::vector<SolverOutput<sym>> iterate_power_flow_lockstep(YBus<sym> const& y_bus,
+                                                               std::span<PowerFlowInput<sym> const> inputs,
+                                                               double err_tol, Idx max_iter, Logger& log) {
+        Idx const n_lanes = std::ssize(inputs);
+        assert(n_lanes <= lockstep_lanes);
 
-  private:
-    Idx n_bus_;
-    std::reference_wrapper<DoubleVector const> phase_shift_;
-    std::reference_wrapper<SparseGroupedIdxVector const> load_gens_per_bus_;
-    std::reference_wrapper<DenseGroupedIdxVector const> sources_per_bus_;
-    std::reference_wrapper<std::vector<LoadGenType> const> load_gen_type_;
-    IterativePFSolver(YBus<sym> const& y_bus, MathModelTopology const& topo)
-        : n_bus_{y_bus.size()},
-          phase_shift_{std::cref(topo.phase_shift)},
-          load_gens_per_bus_{std::cref(topo.load_gens_per_bus)},
-          sources_per_bus_{std::cref(topo.sources_per_bus)},
-          load_gen_type_{std::cref(topo.load_gen_type)} {}
+        std::vector<DerivedSolver> derived_solvers;
+        derived_solvers.reserve(n_lanes);
+
+        // prepare
+        std::vector<SolverOutput<sym>> outputs(n_lanes);
+        for (auto& output : outputs) {
+            output.u.resize(n_bus_);
+        }
+        double max_dev = std::numeric_limits<double>::infinity();
+
+        Timer main_timer{log, LogEvent::math_solver};
+
+        // initialize
+        {
+            Timer const sub_timer{log, LogEvent::initialize_calculation};
+            for (Idx lane = 0; lane != n_lanes; ++lane) {
+                // the copies of the next lanes start from the factorization of this one
+                auto& derived_solver = derived_solvers.emplace_back(static_cast<DerivedSolver const&>(*this));
+                derived_solver.initialize_derived_solver(y_bus, inputs[lane], outputs[lane]);
+                if constexpr (requires { derived_solver.keep_factorization(derived_solver); }) {
+                    static_cast<DerivedSolver&>(*this).keep_factorization(derived_solver);
+                }
+            }
+        }
+        // solvers of the scenarios that did not converge yet, or a null pointer
+        std::vector<DerivedSolver*> iterating(n_lanes);
+        std::ranges::transform(derived_solvers, iterating.begin(), [](DerivedSolver& solver) { return &solver; });
+
+        [[maybe_unused]] auto lockstep_solver = [&y_bus] {
+            if constexpr (requires { typename DerivedSolver::LockstepSolverType; }) {
+                return typename DerivedSolver::LockstepSolverType{y_bus.row_indptr_lu(), y_bus.col_indices_lu(),
+                                                                  y_bus.lu_diag(), y_bus.lu_symbolic()};
+            } else {
+                return nullptr;
+            }
+        }();
+
+        // start calculation
+        // iteration
+        Idx num_iter = 0;
+        while (std::ranges::any_of(iterating, [](DerivedSolver const* solver) { return solver != nullptr; })) {
+            if (num_iter++ == max_iter) {
+                throw IterationDiverge{max_iter, max_dev, err_tol};
+            }
+            {
+                // Prepare the matrices of linear equations to be solved
+                Timer const sub_timer{log, LogEvent::prepare_matrices};
+                for (Idx lane = 0; lane != n_lanes; ++lane) {
+                    if (iterating[lane] != nullptr) {
+                        iterating[lane]->prepare_matrix_and_rhs(y_bus, inputs[lane], outputs[lane].u);
+                    }
+                }
+            }
+            {
+                // Solve the linear equations
+                Timer const sub_timer{log, LogEvent::solve_sparse_linear_equation};
+                if constexpr (requires { typename DerivedSolver::LockstepSolverType; }) {
+                    DerivedSolver::solve_matrix_lockstep(lockstep_solver, iterating);
+                } else {
+                    for (DerivedSolver* const solver : iterating) {
+                        if (solver != nullptr) {
+                            solver->solve_matrix();
+                        }
+                    }
+                }
+            }
+            {
+                // Calculate maximum deviation of voltage at any bus, of the scenarios that did not converge yet
+                Timer const sub_timer{log, LogEvent::iterate_unknown};
+                max_dev = 0.0;
+                for (Idx lane = 0; lane != n_lanes; ++lane) {
+                    if (iterating[lane] == nullptr) {
+                        continue;
+                    }
+                    double const lane_max_dev = iterating[lane]->iterate_unknown(outputs[lane].u, err_tol, false);
+                    if (lane_max_dev <= err_tol) {
+                        iterating[lane] = nullptr;
+                    } else {
+                        max_dev = std::max(max_dev, lane_max_dev);
+                    }
+                }
+            }
+        }
+
+        // calculate math result
+        {
+            Timer const sub_timer{log, LogEvent::calculate_math_result};
+            for (Idx lane = 0; lane != n_lanes; ++lane) {
+                if constexpr (requires { derived_solvers[lane].finalize_result(inputs[lane], outputs[lane]); }) {
+                    derived_solvers[lane].finalize_result(inputs[lane], outputs[lane]);
+                }
+                calculate_result(y_bus, inputs[lane], outputs[lane]);
+            }
+        }
+        // Manually stop timers to avoid "Max number of iterations" to be included in the timing.
+        main_timer.stop();
+
+        log.log(LogEvent::iterative_pf_solver_max_num_iter, num_iter);
+
+        return outputs;
+    }
 };
 
 } // namespace power_grid_model::math_solver
@@ -29,6 +29,7 @@ if there are sources
 */
 
 #include "common_solver_functions.hpp"
+#include "sparse_lu_lockstep_solver.hpp"
 #include "sparse_lu_solver.hpp"
 #include "y_bus.hpp"
 
@@ -40,7 +41,11 @@ if there are sources
 #include "../common/three_phase_tensor.hpp"
 #include "../common/timer.hpp"
 
+#include <algorithm>
+#include <array>
 #include <functional>
+#include <span>
+#include <vector>
 
 namespace power_grid_model::math_solver {
 
@@ -51,18 +56,14 @@ template <symmetry_tag sym_type> class LinearPFSolver {
   public:
     using sym = sym_type;
 
-    using SparseSolverType = SparseLUSolver<ComplexTensor<sym>, ComplexValue<sym>, ComplexValue<sym>>;
-    using BlockPermArray = SparseLUSolver<ComplexTensor<sym>, ComplexValue<sym>, ComplexValue<sym>>::BlockPermArray;
-
     static constexpr auto is_iterative = false;
 
     LinearPFSolver(YBus<sym> const& y_bus, MathModelTopology const& topo)
         : n_bus_{y_bus.size()},
           load_gens_per_bus_{std::cref(topo.load_gens_per_bus)},
           sources_per_bus_{std::cref(topo.sources_per_bus)},
-          mat_data_(y_bus.nnz_lu()),
-          sparse_solver_{y_bus.row_indptr_lu(), y_bus.col_indices_lu(), y_bus.lu_diag()},
-          perm_(n_bus_) {}
+          diagonal_(n_bus_),
+          factorization_{y_bus} {}
 
     SolverOutput<sym> run_power_flow(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input, Logger& log) {
         using enum LogEvent;
@@ -74,14 +75,26 @@ template <symmetry_tag sym_type> class LinearPFSolver {
         Timer const main_timer{log, math_solver};
 
         // prepare matrix
+        // the off-diagonal elements only change with the parameters, so the matrix is kept as long as the diagonal
+        // does not change, e.g. for batches that only change the source voltages
         Timer sub_timer{log, prepare_matrix};
-        detail::copy_y_bus<sym>(y_bus, mat_data_);
-        prepare_matrix_and_rhs(y_bus, input, output);
+        prepare_diagonal_and_rhs(y_bus, input, output);
+        bool const matrix_changed = parameters_changed_ || !detail::equal_elements<sym>(diagonal_, matrix_diagonal_);
+        if (matrix_changed) {
+            assemble_matrix(y_bus, diagonal_, factorization_.matrix());
+        }
 
         // solve
         // u vector will have I_injection for slack bus for now
         sub_timer = Timer{log, solve_sparse_linear_equation};
-        sparse_solver_.prefactorize_and_solve(mat_data_, perm_, output.u, output.u);
+        if (matrix_changed) {
+            // in case the factorization fails, the next calculation factorizes again
+            parameters_changed_ = true;
+            factorization_.factorize();
+            matrix_diagonal_ = diagonal_;
+            parameters_changed_ = false;
+        }
+        factorization_.solve(output.u, output.u);
 
         // calculate math result
         sub_timer = Timer{log, calculate_math_result};
@@ -91,20 +104,108 @@ template <symmetry_tag sym_type> class LinearPFSolver {
         return output;
     }
 
+    // solve the power flow of several scenarios on the same topology and parameters, e.g. the scenarios of a time
+    // series batch. The matrices of lockstep_lanes scenarios at a time are factorized and solved in lockstep. A
+    // scenario of which the lockstep factorization fails is solved on its own instead.
+    std::vector<SolverOutput<sym>> run_power_flow_lockstep(YBus<sym> const& y_bus,
+                                                           std::span<PowerFlowInput<sym> const> inputs, Logger& log) {
+        using enum LogEvent;
+        using LockstepSolverType = SparseLULockstepSolver<ComplexTensor<sym>, ComplexValue<sym>, ComplexValue<sym>>;
+
+        // output
+        std::vector<SolverOutput<sym>> outputs(inputs.size());
+
+        Timer const main_timer{log, math_solver};
+
+        LockstepSolverType lockstep_solver{y_bus.row_indptr_lu(), y_bus.col_indices_lu(), y_bus.lu_diag(),
+                                           y_bus.lu_symbolic()};
+        std::vector<ComplexTensorVector<sym>> lane_diagonal(lockstep_lanes, ComplexTensorVector<sym>(n_bus_));
+        std::vector<ComplexTensorVector<sym>> lane_mat_data(lockstep_lanes, ComplexTensorVector<sym>(y_bus.nnz_lu()));
+
+        for (Idx first = 0; first < std::ssize(inputs); first += lockstep_lanes) {
+            Idx const n_lanes = std::min(lockstep_lanes, std::ssize(inputs) - first);
+            std::array<ComplexTensorVector<sym> const*, lockstep_lanes> lane_data{};
+            std::array<ComplexValueVector<sym> const*, lockstep_lanes> lane_rhs{};
+            std::array<ComplexValueVector<sym>*, lockstep_lanes> lane_u{};
+
+            // prepare matrix
+            Timer sub_timer{log, prepare_matrix};
+            for (Idx lane = 0; lane != n_lanes; ++lane) {
+                SolverOutput<sym>& output = outputs[first + lane];
+                output.u.resize(n_bus_);
+                detail::prepare_linear_diagonal_and_rhs(y_bus, inputs[first + lane], load_gens_per_bus_.get(),
+                                                        sources_per_bus_.get(), output, lane_diagonal[lane]);
+                assemble_matrix(y_bus, lane_diagonal[lane], lane_mat_data[lane]);
+                lane_data[lane] = &lane_mat_data[lane];
+                lane_rhs[lane] = &output.u;
+                lane_u[lane] = &output.u;
+            }
+
+            // solve
+            // u vector will have I_injection for slack bus for now
+            sub_timer = Timer{log, solve_sparse_linear_equation};
+            auto const failed_lanes = lockstep_solver.prefactorize(std::span{lane_data}.first(n_lanes));
+            lockstep_solver.solve_with_prefactorized_matrix(std::span{lane_rhs}.first(n_lanes),
+                                                            std::span{lane_u}.first(n_lanes));
+
+            // calculate math result
+            sub_timer = Timer{log, calculate_math_result};
+            for (Idx lane = 0; lane != n_lanes; ++lane) {
+                if (failed_lanes[lane]) {
+                    continue;
+                }
+                calculate_result(y_bus, inputs[first + lane], outputs[first + lane]);
+            }
+            sub_timer.stop();
+
+            for (Idx lane = 0; lane != n_lanes; ++lane) {
+                if (failed_lanes[lane]) {
+                    outputs[first + lane] = run_power_flow(y_bus, inputs[first + lane], log);
+                }
+            }
+        }
+
+        // output
+        return outputs;
+    }
+
+    void parameters_changed(bool changed) { parameters_changed_ = parameters_changed_ || changed; }
+
+    void set_contingency_mode(ContingencyMode contingency_mode) {
+        parameters_changed(factorization_.set_contingency_mode(contingency_mode));
+    }
+
+    void set_level_parallelism(JobExecutor* executor, Idx n_thread) {
+        factorization_.set_level_parallelism(executor, n_thread);
+    }
+
+    Idx low_rank_update_size() const { return factorization_.low_rank_update_size(); }
+    Idx n_factorization() const { return factorization_.n_factorization(); }
+
   private:
     Idx n_bus_;
     // shared topo data
     std::reference_wrapper<SparseGroupedIdxVector const> load_gens_per_bus_;
     std::reference_wrapper<DenseGroupedIdxVector const> sources_per_bus_;
-    // sparse linear equation
-    ComplexTensorVector<sym> mat_data_;
-    // sparse solver
-    SparseSolverType sparse_solver_;
-    BlockPermArray perm_;
-
-    void prepare_matrix_and_rhs(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input, SolverOutput<sym>& output) {
-        detail::prepare_linear_matrix_and_rhs(y_bus, input, load_gens_per_bus_.get(), sources_per_bus_.get(), output,
-                                              mat_data_);
+    // diagonal of the matrix of the current calculation, and of the matrix of the factorization
+    ComplexTensorVector<sym> diagonal_;
+    ComplexTensorVector<sym> matrix_diagonal_;
+    // sparse linear equation and its factorization, possibly with a low-rank update
+    detail::LowRankUpdatedFactorization<sym> factorization_;
+    bool parameters_changed_ = true;
+
+    void prepare_diagonal_and_rhs(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input, SolverOutput<sym>& output) {
+        detail::prepare_linear_diagonal_and_rhs(y_bus, input, load_gens_per_bus_.get(), sources_per_bus_.get(), output,
+                                                diagonal_);
+    }
+
+    void assemble_matrix(YBus<sym> const& y_bus, ComplexTensorVector<sym> const& diagonal,
+                        ComplexTensorVector<sym>& mat_data) const {
+        detail::copy_y_bus<sym>(y_bus, mat_data);
+        IdxVector const& bus_entry = y_bus.lu_diag();
+        for (Idx bus_number = 0; bus_number != n_bus_; ++bus_number) {
+            mat_data[bus_entry[bus_number]] = diagonal[bus_number];
+        }
     }
 
     void calculate_result(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input, SolverOutput<sym>& output) {
@@ -24,6 +24,8 @@
 #include <limits>
 #include <memory>
 #include <optional>
+#include <span>
+#include <vector>
 
 namespace power_grid_model {
 
@@ -41,7 +43,8 @@ template <symmetry_tag sym> class MathSolver : public MathSolverBase<sym> {
     }
 
     SolverOutput<sym> run_power_flow(PowerFlowInput<sym> const& input, double err_tol, Idx max_iter, bool cache_run,
-                                     Logger& log, CalculationMethod calculation_method, YBus<sym> const& y_bus) final {
+                                     Logger& log, CalculationMethod calculation_method,
+                                     PowerFlowInitialization initialization, YBus<sym> const& y_bus) final {
         using enum CalculationMethod;
 
         // set method to always linear if all load_gens have const_y
@@ -51,20 +54,60 @@ template <symmetry_tag sym> class MathSolver : public MathSolverBase<sym> {
         case default_method:
             [[fallthrough]]; // use Newton-Raphson by default
         case newton_raphson:
-            return run_power_flow_newton_raphson(input, err_tol, max_iter, cache_run, log, y_bus);
+            return run_power_flow_newton_raphson(input, err_tol, max_iter, cache_run, log, initialization, y_bus);
         case linear:
             return run_power_flow_linear(input, err_tol, max_iter, log, y_bus);
         case linear_current:
             return run_power_flow_linear_current(input, err_tol, max_iter, cache_run, log, y_bus);
         case iterative_current:
-            return run_power_flow_iterative_current(input, err_tol, max_iter, cache_run, log, y_bus);
+            return run_power_flow_iterative_current(input, err_tol, max_iter, cache_run, log, initialization, y_bus);
         default:
             throw InvalidCalculationMethod{};
         }
     }
 
+    std::vector<SolverOutput<sym>> run_power_flow_lockstep(std::span<PowerFlowInput<sym> const> inputs, double err_tol,
+                                                           Idx max_iter, Logger& log,
+                                                           CalculationMethod calculation_method,
+                                                           YBus<sym> const& y_bus) final {
+        using enum CalculationMethod;
+
+        // set method to always linear if all load_gens have const_y
+        calculation_method = all_const_y_ ? linear : calculation_method;
+
+        switch (calculation_method) {
+        case default_method:
+            [[fallthrough]]; // use Newton-Raphson by default
+        case newton_raphson:
+            if (!newton_raphson_pf_solver_.has_value()) {
+                Timer const timer{log, LogEvent::create_math_solver};
+                newton_raphson_pf_solver_.emplace(y_bus, *topo_ptr_);
+                configure_solver(newton_raphson_pf_solver_);
+            }
+            return newton_raphson_pf_solver_.value().run_power_flow_lockstep(y_bus, inputs, err_tol, max_iter, log);
+        case linear:
+            if (!linear_pf_solver_.has_value()) {
+                Timer const timer{log, LogEvent::create_math_solver};
+                linear_pf_solver_.emplace(y_bus, *topo_ptr_);
+                configure_solver(linear_pf_solver_);
+            }
+            return linear_pf_solver_.value().run_power_flow_lockstep(y_bus, inputs, log);
+        default: {
+            // the other methods solve the scenarios one by one
+            std::vector<SolverOutput<sym>> outputs;
+            outputs.reserve(inputs.size());
+            for (auto const& input : inputs) {
+                outputs.push_back(run_power_flow(input, err_tol, max_iter, false, log, calculation_method,
+                                                 PowerFlowInitialization::default_initialization, y_bus));
+            }
+            return outputs;
+        }
+        }
+    }
+
     SolverOutput<sym> run_state_estimation(StateEstimationInput<sym> const& input, double err_tol, Idx max_iter,
                                            Logger& log, CalculationMethod calculation_method,
+                                           FactorizationPrecision factorization_precision,
                                            YBus<sym> const& y_bus) final {
         using enum CalculationMethod;
 
@@ -72,9 +115,9 @@ template <symmetry_tag sym> class MathSolver : public MathSolverBase<sym> {
         case default_method:
             [[fallthrough]]; // use iterative linear by default
         case iterative_linear:
-            return run_state_estimation_iterative_linear(input, err_tol, max_iter, log, y_bus);
+            return run_state_estimation_iterative_linear(input, err_tol, max_iter, log, factorization_precision, y_bus);
         case newton_raphson:
-            return run_state_estimation_newton_raphson(input, err_tol, max_iter, log, y_bus);
+            return run_state_estimation_newton_raphson(input, err_tol, max_iter, log, factorization_precision, y_bus);
         default:
             throw InvalidCalculationMethod{};
         }
@@ -92,6 +135,7 @@ template <symmetry_tag sym> class MathSolver : public MathSolverBase<sym> {
         if (!iec60909_sc_solver_.has_value()) {
             Timer const timer{log, LogEvent::create_math_solver};
             iec60909_sc_solver_.emplace(y_bus, *topo_ptr_);
+            configure_solver(iec60909_sc_solver_);
         }
 
         // call calculation
@@ -109,6 +153,23 @@ template <symmetry_tag sym> class MathSolver : public MathSolverBase<sym> {
         if (iterative_current_pf_solver_.has_value()) {
             iterative_current_pf_solver_->parameters_changed(changed);
         }
+        if (linear_pf_solver_.has_value()) {
+            linear_pf_solver_->parameters_changed(changed);
+        }
+        if (iec60909_sc_solver_.has_value()) {
+            iec60909_sc_solver_->parameters_changed(changed);
+        }
+    }
+
+    void set_level_parallelism(JobExecutor* executor, Idx n_thread) final {
+        level_executor_ = executor;
+        n_level_thread_ = n_thread;
+        configure_solvers();
+    }
+
+    void set_contingency_mode(ContingencyMode contingency_mode) final {
+        contingency_mode_ = contingency_mode;
+        configure_solvers();
     }
 
   private:
@@ -120,14 +181,39 @@ template <symmetry_tag sym> class MathSolver : public MathSolverBase<sym> {
     std::optional<IterativeLinearSESolver<sym>> iterative_linear_se_solver_;
     std::optional<NewtonRaphsonSESolver<sym>> newton_raphson_se_solver_;
     std::optional<ShortCircuitSolver<sym>> iec60909_sc_solver_;
+    JobExecutor* level_executor_{nullptr};
+    Idx n_level_thread_{1};
+    ContingencyMode contingency_mode_{ContingencyMode::full_rebuild};
+
+    void configure_solvers() {
+        configure_solver(newton_raphson_pf_solver_);
+        configure_solver(linear_pf_solver_);
+        configure_solver(iterative_current_pf_solver_);
+        configure_solver(iterative_linear_se_solver_);
+        configure_solver(newton_raphson_se_solver_);
+        configure_solver(iec60909_sc_solver_);
+    }
+
+    // only the solvers with a single factorization of the y bus support low-rank updates
+    template <typename Solver> void configure_solver(std::optional<Solver>& solver) const {
+        if (solver.has_value()) {
+            solver->set_level_parallelism(level_executor_, n_level_thread_);
+            if constexpr (requires { solver->set_contingency_mode(contingency_mode_); }) {
+                solver->set_contingency_mode(contingency_mode_);
+            }
+        }
+    }
 
     SolverOutput<sym> run_power_flow_newton_raphson(PowerFlowInput<sym> const& input, double err_tol, Idx max_iter,
-                                                    bool cache_run, Logger& log, YBus<sym> const& y_bus) {
+                                                    bool cache_run, Logger& log,
+                                                    PowerFlowInitialization initialization, YBus<sym> const& y_bus) {
         if (!newton_raphson_pf_solver_.has_value()) {
             Timer const timer{log, LogEvent::create_math_solver};
             newton_raphson_pf_solver_.emplace(y_bus, *topo_ptr_);
+            configure_solver(newton_raphson_pf_solver_);
         }
-        return newton_raphson_pf_solver_.value().run_power_flow(y_bus, input, err_tol, max_iter, cache_run, log);
+        return newton_raphson_pf_solver_.value().run_power_flow(y_bus, input, err_tol, max_iter, cache_run, log,
+                                                                initialization);
     }
 
     SolverOutput<sym> run_power_flow_linear(PowerFlowInput<sym> const& input, double /* err_tol */, Idx /* max_iter */,
@@ -135,48 +221,62 @@ template <symmetry_tag sym> class MathSolver : public MathSolverBase<sym> {
         if (!linear_pf_solver_.has_value()) {
             Timer const timer{log, LogEvent::create_math_solver};
             linear_pf_solver_.emplace(y_bus, *topo_ptr_);
+            configure_solver(linear_pf_solver_);
         }
         return linear_pf_solver_.value().run_power_flow(y_bus, input, log);
     }
 
     SolverOutput<sym> run_power_flow_iterative_current(PowerFlowInput<sym> const& input, double err_tol, Idx max_iter,
-                                                       bool cache_run, Logger& log, YBus<sym> const& y_bus) {
+                                                       bool cache_run, Logger& log,
+                                                       PowerFlowInitialization initialization, YBus<sym> const& y_bus) {
         if (!iterative_current_pf_solver_.has_value()) {
             Timer const timer{log, LogEvent::create_math_solver};
             iterative_current_pf_solver_.emplace(y_bus, *topo_ptr_);
+            configure_solver(iterative_current_pf_solver_);
         }
-        return iterative_current_pf_solver_.value().run_power_flow(y_bus, input, err_tol, max_iter, cache_run, log);
+        return iterative_current_pf_solver_.value().run_power_flow(y_bus, input, err_tol, max_iter, cache_run, log,
+                                                                   initialization);
     }
 
     SolverOutput<sym> run_power_flow_linear_current(PowerFlowInput<sym> const& input, double /* err_tol */,
                                                     Idx /* max_iter */, bool cache_run, Logger& log,
                                                     YBus<sym> const& y_bus) {
+        // the single iteration always starts from the flat start, otherwise the approximation would depend on the
+        // previous calculation
         return run_power_flow_iterative_current(input, std::numeric_limits<double>::infinity(), 1, cache_run, log,
-                                                y_bus);
+                                                PowerFlowInitialization::default_initialization, y_bus);
     }
 
     SolverOutput<sym> run_state_estimation_iterative_linear(StateEstimationInput<sym> const& input, double err_tol,
-                                                            Idx max_iter, Logger& log, YBus<sym> const& y_bus) {
+                                                            Idx max_iter, Logger& log,
+                                                            FactorizationPrecision factorization_precision,
+                                                            YBus<sym> const& y_bus) {
         // construct model if needed
         if (!iterative_linear_se_solver_.has_value()) {
             Timer const timer{log, LogEvent::create_math_solver};
             iterative_linear_se_solver_.emplace(y_bus, *topo_ptr_);
+            configure_solver(iterative_linear_se_solver_);
         }
 
         // call calculation
-        return iterative_linear_se_solver_.value().run_state_estimation(y_bus, input, err_tol, max_iter, log);
+        return iterative_linear_se_solver_.value().run_state_estimation(y_bus, input, err_tol, max_iter, log,
+                                                                        factorization_precision);
     }
 
     SolverOutput<sym> run_state_estimation_newton_raphson(StateEstimationInput<sym> const& input, double err_tol,
-                                                          Idx max_iter, Logger& log, YBus<sym> const& y_bus) {
+                                                          Idx max_iter, Logger& log,
+                                                          FactorizationPrecision factorization_precision,
+                                                          YBus<sym> const& y_bus) {
         // construct model if needed
         if (!newton_raphson_se_solver_.has_value()) {
             Timer const timer{log, LogEvent::create_math_solver};
             newton_raphson_se_solver_.emplace(y_bus, *topo_ptr_);
+            configure_solver(newton_raphson_se_solver_);
         }
 
         // call calculation
-        return newton_raphson_se_solver_.value().run_state_estimation(y_bus, input, err_tol, max_iter, log);
+        return newton_raphson_se_solver_.value().run_state_estimation(y_bus, input, err_tol, max_iter, log,
+                                                                      factorization_precision);
     }
 };
 
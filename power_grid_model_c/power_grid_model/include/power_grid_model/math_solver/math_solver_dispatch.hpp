@@ -13,10 +13,14 @@
 #include "../common/logging.hpp"
 
 #include <memory>
+#include <span>
 #include <type_traits>
+#include <vector>
 
 namespace power_grid_model {
 
+class JobExecutor;
+
 namespace math_solver {
 
 // forward declare YBus
@@ -31,15 +35,25 @@ template <symmetry_tag sym> class MathSolverBase {
 
     virtual SolverOutput<sym> run_power_flow(PowerFlowInput<sym> const& input, double err_tol, Idx max_iter,
                                              bool cache_run, Logger& log, CalculationMethod calculation_method,
-                                             YBus<sym> const& y_bus) = 0;
+                                             PowerFlowInitialization initialization, YBus<sym> const& y_bus) = 0;
+    // power flow of several scenarios of which the y bus is the same, solved in lockstep where the method supports it
+    virtual std::vector<SolverOutput<sym>> run_power_flow_lockstep(std::span<PowerFlowInput<sym> const> inputs,
+                                                                   double err_tol, Idx max_iter, Logger& log,
+                                                                   CalculationMethod calculation_method,
+                                                                   YBus<sym> const& y_bus) = 0;
     virtual SolverOutput<sym> run_state_estimation(StateEstimationInput<sym> const& input, double err_tol, Idx max_iter,
                                                    Logger& log, CalculationMethod calculation_method,
+                                                   FactorizationPrecision factorization_precision,
                                                    YBus<sym> const& y_bus) = 0;
     virtual ShortCircuitSolverOutput<sym> run_short_circuit(ShortCircuitInput const& input, Logger& log,
                                                             CalculationMethod calculation_method,
                                                             YBus<sym> const& y_bus) = 0;
     virtual void clear_solver() = 0;
     virtual void parameters_changed(bool changed) = 0;
+    // workers for the sparse LU factorization and solve of large matrices, see SparseLUSolver::set_level_parallelism
+    virtual void set_level_parallelism(JobExecutor* executor, Idx n_thread) = 0;
+    // how matrices with branch outages are factorized, see ContingencyMode
+    virtual void set_contingency_mode(ContingencyMode contingency_mode) = 0;
 
   protected:
     MathSolverBase() = default;
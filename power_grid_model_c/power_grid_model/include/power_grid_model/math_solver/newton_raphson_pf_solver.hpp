@@ -146,6 +146,7 @@ J.L -= -dQ_cal_m/dV
 
 #include "block_matrix.hpp"
 #include "iterative_pf_solver.hpp"
+#include "sparse_lu_lockstep_solver.hpp"
 #include "sparse_lu_solver.hpp"
 #include "y_bus.hpp"
 
@@ -158,9 +159,12 @@ J.L -= -dQ_cal_m/dV
 #include "../common/three_phase_tensor.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cassert>
 #include <complex>
 #include <functional>
 #include <ranges>
+#include <span>
 #include <vector>
 
 namespace power_grid_model::math_solver {
@@ -232,6 +236,7 @@ class NewtonRaphsonPFSolver : public IterativePFSolver<sym_type, NewtonRaphsonPF
 
     using SparseSolverType = SparseLUSolver<PFJacBlock<sym>, ComplexPower<sym>, PolarPhasor<sym>>;
     using BlockPermArray = SparseLUSolver<PFJacBlock<sym>, ComplexPower<sym>, PolarPhasor<sym>>::BlockPermArray;
+    using LockstepSolverType = SparseLULockstepSolver<PFJacBlock<sym>, ComplexPower<sym>, PolarPhasor<sym>>;
 
     static constexpr auto is_iterative = true;
 
@@ -240,7 +245,7 @@ class NewtonRaphsonPFSolver : public IterativePFSolver<sym_type, NewtonRaphsonPF
           data_jac_(y_bus.nnz_lu()),
           x_(y_bus.size()),
           del_x_pq_(y_bus.size()),
-          sparse_solver_{y_bus.row_indptr_lu(), y_bus.col_indices_lu(), y_bus.lu_diag()},
+          sparse_solver_{y_bus.row_indptr_lu(), y_bus.col_indices_lu(), y_bus.lu_diag(), y_bus.lu_symbolic()},
           perm_(y_bus.size()),
           bus_control_(y_bus.size()),
           voltage_regulators_per_load_gen_{std::ref(topo.voltage_regulators_per_load_gen)},
@@ -293,12 +298,17 @@ class NewtonRaphsonPFSolver : public IterativePFSolver<sym_type, NewtonRaphsonPF
                 ComplexValue<sym>{RealValue<sym>{del_x_pq_[i].u_real()}, RealValue<sym>{del_x_pq_[i].u_imag()}};
         }
 
-        set_reference_voltage_for_pv_buses(output.u);
+        set_initial_voltage(output.u);
+    }
+
+    // set the start voltage, either the initial guess or the solution of an earlier calculation (warm start)
+    void set_initial_voltage(ComplexValueVector<sym>& u) {
+        set_reference_voltage_for_pv_buses(u);
 
         // get magnitude and angle of start voltage
         for (Idx i = 0; i != this->n_bus_; ++i) {
-            x_[i].v() = cabs(output.u[i]);
-            x_[i].theta() = arg(output.u[i]);
+            x_[i].v() = cabs(u[i]);
+            x_[i].theta() = arg(u[i]);
         }
     }
 
@@ -321,6 +331,37 @@ class NewtonRaphsonPFSolver : public IterativePFSolver<sym_type, NewtonRaphsonPF
     // Solve the linear Equations
     void solve_matrix() { sparse_solver_.prefactorize_and_solve(data_jac_, perm_, del_x_pq_, del_x_pq_); }
 
+    // Solve the linear equations of several solvers at once, a null pointer marks a solver that does not iterate
+    // A solver of which the lockstep factorization fails solves its own equations instead
+    static void solve_matrix_lockstep(LockstepSolverType& lockstep_solver,
+                                      std::span<NewtonRaphsonPFSolver* const> solvers) {
+        assert(std::ssize(solvers) <= lockstep_lanes);
+        std::array<std::vector<PFJacBlock<sym>> const*, lockstep_lanes> data_jac{};
+        std::array<std::vector<ComplexPower<sym>> const*, lockstep_lanes> del_pq{};
+        std::array<std::vector<PolarPhasor<sym>>*, lockstep_lanes> del_x{};
+        for (Idx lane = 0; lane != std::ssize(solvers); ++lane) {
+            if (solvers[lane] != nullptr) {
+                data_jac[lane] = &solvers[lane]->data_jac_;
+            }
+        }
+
+        auto const failed_lanes = lockstep_solver.prefactorize(std::span{data_jac}.first(solvers.size()));
+        for (Idx lane = 0; lane != std::ssize(solvers); ++lane) {
+            if (solvers[lane] != nullptr && !failed_lanes[lane]) {
+                del_pq[lane] = &solvers[lane]->del_x_pq_;
+                del_x[lane] = &solvers[lane]->del_x_pq_;
+            }
+        }
+        lockstep_solver.solve_with_prefactorized_matrix(std::span{del_pq}.first(solvers.size()),
+                                                        std::span{del_x}.first(solvers.size()));
+
+        for (Idx lane = 0; lane != std::ssize(solvers); ++lane) {
+            if (failed_lanes[lane]) {
+                solvers[lane]->solve_matrix();
+            }
+        }
+    }
+
     // Get maximum deviation among all bus voltages
     double iterate_unknown(ComplexValueVector<sym>& u, double err_tol, bool cache_run) {
         double max_dev = 0.0;
@@ -359,6 +400,10 @@ class NewtonRaphsonPFSolver : public IterativePFSolver<sym_type, NewtonRaphsonPF
         }
     }
 
+    void set_level_parallelism(JobExecutor* executor, Idx n_thread) {
+        sparse_solver_.set_level_parallelism(executor, n_thread);
+    }
+
   private:
     // data for jacobian
     std::vector<PFJacBlock<sym>> data_jac_;
@@ -160,11 +160,15 @@ template <symmetry_tag sym_type> class NewtonRaphsonSESolver {
           data_gain_(y_bus.nnz_lu()),
           delta_x_rhs_(y_bus.size()),
           x_(y_bus.size()),
-          sparse_solver_{y_bus.row_indptr_lu(), y_bus.col_indices_lu(), y_bus.lu_diag()},
+          sparse_solver_{y_bus.row_indptr_lu(), y_bus.col_indices_lu(), y_bus.lu_diag(), y_bus.lu_symbolic()},
           perm_(y_bus.size()) {}
 
-    SolverOutput<sym> run_state_estimation(YBus<sym> const& y_bus, StateEstimationInput<sym> const& input,
-                                           double err_tol, Idx max_iter, Logger& log) {
+    SolverOutput<sym>
+    run_state_estimation(YBus<sym> const& y_bus, StateEstimationInput<sym> const& input, double err_tol, Idx max_iter,
+                         Logger& log,
+                         FactorizationPrecision factorization_precision = FactorizationPrecision::double_precision) {
+        sparse_solver_.set_factorization_precision(factorization_precision);
+
         // prepare
         Timer main_timer;
         Timer sub_timer;
@@ -214,6 +218,10 @@ template <symmetry_tag sym_type> class NewtonRaphsonSESolver {
         return output;
     }
 
+    void set_level_parallelism(JobExecutor* executor, Idx n_thread) {
+        sparse_solver_.set_level_parallelism(executor, n_thread);
+    }
+
   private:
     Idx n_bus_;
     // shared topo data
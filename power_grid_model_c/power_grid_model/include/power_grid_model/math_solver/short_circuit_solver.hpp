@@ -30,16 +30,12 @@ namespace short_circuit {
 
 // solver
 template <symmetry_tag sym> class ShortCircuitSolver {
-    using BlockPermArray = SparseLUSolver<ComplexTensor<sym>, ComplexValue<sym>, ComplexValue<sym>>::BlockPermArray;
-
   public:
     ShortCircuitSolver(YBus<sym> const& y_bus, MathModelTopology const& topo)
         : n_bus_{y_bus.size()},
           n_source_{topo.n_source()},
           sources_per_bus_{std::cref(topo.sources_per_bus)},
-          mat_data_(y_bus.nnz_lu()),
-          sparse_solver_{y_bus.row_indptr_lu(), y_bus.col_indices_lu(), y_bus.lu_diag()},
-          perm_{static_cast<BlockPermArray>(n_bus_)} {}
+          factorization_{y_bus} {}
 
     ShortCircuitSolverOutput<sym> run_short_circuit(YBus<sym> const& y_bus, ShortCircuitInput const& input) {
         check_input_valid(input);
@@ -57,12 +53,34 @@ template <symmetry_tag sym> class ShortCircuitSolver {
 
         IdxVector infinite_admittance_fault_counter(n_bus_);
 
-        detail::copy_y_bus<sym>(y_bus, mat_data_);
+        // the matrix only changes with the parameters and the faults, so the factorization is reused as long as the
+        // faults do not change, e.g. for batches that only change the source voltages
+        FaultsKey faults_key{.fault_type = fault_type, .fault_phase = fault_phase, .bus_y_fault = {}};
+        for (auto const& [bus_number, faults] : enumerated_zip_sequence(input.fault_buses)) {
+            for (Idx const fault_number : faults) {
+                faults_key.bus_y_fault.emplace_back(bus_number, input.faults[fault_number].y_fault);
+            }
+        }
+        bool const reuse_factorization = !parameters_changed_ && faults_key == factorized_faults_;
 
-        prepare_matrix_and_rhs(y_bus, input, output, infinite_admittance_fault_counter, fault_type, phase_1, phase_2);
+        // the right-hand side is assembled together with the matrix
+        // if the factorization is reused, the matrix is assembled in a scratch buffer to keep the prefactorized one
+        ComplexTensorVector<sym>& mat_data = reuse_factorization ? scratch_mat_data_ : factorization_.matrix();
+        mat_data.resize(y_bus.nnz_lu());
+        detail::copy_y_bus<sym>(y_bus, mat_data);
+
+        prepare_matrix_and_rhs(y_bus, input, output, mat_data, infinite_admittance_fault_counter, fault_type, phase_1,
+                               phase_2);
 
         // solve matrix
-        sparse_solver_.prefactorize_and_solve(mat_data_, perm_, output.u_bus, output.u_bus);
+        if (!reuse_factorization) {
+            // in case the factorization fails, the next calculation factorizes again
+            parameters_changed_ = true;
+            factorization_.factorize();
+            factorized_faults_ = std::move(faults_key);
+            parameters_changed_ = false;
+        }
+        factorization_.solve(output.u_bus, output.u_bus);
 
         // post processing
         calculate_result(y_bus, input, output, infinite_admittance_fault_counter, fault_type, phase_1, phase_2);
@@ -70,37 +88,61 @@ template <symmetry_tag sym> class ShortCircuitSolver {
         return output;
     }
 
+    void parameters_changed(bool changed) { parameters_changed_ = parameters_changed_ || changed; }
+
+    void set_contingency_mode(ContingencyMode contingency_mode) {
+        parameters_changed(factorization_.set_contingency_mode(contingency_mode));
+    }
+
+    void set_level_parallelism(JobExecutor* executor, Idx n_thread) {
+        factorization_.set_level_parallelism(executor, n_thread);
+    }
+
+    Idx low_rank_update_size() const { return factorization_.low_rank_update_size(); }
+    Idx n_factorization() const { return factorization_.n_factorization(); }
+
   private:
+    // the faults of a matrix: the fault type and phase, and the bus and admittance of each fault
+    struct FaultsKey {
+        FaultType fault_type{FaultType::nan};
+        FaultPhase fault_phase{FaultPhase::nan};
+        std::vector<std::pair<Idx, DoubleComplex>> bus_y_fault;
+
+        bool operator==(FaultsKey const&) const = default;
+    };
+
     Idx n_bus_;
     Idx n_source_;
     // shared topo data
     std::reference_wrapper<DenseGroupedIdxVector const> sources_per_bus_;
-    // sparse linear equation
-    ComplexTensorVector<sym> mat_data_;
-    // sparse solver
-    SparseLUSolver<ComplexTensor<sym>, ComplexValue<sym>, ComplexValue<sym>> sparse_solver_;
-    BlockPermArray perm_;
+    // matrix of a calculation that reuses the factorization
+    ComplexTensorVector<sym> scratch_mat_data_;
+    // sparse linear equation and its factorization, possibly with a low-rank update
+    detail::LowRankUpdatedFactorization<sym> factorization_;
+    FaultsKey factorized_faults_;
+    bool parameters_changed_ = true;
 
     void prepare_matrix_and_rhs(YBus<sym> const& y_bus, ShortCircuitInput const& input,
-                                ShortCircuitSolverOutput<sym>& output, IdxVector& infinite_admittance_fault_counter,
-                                FaultType const& fault_type, IntS phase_1, IntS phase_2) {
+                                ShortCircuitSolverOutput<sym>& output, ComplexTensorVector<sym>& mat_data,
+                                IdxVector& infinite_admittance_fault_counter, FaultType const& fault_type,
+                                IntS phase_1, IntS phase_2) {
         IdxVector const& bus_entry = y_bus.lu_diag();
 
         auto const& sources_per_bus = sources_per_bus_.get();
         for (auto const& [bus_number, sources, faults] : enumerated_zip_sequence(sources_per_bus, input.fault_buses)) {
             Idx const diagonal_position = bus_entry[bus_number];
-            auto& diagonal_element = mat_data_[diagonal_position];
+            auto& diagonal_element = mat_data[diagonal_position];
             auto& u_bus = output.u_bus[bus_number];
 
             detail::add_sources<sym>(sources, bus_number, y_bus, input.source, diagonal_element, u_bus);
 
-            add_faults(faults, bus_number, y_bus, input, diagonal_element, u_bus, infinite_admittance_fault_counter,
-                       fault_type, phase_1, phase_2);
+            add_faults(faults, bus_number, y_bus, input, mat_data, diagonal_element, u_bus,
+                       infinite_admittance_fault_counter, fault_type, phase_1, phase_2);
         }
     }
 
     void add_faults(IdxRange const& faults, Idx bus_number, YBus<sym> const& y_bus, ShortCircuitInput const& input,
-                    ComplexTensor<sym>& diagonal_element, ComplexValue<sym>& u_bus,
+                    ComplexTensorVector<sym>& mat_data, ComplexTensor<sym>& diagonal_element, ComplexValue<sym>& u_bus,
                     IdxVector& infinite_admittance_fault_counter, FaultType const& fault_type, IntS phase_1,
                     IntS phase_2) {
         for (Idx const fault_number : faults) {
@@ -108,20 +150,20 @@ template <symmetry_tag sym> class ShortCircuitSolver {
             if (std::isinf(y_fault.real())) {
                 assert(std::isinf(y_fault.imag()));
                 infinite_admittance_fault_counter[bus_number] += 1;
-                add_fault_with_infinite_impedance(bus_number, y_bus, diagonal_element, u_bus, fault_type, phase_1,
-                                                  phase_2);
+                add_fault_with_infinite_impedance(bus_number, y_bus, mat_data, diagonal_element, u_bus, fault_type,
+                                                  phase_1, phase_2);
                 // If there is a fault with infinite admittance, there is no need to add other faults to that
                 // bus
                 break;
             }
             assert(!std::isinf(y_fault.imag()));
-            add_fault(y_fault, bus_number, y_bus, diagonal_element, u_bus, fault_type, phase_1, phase_2);
+            add_fault(y_fault, bus_number, y_bus, mat_data, diagonal_element, u_bus, fault_type, phase_1, phase_2);
         }
     }
 
-    void add_fault_with_infinite_impedance(Idx bus_number, YBus<sym> const& y_bus, ComplexTensor<sym>& diagonal_element,
-                                           ComplexValue<sym>& u_bus, FaultType const& fault_type, IntS phase_1,
-                                           IntS phase_2) {
+    void add_fault_with_infinite_impedance(Idx bus_number, YBus<sym> const& y_bus, ComplexTensorVector<sym>& mat_data,
+                                           ComplexTensor<sym>& diagonal_element, ComplexValue<sym>& u_bus,
+                                           FaultType const& fault_type, IntS phase_1, IntS phase_2) {
         using enum FaultType;
 
         if (fault_type == three_phase) { // three phase fault
@@ -129,7 +171,7 @@ template <symmetry_tag sym> class ShortCircuitSolver {
                  data_index != y_bus.row_indptr_lu()[bus_number + 1]; ++data_index) {
                 Idx const col_data_index = y_bus.lu_transpose_entry()[data_index];
                 // mat_data[:,bus] = 0
-                mat_data_[col_data_index] = ComplexTensor<sym>{0};
+                mat_data[col_data_index] = ComplexTensor<sym>{0};
             }
             // mat_data[bus,bus] = -1
             diagonal_element = ComplexTensor<sym>{-1};
@@ -141,7 +183,7 @@ template <symmetry_tag sym> class ShortCircuitSolver {
                      data_index != y_bus.row_indptr_lu()[bus_number + 1]; ++data_index) {
                     Idx const col_data_index = y_bus.lu_transpose_entry()[data_index];
                     // mat_data[:,bus][:, phase_1] = 0
-                    mat_data_[col_data_index].col(phase_1) = 0;
+                    mat_data[col_data_index].col(phase_1) = 0;
                 }
                 // mat_data[bus,bus][phase_1, phase_1] = -1
                 diagonal_element(phase_1, phase_1) = -1;
@@ -152,8 +194,8 @@ template <symmetry_tag sym> class ShortCircuitSolver {
                     Idx const col_data_index = y_bus.lu_transpose_entry()[data_index];
                     // mat_data[:,bus][:, phase_1] += mat_data[:,bus][:, phase_2]
                     // mat_data[:,bus][:, phase_2] = 0
-                    mat_data_[col_data_index].col(phase_1) += mat_data_[col_data_index].col(phase_2);
-                    mat_data_[col_data_index].col(phase_2) = 0;
+                    mat_data[col_data_index].col(phase_1) += mat_data[col_data_index].col(phase_2);
+                    mat_data[col_data_index].col(phase_2) = 0;
                 }
                 // mat_data[bus,bus][phase_1, phase_2] = -1
                 // mat_data[bus,bus][phase_2, phase_2] = 1
@@ -168,8 +210,8 @@ template <symmetry_tag sym> class ShortCircuitSolver {
                     Idx const col_data_index = y_bus.lu_transpose_entry()[data_index];
                     // mat_data[:,bus][:, phase_1] = 0
                     // mat_data[:,bus][:, phase_2] = 0
-                    mat_data_[col_data_index].col(phase_1) = 0;
-                    mat_data_[col_data_index].col(phase_2) = 0;
+                    mat_data[col_data_index].col(phase_1) = 0;
+                    mat_data[col_data_index].col(phase_2) = 0;
                 }
                 // mat_data[bus,bus][phase_1, phase_1] = -1
                 // mat_data[bus,bus][phase_2, phase_2] = -1
@@ -185,8 +227,8 @@ template <symmetry_tag sym> class ShortCircuitSolver {
     }
 
     void add_fault(DoubleComplex const& y_fault, Idx bus_number, YBus<sym> const& y_bus,
-                   ComplexTensor<sym>& diagonal_element, ComplexValue<sym>& u_bus, FaultType const& fault_type,
-                   IntS phase_1, IntS phase_2) {
+                   ComplexTensorVector<sym>& mat_data, ComplexTensor<sym>& diagonal_element, ComplexValue<sym>& u_bus,
+                   FaultType const& fault_type, IntS phase_1, IntS phase_2) {
         using enum FaultType;
 
         if (fault_type == three_phase) { // three phase fault
@@ -212,8 +254,8 @@ template <symmetry_tag sym> class ShortCircuitSolver {
                     Idx const col_data_index = y_bus.lu_transpose_entry()[data_index];
                     // mat_data[:,bus][:, phase_1] += mat_data[:,bus][:, phase_2]
                     // mat_data[:,bus][:, phase_2] = 0
-                    mat_data_[col_data_index].col(phase_1) += mat_data_[col_data_index].col(phase_2);
-                    mat_data_[col_data_index].col(phase_2) = 0;
+                    mat_data[col_data_index].col(phase_1) += mat_data[col_data_index].col(phase_2);
+                    mat_data[col_data_index].col(phase_2) = 0;
                 }
                 // mat_data[bus,bus][phase_1, phase_2] = -1
                 // mat_data[bus,bus][phase_2, phase_1] += y_fault
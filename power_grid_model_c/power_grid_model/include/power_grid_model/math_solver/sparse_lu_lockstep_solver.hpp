@@ -0,0 +1,302 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+
+/*
+Lockstep sparse LU factorization and solve of several matrices with the same sparsity pattern
+
+The values of the matrices are interleaved per entry: lane l of an entry holds the value of the matrix l. Every step of
+the factorization and the substitution is done for all lanes at once, so the operations vectorize over the lanes and
+the pattern (indices, symbolic factorization) is only traversed once for all matrices.
+
+To keep all lanes in the same instruction stream, the blocks are factorized without pivoting. A lane fails if one of
+its pivots is not normal, or too small compared to the other values in its column of the block. The caller solves the
+failed lanes with the SparseLUSolver instead, which pivots inside the blocks.
+*/
+
+#include "sparse_lu_solver.hpp"
+
+#include "../common/common.hpp"
+
+#include <Eigen/Core>
+
+#include <bitset>
+#include <cassert>
+#include <concepts>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace power_grid_model::math_solver {
+
+// default number of lanes, e.g. four doubles fill an AVX2 register
+constexpr Idx lockstep_lanes = 4;
+
+template <class Tensor, class RHSVector, class XVector, Idx n_lanes = lockstep_lanes> class SparseLULockstepSolver {
+  public:
+    using entry_trait = sparse_lu_entry_trait<Tensor, RHSVector, XVector>;
+    static constexpr bool is_block = entry_trait::is_block;
+    static constexpr Idx block_size = entry_trait::block_size;
+    using Scalar = entry_trait::Scalar;
+    using LaneMask = std::bitset<n_lanes>;
+
+    // relative size of a pivot to the largest value in its column of the block, below which the factorization without
+    // pivoting is considered unstable, like the threshold of threshold partial pivoting
+    static constexpr double pivot_tolerance = 0.1;
+
+    SparseLULockstepSolver(std::span<Idx const> row_indptr,  // indptr including fill-ins
+                           std::span<Idx const> col_indices, // indices including fill-ins
+                           std::span<Idx const> diag_lu, std::shared_ptr<SparseLUSymbolic const> symbolic)
+        : size_{static_cast<Idx>(row_indptr.size()) - 1},
+          nnz_{row_indptr.back()},
+          row_indptr_{row_indptr},
+          col_indices_{col_indices},
+          diag_lu_{diag_lu},
+          symbolic_{std::move(symbolic)},
+          lu_matrix_(nnz_) {
+        assert(symbolic_ != nullptr);
+        assert(std::ssize(symbolic_->transpose_entry) == nnz_);
+    }
+
+    // factorize the matrices data[lane], all in the pattern of the solver, into the lanes of the solver
+    // a null pointer marks an unused lane, e.g. of a calculation that has already converged
+    // returns the lanes of which the factorization failed
+    LaneMask prefactorize(std::span<std::vector<Tensor> const* const> data) {
+        assert(std::ssize(data) <= n_lanes);
+        gather_matrix(data);
+        failed_ = LaneBool::Constant(false);
+
+        auto const& transpose_entry = symbolic_->transpose_entry;
+        auto const& schur_u_end = symbolic_->schur_u_end;
+        auto const& schur_update_entry = symbolic_->schur_update_entry;
+        auto const& supernodes = symbolic_->supernodes;
+
+        // same order of the Schur-complement updates as the sequential factorization of the SparseLUSolver
+        Idx schur_update_idx = 0;
+        auto next_supernode = supernodes.cbegin();
+        for (Idx pivot_row_col = 0; pivot_row_col != size_; ++pivot_row_col) {
+            factorize_pivot(pivot_row_col);
+            Idx const pivot_idx = diag_lu_[pivot_row_col];
+
+            // A_k,j = A_k,j - L_k,pivot * U_pivot,j    k, j > pivot
+            for (Idx l_ref_idx = pivot_idx + 1; l_ref_idx < row_indptr_[pivot_row_col + 1]; ++l_ref_idx) {
+                LaneTensor const& l = lu_matrix_[transpose_entry[l_ref_idx]];
+                for (Idx u_idx = pivot_idx + 1; u_idx < schur_u_end[l_ref_idx]; ++u_idx) {
+                    subtract_product(lu_matrix_[schur_update_entry[schur_update_idx++]], l, lu_matrix_[u_idx]);
+                }
+            }
+
+            // the trailing block of a supernode is updated by all its pivots after the last one
+            if (next_supernode != supernodes.cend() && next_supernode->last == pivot_row_col) {
+                update_supernode_trailing_block(*next_supernode);
+                ++next_supernode;
+            }
+        }
+        assert(schur_update_idx == std::ssize(schur_update_entry));
+        assert(next_supernode == supernodes.cend());
+
+        LaneMask failed_lanes;
+        for (Idx lane = 0; lane != std::ssize(data); ++lane) {
+            failed_lanes[lane] = data[lane] != nullptr && failed_(lane);
+        }
+        return failed_lanes;
+    }
+
+    // solve rhs[lane] into x[lane] with the factorization of the lane, rhs and x can be the same vector
+    // a null pointer marks an unused lane. The solution of a failed lane is not defined.
+    void solve_with_prefactorized_matrix(std::span<std::vector<RHSVector> const* const> rhs,
+                                         std::span<std::vector<XVector>* const> x) const {
+        assert(rhs.size() == x.size());
+        assert(std::ssize(rhs) <= n_lanes);
+
+        std::vector<LaneVector> work(size_, LaneVector::Zero());
+        for (Idx lane = 0; lane != std::ssize(rhs); ++lane) {
+            if (rhs[lane] != nullptr) {
+                for (Idx row = 0; row != size_; ++row) {
+                    set_lane(work[row], lane, (*rhs[lane])[row]);
+                }
+            }
+        }
+
+        // forward substitution with L
+        for (Idx row = 0; row != size_; ++row) {
+            for (Idx l_idx = row_indptr_[row]; l_idx < diag_lu_[row]; ++l_idx) {
+                subtract_product(work[row], lu_matrix_[l_idx], work[col_indices_[l_idx]]);
+            }
+            // unit lower part of the pivot
+            LaneTensor const& pivot = lu_matrix_[diag_lu_[row]];
+            for (Idx i = 1; i < block_size; ++i) {
+                for (Idx k = 0; k != i; ++k) {
+                    work[row].col(i) -= pivot.col(i * block_size + k) * work[row].col(k);
+                }
+            }
+        }
+
+        // backward substitution with U
+        for (Idx row = size_ - 1; row != -1; --row) {
+            for (Idx u_idx = diag_lu_[row] + 1; u_idx < row_indptr_[row + 1]; ++u_idx) {
+                subtract_product(work[row], lu_matrix_[u_idx], work[col_indices_[u_idx]]);
+            }
+            // upper part of the pivot
+            LaneTensor const& pivot = lu_matrix_[diag_lu_[row]];
+            for (Idx i = block_size - 1; i != -1; --i) {
+                for (Idx k = i + 1; k < block_size; ++k) {
+                    work[row].col(i) -= pivot.col(i * block_size + k) * work[row].col(k);
+                }
+                work[row].col(i) /= pivot.col(i * block_size + i);
+            }
+        }
+
+        for (Idx lane = 0; lane != std::ssize(x); ++lane) {
+            if (x[lane] != nullptr) {
+                for (Idx row = 0; row != size_; ++row) {
+                    get_lane(work[row], lane, (*x[lane])[row]);
+                }
+            }
+        }
+    }
+
+  private:
+    // values of an entry for all lanes, column i * block_size + j holds the element (i, j) of the blocks
+    using LaneTensor = Eigen::Array<Scalar, n_lanes, block_size * block_size>;
+    // values of a vector entry for all lanes, column i holds the element i of the blocks
+    using LaneVector = Eigen::Array<Scalar, n_lanes, block_size>;
+    using LaneBool = Eigen::Array<bool, n_lanes, 1>;
+
+    Idx size_;
+    Idx nnz_;
+    std::span<Idx const> row_indptr_;
+    std::span<Idx const> col_indices_;
+    std::span<Idx const> diag_lu_;
+    std::shared_ptr<SparseLUSymbolic const> symbolic_;
+    std::vector<LaneTensor> lu_matrix_;
+    LaneBool failed_{LaneBool::Constant(false)};
+
+    // the unused lanes get the identity matrix, so that they can not fail
+    void gather_matrix(std::span<std::vector<Tensor> const* const> data) {
+        for (auto& entry : lu_matrix_) {
+            entry.setZero();
+        }
+        for (Idx lane = 0; lane != n_lanes; ++lane) {
+            if (lane < std::ssize(data) && data[lane] != nullptr) {
+                assert(std::ssize(*data[lane]) == nnz_);
+                for (Idx idx = 0; idx != nnz_; ++idx) {
+                    set_lane(lu_matrix_[idx], lane, (*data[lane])[idx]);
+                }
+            } else {
+                for (Idx const diag_idx : diag_lu_) {
+                    for (Idx i = 0; i != block_size; ++i) {
+                        lu_matrix_[diag_idx](lane, i * block_size + i) = Scalar{1.0};
+                    }
+                }
+            }
+        }
+    }
+
+    template <class Value> static void set_lane(auto& lane_value, Idx lane, Value const& value) {
+        if constexpr (is_block) {
+            for (Idx i = 0; i != block_size; ++i) {
+                if constexpr (Value::ColsAtCompileTime == 1) {
+                    lane_value(lane, i) = value(i);
+                } else {
+                    for (Idx j = 0; j != block_size; ++j) {
+                        lane_value(lane, i * block_size + j) = value(i, j);
+                    }
+                }
+            }
+        } else {
+            lane_value(lane, 0) = value;
+        }
+    }
+
+    template <class Value> static void get_lane(LaneVector const& lane_value, Idx lane, Value& value) {
+        if constexpr (is_block) {
+            for (Idx i = 0; i != block_size; ++i) {
+                value(i) = lane_value(lane, i);
+            }
+        } else {
+            value = lane_value(lane, 0);
+        }
+    }
+
+    // a -= l * u, per lane, for a block or a vector a
+    template <class LaneValue> static void subtract_product(LaneValue& a, LaneTensor const& l, LaneValue const& u) {
+        constexpr Idx n_cols = std::same_as<LaneValue, LaneVector> ? 1 : block_size;
+        for (Idx i = 0; i != block_size; ++i) {
+            for (Idx j = 0; j != n_cols; ++j) {
+                for (Idx k = 0; k != block_size; ++k) {
+                    a.col(i * n_cols + j) -= l.col(i * block_size + k) * u.col(k * n_cols + j);
+                }
+            }
+        }
+    }
+
+    // factorize the pivot block without pivoting and calculate the row of U right of it and the column of L below it
+    void factorize_pivot(Idx pivot_row_col) {
+        Idx const pivot_idx = diag_lu_[pivot_row_col];
+        LaneTensor& pivot = lu_matrix_[pivot_idx];
+
+        // dense LU factorization of the block, A_pivot,pivot = L_pivot * U_pivot
+        for (Idx k = 0; k != block_size; ++k) {
+            auto const abs_pivot = pivot.col(k * block_size + k).abs().eval();
+            auto column_max = abs_pivot;
+            for (Idx i = k + 1; i < block_size; ++i) {
+                column_max = column_max.max(pivot.col(i * block_size + k).abs());
+            }
+            // also fails on NaN
+            failed_ = failed_ ||
+                      !((abs_pivot >= pivot_tolerance * column_max) && (abs_pivot > 0.0) && abs_pivot.isFinite());
+
+            for (Idx i = k + 1; i < block_size; ++i) {
+                pivot.col(i * block_size + k) /= pivot.col(k * block_size + k);
+                for (Idx j = k + 1; j < block_size; ++j) {
+                    pivot.col(i * block_size + j) -= pivot.col(i * block_size + k) * pivot.col(k * block_size + j);
+                }
+            }
+        }
+
+        for (Idx ref_idx = pivot_idx + 1; ref_idx < row_indptr_[pivot_row_col + 1]; ++ref_idx) {
+            // L_pivot * U_pivot,k = A_pivot,k    k > pivot
+            LaneTensor& u = lu_matrix_[ref_idx];
+            for (Idx j = 0; j != block_size; ++j) {
+                for (Idx i = 1; i < block_size; ++i) {
+                    for (Idx k = 0; k != i; ++k) {
+                        u.col(i * block_size + j) -= pivot.col(i * block_size + k) * u.col(k * block_size + j);
+                    }
+                }
+            }
+
+            // L_k,pivot * U_pivot = A_k,pivot    k > pivot
+            LaneTensor& l = lu_matrix_[symbolic_->transpose_entry[ref_idx]];
+            for (Idx i = 0; i != block_size; ++i) {
+                for (Idx j = 0; j != block_size; ++j) {
+                    for (Idx k = 0; k != j; ++k) {
+                        l.col(i * block_size + j) -= l.col(i * block_size + k) * pivot.col(k * block_size + j);
+                    }
+                    l.col(i * block_size + j) /= pivot.col(j * block_size + j);
+                }
+            }
+        }
+    }
+
+    // A(R, R) -= L(R, supernode) * U(supernode, R)
+    void update_supernode_trailing_block(SparseLUSymbolic::Supernode const& supernode) {
+        Idx const n_trailing = supernode.n_trailing;
+        for (Idx pivot_row_col = supernode.first; pivot_row_col <= supernode.last; ++pivot_row_col) {
+            // the trailing columns are the last entries of each pivot row
+            Idx const u_begin = row_indptr_[pivot_row_col + 1] - n_trailing;
+            for (Idx row = 0; row != n_trailing; ++row) {
+                LaneTensor const& l = lu_matrix_[symbolic_->transpose_entry[u_begin + row]];
+                for (Idx col = 0; col != n_trailing; ++col) {
+                    subtract_product(lu_matrix_[supernode.trailing_entry[row * n_trailing + col]], l,
+                                     lu_matrix_[u_begin + col]);
+                }
+            }
+        }
+    }
+};
+
+} // namespace power_grid_model::math_solver
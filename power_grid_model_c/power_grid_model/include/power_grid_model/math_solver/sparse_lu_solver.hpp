@@ -6,19 +6,28 @@
 
 #include "../common/common.hpp"
 #include "../common/counting_iterator.hpp"
+#include "../common/enum.hpp"
 #include "../common/exception.hpp"
 #include "../common/three_phase_tensor.hpp"
 #include "../common/typing.hpp"
+#include "../job_executor.hpp"
 
 #include <Eigen/Core>
+#include <Eigen/LU>
 
 #include <algorithm>
+#include <atomic>
+#include <barrier>
 #include <cassert>
 #include <cmath>
+#include <complex>
 #include <concepts>
 #include <cstdint>
+#include <exception>
 #include <iterator>
 #include <limits>
+#include <memory>
+#include <numeric>
 #include <optional>
 #include <span>
 #include <type_traits>
@@ -32,16 +41,31 @@ constexpr double epsilon_perturbation = 1e-13;      // perturbation threshold
 constexpr double cap_back_error_denominator = 1e-4; // denominator for cap back error
 constexpr double epsilon_sqrt = 1.49011745e-8;      // sqrt(epsilon), sqrt does not have constexpr
 
+// the factorization can also be done in single precision, see FactorizationPrecision::mixed_precision
+template <typename T>
+concept lu_scalar_value = scalar_value<T> || std::same_as<T, float> || std::same_as<T, std::complex<float>>;
+
+template <lu_scalar_value Scalar> struct low_precision_scalar {
+    using type = float;
+};
+template <lu_scalar_value Scalar>
+    requires std::same_as<Scalar, std::complex<typename Scalar::value_type>>
+struct low_precision_scalar<Scalar> {
+    using type = std::complex<float>;
+};
+template <lu_scalar_value Scalar> using low_precision_scalar_t = typename low_precision_scalar<Scalar>::type;
+
 // perturb pivot if needed
 // pass the value and abs_value by reference
 // it will get modified if perturbation happens
 // also has_pivot_perturbation will be updated if perturbation happens
-template <scalar_value Scalar>
+template <lu_scalar_value Scalar>
 inline void perturb_pivot_if_needed(double perturb_threshold, Scalar& value, double& abs_value,
                                     bool& has_pivot_perturbation) {
+    using RealScalar = Eigen::NumTraits<Scalar>::Real;
     if (abs_value < perturb_threshold) {
-        Scalar const scale = (abs_value == 0.0) ? Scalar{1.0} : (value / abs_value);
-        value = scale * perturb_threshold;
+        Scalar const scale = (abs_value == 0.0) ? Scalar{1.0} : (value / static_cast<RealScalar>(abs_value));
+        value = scale * static_cast<RealScalar>(perturb_threshold);
         has_pivot_perturbation = true;
         abs_value = perturb_threshold;
     }
@@ -67,6 +91,7 @@ enum class TriangularFactor : int8_t { lower, upper };
 template <rk2_tensor Matrix> class DenseLUFactor {
   public:
     using Scalar = Matrix::Scalar;
+    using RealScalar = Eigen::NumTraits<Scalar>::Real;
     static constexpr Idx n_rows = Matrix::RowsAtCompileTime;
     static constexpr Idx n_cols = Matrix::ColsAtCompileTime;
     static_assert(std::in_range<int8_t>(n_rows));
@@ -89,60 +114,20 @@ template <rk2_tensor Matrix> class DenseLUFactor {
         requires(std::same_as<typename Derived::Scalar, Scalar> && rk2_tensor<Derived> &&
                  (Derived::RowsAtCompileTime == size) && (Derived::ColsAtCompileTime == size))
     {
-        TranspositionVector row_transpositions{};
-        TranspositionVector col_transpositions{};
-        double max_pivot{};
-
-        // main loop
-        for (int8_t pivot = 0; pivot != size; ++pivot) {
-            int row_biggest_eigen{};
-            int col_biggest_eigen{};
-            // find biggest score in the bottom right corner
-            double const biggest_score = matrix.bottomRightCorner(size - pivot, size - pivot)
-                                             .cwiseAbs2()
-                                             .maxCoeff(&row_biggest_eigen, &col_biggest_eigen);
-            // offset with pivot
-            auto const row_biggest = static_cast<int8_t>(row_biggest_eigen + pivot);
-            auto const col_biggest = static_cast<int8_t>(col_biggest_eigen + pivot);
-            assert(row_biggest_eigen + pivot < size);
-            assert(col_biggest_eigen + pivot < size);
-
-            // check absolute singular matrix
-            if (biggest_score == 0.0 && !use_pivot_perturbation) {
-                // pivot perturbation not possible, cannot proceed
-                // set identity permutation and break the loop
-                for (int8_t remaining_rows_cols = pivot; remaining_rows_cols != size; ++remaining_rows_cols) {
-                    row_transpositions[remaining_rows_cols] = remaining_rows_cols;
-                    col_transpositions[remaining_rows_cols] = remaining_rows_cols;
-                }
-                break;
-            }
+        EliminationState state{.perturb_threshold = perturb_threshold,
+                               .use_pivot_perturbation = use_pivot_perturbation,
+                               .has_pivot_perturbation = has_pivot_perturbation};
 
-            // perturb pivot if needed
-            double abs_pivot = sqrt(biggest_score);
-            perturb_pivot_if_needed(perturb_threshold, matrix(row_biggest, col_biggest), abs_pivot,
-                                    has_pivot_perturbation);
-            max_pivot = std::max(max_pivot, abs_pivot);
+        // main loop, unrolled at compile time so that all block operations have a fixed size, which lets Eigen
+        // vectorize them for the instruction set the library is compiled for
+        // the loop stops at an exactly singular remaining block that can not be perturbed
+        [&matrix, &state]<int8_t... pivots>(std::integer_sequence<int8_t, pivots...> /* pivots */) {
+            static_cast<void>((eliminate_pivot<pivots>(matrix, state) && ...));
+        }(std::make_integer_sequence<int8_t, size>{});
 
-            // swap rows and columns
-            row_transpositions[pivot] = row_biggest;
-            col_transpositions[pivot] = col_biggest;
-            if (pivot != row_biggest) {
-                matrix.row(pivot).swap(matrix.row(row_biggest));
-            }
-            if (pivot != col_biggest) {
-                matrix.col(pivot).swap(matrix.col(col_biggest));
-            }
-
-            // use Gaussian elimination to calculate the bottom right corner
-            if (pivot < size - 1) {
-                // calculate the pivot column
-                matrix.col(pivot).tail(size - pivot - 1) /= matrix(pivot, pivot);
-                // calculate the bottom right corner
-                matrix.bottomRightCorner(size - pivot - 1, size - pivot - 1).noalias() -=
-                    matrix.col(pivot).tail(size - pivot - 1) * matrix.row(pivot).tail(size - pivot - 1);
-            }
-        }
+        TranspositionVector const& row_transpositions = state.row_transpositions;
+        TranspositionVector const& col_transpositions = state.col_transpositions;
+        double const max_pivot = state.max_pivot;
 
         // accumulate the permutation
         block_perm.p.setIdentity();
@@ -156,7 +141,8 @@ template <rk2_tensor Matrix> class DenseLUFactor {
 
         // throw SparseMatrixError if the matrix is ill-conditioned
         // only check condition number if pivot perturbation is not used
-        double const pivot_threshold = has_pivot_perturbation ? 0.0 : epsilon * max_pivot;
+        double const pivot_threshold =
+            has_pivot_perturbation ? 0.0 : std::numeric_limits<RealScalar>::epsilon() * max_pivot;
         for (int8_t pivot = 0; pivot != size; ++pivot) {
             if (cabs(matrix(pivot, pivot)) < pivot_threshold || !is_normal(matrix(pivot, pivot))) {
                 throw SparseMatrixError{}; // can not specify error code
@@ -225,12 +211,77 @@ template <rk2_tensor Matrix> class DenseLUFactor {
         // its local Identity() RHS, not on lu_matrix.
         return block_perm.q * inverse_factorized_block(lu_matrix) * block_perm.p;
     }
+
+  private:
+    struct EliminationState {
+        double perturb_threshold{};
+        bool use_pivot_perturbation{};
+        bool& has_pivot_perturbation;
+        double max_pivot{};
+        TranspositionVector row_transpositions{};
+        TranspositionVector col_transpositions{};
+    };
+
+    // one step of the Gaussian elimination with full pivoting
+    // returns false if the remaining block is exactly zero and can not be perturbed
+    template <int8_t pivot, class Derived>
+    static bool eliminate_pivot(Eigen::MatrixBase<Derived>& matrix, EliminationState& state) {
+        constexpr int8_t remaining = size - pivot;
+
+        int row_biggest_eigen{};
+        int col_biggest_eigen{};
+        // find biggest score in the bottom right corner
+        double const biggest_score = matrix.template bottomRightCorner<remaining, remaining>().cwiseAbs2().maxCoeff(
+            &row_biggest_eigen, &col_biggest_eigen);
+        // offset with pivot
+        auto const row_biggest = static_cast<int8_t>(row_biggest_eigen + pivot);
+        auto const col_biggest = static_cast<int8_t>(col_biggest_eigen + pivot);
+        assert(row_biggest_eigen + pivot < size);
+        assert(col_biggest_eigen + pivot < size);
+
+        // check absolute singular matrix
+        if (biggest_score == 0.0 && !state.use_pivot_perturbation) {
+            // pivot perturbation not possible, cannot proceed
+            // set identity permutation and break the loop
+            for (int8_t remaining_rows_cols = pivot; remaining_rows_cols != size; ++remaining_rows_cols) {
+                state.row_transpositions[remaining_rows_cols] = remaining_rows_cols;
+                state.col_transpositions[remaining_rows_cols] = remaining_rows_cols;
+            }
+            return false;
+        }
+
+        // perturb pivot if needed
+        double abs_pivot = sqrt(biggest_score);
+        perturb_pivot_if_needed(state.perturb_threshold, matrix(row_biggest, col_biggest), abs_pivot,
+                                state.has_pivot_perturbation);
+        state.max_pivot = std::max(state.max_pivot, abs_pivot);
+
+        // swap rows and columns
+        state.row_transpositions[pivot] = row_biggest;
+        state.col_transpositions[pivot] = col_biggest;
+        if (pivot != row_biggest) {
+            matrix.row(pivot).swap(matrix.row(row_biggest));
+        }
+        if (pivot != col_biggest) {
+            matrix.col(pivot).swap(matrix.col(col_biggest));
+        }
+
+        // use Gaussian elimination to calculate the bottom right corner
+        if constexpr (remaining > 1) {
+            // calculate the pivot column
+            matrix.col(pivot).template tail<remaining - 1>() /= matrix(pivot, pivot);
+            // calculate the bottom right corner
+            matrix.template bottomRightCorner<remaining - 1, remaining - 1>().noalias() -=
+                matrix.col(pivot).template tail<remaining - 1>() * matrix.row(pivot).template tail<remaining - 1>();
+        }
+        return true;
+    }
 };
 
 template <class Tensor, class RHSVector, class XVector> struct sparse_lu_entry_trait;
 
 template <class Tensor, class RHSVector, class XVector>
-concept scalar_value_lu = scalar_value<Tensor> && std::same_as<Tensor, RHSVector> && std::same_as<Tensor, XVector>;
+concept scalar_value_lu = lu_scalar_value<Tensor> && std::same_as<Tensor, RHSVector> && std::same_as<Tensor, XVector>;
 
 // TODO(mgovers) improve this concept
 template <class Derived> int check_array_base(Eigen::ArrayBase<Derived> const& /* array_base */) { return 0; }
@@ -248,7 +299,7 @@ concept tensor_lu =
     matrix_multiplicable<Tensor, RHSVector> && matrix_multiplicable<Tensor, XVector> &&
     std::same_as<typename Tensor::Scalar, typename RHSVector::Scalar> && // all entries should have same scalar type
     std::same_as<typename Tensor::Scalar, typename XVector::Scalar> &&   // all entries should have same scalar type
-    scalar_value<typename Tensor::Scalar>;                               // scalar can only be double or complex double
+    lu_scalar_value<typename Tensor::Scalar>;                            // scalar can only be (complex) double or float
 
 template <class Tensor, class RHSVector, class XVector>
     requires scalar_value_lu<Tensor, RHSVector, XVector>
@@ -260,6 +311,8 @@ struct sparse_lu_entry_trait<Tensor, RHSVector, XVector> {
     using LUFactor = void;
     struct BlockPerm {};
     using BlockPermArray = Idx;
+    using LowPrecisionTensor = low_precision_scalar_t<Tensor>;
+    using LowPrecisionVector = LowPrecisionTensor;
 };
 
 template <class Tensor, class RHSVector, class XVector>
@@ -272,6 +325,257 @@ struct sparse_lu_entry_trait<Tensor, RHSVector, XVector> {
     using LUFactor = DenseLUFactor<Matrix>; // LU decomposition with full pivoting in place
     using BlockPerm = LUFactor::BlockPerm;  // Extract permutation matrices p and q from LUFactor
     using BlockPermArray = std::vector<BlockPerm>;
+    using LowPrecisionTensor = Eigen::Array<low_precision_scalar_t<Scalar>, block_size, block_size, Tensor::Options>;
+    using LowPrecisionVector = Eigen::Array<low_precision_scalar_t<Scalar>, block_size, 1>;
+};
+
+// symbolic factorization of a structurally symmetric sparse matrix, including the pre-allocated fill-ins
+// the sparsity pattern is fixed per topology, so the entry positions that the numeric factorization needs are looked up
+// once here, instead of in every factorization
+struct SparseLUSymbolic {
+    // run of consecutive pivots [first, last] of which the rows right of the diagonal share the same trailing columns R
+    // after the run. The Schur-complement updates of the trailing block A(R, R) by all pivots of the run form one dense
+    // matrix product A(R, R) -= L(R, run) * U(run, R), which the numeric factorization applies after the last pivot.
+    struct Supernode {
+        Idx first{};
+        Idx last{};
+        Idx n_trailing{};
+        // positions of the dense trailing block A(R, R), row by row
+        IdxVector trailing_entry;
+    };
+
+    // thresholds for which a run of pivots is worth a dense update
+    // longer runs are split, so that the pivots of a part also update the trailing block of the part before
+    static constexpr Idx min_supernode_pivots = 2;
+    static constexpr Idx max_supernode_pivots = 4;
+    static constexpr Idx min_supernode_trailing = 2;
+    // the supernodes are only used if they cover enough of the Schur-complement updates, i.e. if the matrix has enough
+    // fill-in, e.g. in meshed networks. Otherwise, the column by column factorization is cheaper.
+    static constexpr double min_supernodal_update_fraction = 0.5;
+
+    // Schur-complement update A_k,j -= L_k,pivot * U_pivot,j by the positions of A_k,j, L_k,pivot and U_pivot,j
+    struct SchurUpdate {
+        Idx a_idx{};
+        Idx l_idx{};
+        Idx u_idx{};
+    };
+
+    // levels of the elimination tree, for the multi-threaded factorization and solve of large matrices
+    // the level of a pivot is its height in the elimination tree, i.e. one more than the highest level of its children.
+    // A pivot only depends on the pivots below it in the elimination tree, so the pivots of a level are independent.
+    struct LevelSchedule {
+        // pivots of each level, in ascending order
+        IdxVector level_indptr;
+        IdxVector level_pivots;
+        // Schur-complement updates of the row right of and the column below each pivot, i.e. the updates of which the
+        // pivot is min(k, j), in the order of the sequential factorization
+        IdxVector update_indptr;
+        std::vector<SchurUpdate> updates;
+    };
+
+    // only large matrices, e.g. a single math model of a transmission and distribution grid, gain from the threads
+    static constexpr Idx min_level_schedule_size = 50000;
+
+    // transpose_entry[idx] is the position of (col, row) if idx is the position of (row, col)
+    IdxVector transpose_entry;
+    // schur_u_end[l_ref_idx] is the end of the U entries of the pivot row that update the row of L_k,pivot one by one,
+    // for the position l_ref_idx of (pivot, k). The remaining U entries are part of a supernode update.
+    IdxVector schur_u_end;
+    // position of A_k,j in the Schur-complement updates A_k,j -= L_k,pivot * U_pivot,j, in the order in which the
+    // numeric factorization applies them
+    IdxVector schur_update_entry;
+    std::vector<Supernode> supernodes;
+    LevelSchedule level_schedule;
+
+    SparseLUSymbolic() = default;
+    SparseLUSymbolic(std::span<Idx const> row_indptr, std::span<Idx const> col_indices, std::span<Idx const> diag_lu)
+        : SparseLUSymbolic{row_indptr, col_indices, diag_lu, find_transpose_entry(row_indptr, col_indices)} {}
+    // use the transpose entries that are already known, e.g. the ones of the y bus structure
+    SparseLUSymbolic(std::span<Idx const> row_indptr, std::span<Idx const> col_indices, std::span<Idx const> diag_lu,
+                     IdxVector transpose_entry_)
+        : transpose_entry{std::move(transpose_entry_)}, schur_u_end(col_indices.size()) {
+        assert(transpose_entry.size() == col_indices.size());
+        Idx const size = std::ssize(row_indptr) - 1;
+
+        for (Idx row = 0; row != size; ++row) {
+            auto const row_begin = std::next(schur_u_end.begin(), row_indptr[row]);
+            std::fill(row_begin, std::next(schur_u_end.begin(), row_indptr[row + 1]), row_indptr[row + 1]);
+        }
+
+        find_supernodes(row_indptr, col_indices, diag_lu);
+
+        // same loops as the Schur-complement update of the numeric factorization
+        for (auto const& supernode : supernodes) {
+            for (Idx pivot_row_col = supernode.first; pivot_row_col <= supernode.last; ++pivot_row_col) {
+                Idx const row_end = row_indptr[pivot_row_col + 1];
+                // only the trailing rows skip the trailing columns
+                std::fill(std::next(schur_u_end.begin(), row_end - supernode.n_trailing),
+                          std::next(schur_u_end.begin(), row_end), row_end - supernode.n_trailing);
+            }
+        }
+        for (Idx pivot_row_col = 0; pivot_row_col != size; ++pivot_row_col) {
+            Idx const pivot_idx = diag_lu[pivot_row_col];
+            for (Idx l_ref_idx = pivot_idx + 1; l_ref_idx < row_indptr[pivot_row_col + 1]; ++l_ref_idx) {
+                Idx const l_row = col_indices[l_ref_idx];
+                auto const l_row_end = std::next(col_indices.begin(), row_indptr[l_row + 1]);
+                // it is guaranteed to have an entry at (l_row, u_col), if (pivot_row_col, u_col) is non-zero
+                // u_col is strictly increasing, so continue after the previous match
+                auto a_it = std::next(col_indices.begin(), transpose_entry[l_ref_idx]);
+                for (Idx u_idx = pivot_idx + 1; u_idx < schur_u_end[l_ref_idx]; ++u_idx) {
+                    a_it = std::find(std::next(a_it), l_row_end, col_indices[u_idx]);
+                    assert(a_it != l_row_end);
+                    schur_update_entry.push_back(narrow_cast<Idx>(std::distance(col_indices.begin(), a_it)));
+                }
+            }
+        }
+
+        if (size >= min_level_schedule_size) {
+            build_level_schedule(row_indptr, col_indices, diag_lu);
+        }
+    }
+
+    bool has_level_schedule() const { return !level_schedule.level_indptr.empty(); }
+
+    void build_level_schedule(std::span<Idx const> row_indptr, std::span<Idx const> col_indices,
+                              std::span<Idx const> diag_lu) {
+        Idx const size = std::ssize(row_indptr) - 1;
+
+        // the parent of a pivot in the elimination tree is the first column right of the diagonal, because the
+        // fill-ins are pre-allocated
+        IdxVector level(size, 0);
+        for (Idx pivot_row_col = 0; pivot_row_col != size; ++pivot_row_col) {
+            if (Idx const parent_idx = diag_lu[pivot_row_col] + 1; parent_idx != row_indptr[pivot_row_col + 1]) {
+                Idx const parent = col_indices[parent_idx];
+                level[parent] = std::max(level[parent], level[pivot_row_col] + 1);
+            }
+        }
+        Idx const n_level = size == 0 ? 0 : std::ranges::max(level) + 1;
+        level_schedule.level_indptr = counting_sort_offsets(level, n_level);
+        level_schedule.level_pivots = counting_sort(level, level_schedule.level_indptr);
+
+        // same loops as the Schur-complement update of the numeric factorization, without supernodes
+        IdxVector owner;
+        std::vector<SchurUpdate> updates;
+        for (Idx pivot_row_col = 0; pivot_row_col != size; ++pivot_row_col) {
+            Idx const pivot_idx = diag_lu[pivot_row_col];
+            for (Idx l_ref_idx = pivot_idx + 1; l_ref_idx < row_indptr[pivot_row_col + 1]; ++l_ref_idx) {
+                Idx const l_row = col_indices[l_ref_idx];
+                auto const l_row_end = std::next(col_indices.begin(), row_indptr[l_row + 1]);
+                auto a_it = std::next(col_indices.begin(), transpose_entry[l_ref_idx]);
+                for (Idx u_idx = pivot_idx + 1; u_idx < row_indptr[pivot_row_col + 1]; ++u_idx) {
+                    a_it = std::find(std::next(a_it), l_row_end, col_indices[u_idx]);
+                    assert(a_it != l_row_end);
+                    owner.push_back(std::min(l_row, col_indices[u_idx]));
+                    updates.push_back({.a_idx = narrow_cast<Idx>(std::distance(col_indices.begin(), a_it)),
+                                       .l_idx = transpose_entry[l_ref_idx],
+                                       .u_idx = u_idx});
+                }
+            }
+        }
+        level_schedule.update_indptr = counting_sort_offsets(owner, size);
+        level_schedule.updates = counting_sort(owner, level_schedule.update_indptr, updates);
+    }
+
+  private:
+    // structurally symmetric: looping the rows in order visits the entries (col, row) of each row col in order
+    static IdxVector find_transpose_entry(std::span<Idx const> row_indptr, std::span<Idx const> col_indices) {
+        Idx const size = std::ssize(row_indptr) - 1;
+        IdxVector transpose_entry(col_indices.size());
+        IdxVector col_position_idx(row_indptr.begin(), row_indptr.end() - 1);
+        for (Idx row = 0; row != size; ++row) {
+            for (Idx idx = row_indptr[row]; idx != row_indptr[row + 1]; ++idx) {
+                transpose_entry[idx] = col_position_idx[col_indices[idx]]++;
+            }
+        }
+        return transpose_entry;
+    }
+
+    void find_supernodes(std::span<Idx const> row_indptr, std::span<Idx const> col_indices,
+                         std::span<Idx const> diag_lu) {
+        Idx const size = std::ssize(row_indptr) - 1;
+        auto const n_right = [&row_indptr, &diag_lu](Idx row) { return row_indptr[row + 1] - diag_lu[row] - 1; };
+        // the row right of the diagonal continues the run, if it is the previous one without the current pivot
+        auto const continues_run = [&row_indptr, &col_indices, &diag_lu, &n_right](Idx row) {
+            Idx const previous = row - 1;
+            return n_right(previous) == n_right(row) + 1 && col_indices[diag_lu[previous] + 1] == row &&
+                   std::equal(std::next(col_indices.begin(), diag_lu[previous] + 2),
+                              std::next(col_indices.begin(), row_indptr[previous + 1]),
+                              std::next(col_indices.begin(), diag_lu[row] + 1));
+        };
+
+        double n_updates{};
+        double n_supernodal_updates{};
+        for (Idx first = 0; first != size;) {
+            Idx last = first;
+            while (last + 1 != size && continues_run(last + 1)) {
+                ++last;
+            }
+            for (Idx pivot_row_col = first; pivot_row_col <= last; ++pivot_row_col) {
+                n_updates += static_cast<double>(n_right(pivot_row_col) * n_right(pivot_row_col));
+            }
+            for (Idx part_first = first; part_first <= last; part_first += max_supernode_pivots) {
+                Idx const part_last = std::min(part_first + max_supernode_pivots - 1, last);
+                Idx const n_pivots = part_last - part_first + 1;
+                if (Idx const n_trailing = n_right(part_last);
+                    n_pivots >= min_supernode_pivots && n_trailing >= min_supernode_trailing) {
+                    n_supernodal_updates += static_cast<double>(n_pivots * n_trailing * n_trailing);
+                    supernodes.push_back(
+                        {.first = part_first,
+                         .last = part_last,
+                         .n_trailing = n_trailing,
+                         .trailing_entry = trailing_entries(row_indptr, col_indices, part_last, n_trailing)});
+                }
+            }
+            first = last + 1;
+        }
+        if (n_supernodal_updates < min_supernodal_update_fraction * n_updates) {
+            supernodes.clear();
+        }
+    }
+
+    static IdxVector counting_sort_offsets(IdxVector const& keys, Idx n_key) {
+        IdxVector offsets(n_key + 1, 0);
+        for (Idx const key : keys) {
+            ++offsets[key + 1];
+        }
+        std::partial_sum(offsets.cbegin(), offsets.cend(), offsets.begin());
+        return offsets;
+    }
+
+    // stable, so the values of each key keep their order
+    static IdxVector counting_sort(IdxVector const& keys, IdxVector const& offsets) {
+        IdxRange const indices{std::ssize(keys)};
+        return counting_sort(keys, offsets, IdxVector(indices.begin(), indices.end()));
+    }
+    template <typename T>
+    static std::vector<T> counting_sort(IdxVector const& keys, IdxVector const& offsets, std::vector<T> const& values) {
+        IdxVector position(offsets.cbegin(), offsets.cend() - 1);
+        std::vector<T> result(values.size());
+        for (Idx idx = 0; idx != std::ssize(keys); ++idx) {
+            result[position[keys[idx]]++] = values[idx];
+        }
+        return result;
+    }
+
+    // the trailing block is dense, because the run of pivots fills it in
+    static IdxVector trailing_entries(std::span<Idx const> row_indptr, std::span<Idx const> col_indices, Idx last,
+                                      Idx n_trailing) {
+        std::span<Idx const> const trailing_cols{std::next(col_indices.begin(), row_indptr[last + 1] - n_trailing),
+                                                 std::next(col_indices.begin(), row_indptr[last + 1])};
+        IdxVector result;
+        result.reserve(n_trailing * n_trailing);
+        for (Idx const row : trailing_cols) {
+            auto const row_begin = std::next(col_indices.begin(), row_indptr[row]);
+            auto const row_end = std::next(col_indices.begin(), row_indptr[row + 1]);
+            auto it = row_begin;
+            for (Idx const col : trailing_cols) {
+                it = std::find(it, row_end, col);
+                assert(it != row_end);
+                result.push_back(narrow_cast<Idx>(std::distance(col_indices.begin(), it)));
+            }
+        }
+        return result;
+    }
 };
 
 template <class Tensor, class RHSVector, class XVector> class SparseLUSolver {
@@ -283,16 +587,65 @@ template <class Tensor, class RHSVector, class XVector> class SparseLUSolver {
     using LUFactor = entry_trait::LUFactor;
     using BlockPerm = entry_trait::BlockPerm;
     using BlockPermArray = entry_trait::BlockPermArray;
+    using DenseMatrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+    using MultipleRHS = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+    using LowPrecisionTensor = entry_trait::LowPrecisionTensor;
+    using LowPrecisionVector = entry_trait::LowPrecisionVector;
+    using LowPrecisionSolver = SparseLUSolver<LowPrecisionTensor, LowPrecisionVector, LowPrecisionVector>;
+    static constexpr bool has_low_precision = !std::same_as<Tensor, LowPrecisionTensor>;
     static constexpr Idx max_iterative_refinement = 5;
+    static constexpr double low_rank_singular_threshold = 1e-10;
+
+    // low-rank correction dA of a factorized matrix A, which is only non-zero in a few rows and columns, e.g. the
+    // outage of a branch only changes the admittances between the buses of the branch
+    // (A + dA)^-1 is applied with the Sherman-Morrison-Woodbury identity, using the factorization of A:
+    //     x = z - W C^-1 D z(rows),    z = A^-1 b,    W = A^-1 E,    C = I + D W(rows)
+    // where E selects the rows and D = dA(rows, rows) is the dense correction
+    struct LowRankUpdate {
+        IdxVector rows;
+        DenseMatrix correction;
+        MultipleRHS inverse_columns;
+        Eigen::FullPivLU<DenseMatrix> capacitance;
+    };
 
     SparseLUSolver(std::span<Idx const> row_indptr,  // indptr including fill-ins
                    std::span<Idx const> col_indices, // indices including fill-ins
                    std::span<Idx const> diag_lu)
+        : SparseLUSolver{row_indptr, col_indices, diag_lu,
+                         std::make_shared<SparseLUSymbolic const>(row_indptr, col_indices, diag_lu)} {}
+
+    // use the symbolic factorization of the same sparsity pattern, e.g. the one stored in the y bus structure
+    SparseLUSolver(std::span<Idx const> row_indptr,  // indptr including fill-ins
+                   std::span<Idx const> col_indices, // indices including fill-ins
+                   std::span<Idx const> diag_lu, std::shared_ptr<SparseLUSymbolic const> symbolic)
         : size_{static_cast<Idx>(row_indptr.size()) - 1},
           nnz_{row_indptr.back()},
           row_indptr_{row_indptr},
           col_indices_{col_indices},
-          diag_lu_{diag_lu} {}
+          diag_lu_{diag_lu},
+          symbolic_{std::move(symbolic)} {
+        assert(symbolic_ != nullptr);
+        assert(std::ssize(symbolic_->transpose_entry) == nnz_);
+    }
+
+    // with mixed precision, prefactorize factorizes a single-precision copy of the matrix, which halves the memory
+    // traffic of the factorization, and leaves the matrix data itself unfactorized. The solve then refines the
+    // single-precision solution to double precision with the residual of the original matrix.
+    // if the single-precision factorization is not accurate enough, the solver falls back to double precision.
+    // the pivot perturbation is only done in double precision.
+    void set_factorization_precision(FactorizationPrecision factorization_precision) {
+        factorization_precision_ = factorization_precision;
+    }
+    FactorizationPrecision factorization_precision() const { return factorization_precision_; }
+
+    // the levels of a large matrix are factorized and solved on n_thread workers of the executor, which is not owned
+    // and has to outlive the calls. Without an executor, or with a single thread, the matrix is factorized and solved
+    // pivot by pivot.
+    // the executor may not be the one that runs the calling thread, e.g. the executor of the batch
+    void set_level_parallelism(JobExecutor* executor, Idx n_thread) {
+        level_executor_ = executor;
+        n_level_thread_ = n_thread;
+    }
 
     // solve with new matrix data, need to factorize first
     void
@@ -310,13 +663,168 @@ template <class Tensor, class RHSVector, class XVector> class SparseLUSolver {
     solve_with_prefactorized_matrix(std::vector<Tensor> const& data,        // pre-factorized data, const ref
                                     BlockPermArray const& block_perm_array, // pre-calculated permutation, const ref
                                     std::vector<RHSVector> const& rhs, std::vector<XVector>& x) {
-        if (has_pivot_perturbation_) {
+        if (low_precision_factorization_.has_value()) {
+            solve_with_low_precision_factorization(data, rhs, x);
+        } else if (double_precision_fallback_.has_value()) {
+            solve_once(double_precision_fallback_->lu_matrix, double_precision_fallback_->block_perm_array, rhs, x);
+        } else if (has_pivot_perturbation_) {
             solve_with_refinement(data, block_perm_array, rhs, x);
         } else {
             solve_once(data, block_perm_array, rhs, x);
         }
     }
 
+    // solve multiple right-hand sides with existing pre-factorization, e.g. for sensitivity studies
+    // rhs[i] is solved into x[i]. The right-hand sides are interleaved per row, so that each block of L and U is loaded
+    // once for all right-hand sides and the products vectorize over them.
+    void solve_multiple_with_prefactorized_matrix(
+        std::vector<Tensor> const& data,        // pre-factorized data, const ref
+        BlockPermArray const& block_perm_array, // pre-calculated permutation, const ref
+        std::span<std::vector<RHSVector> const> rhs, std::span<std::vector<XVector>> x) {
+        assert(rhs.size() == x.size());
+        if (has_pivot_perturbation_ || !is_factorized_in_place()) {
+            // the iterative refinement is per right-hand side
+            for (size_t rhs_number = 0; rhs_number != rhs.size(); ++rhs_number) {
+                solve_with_prefactorized_matrix(data, block_perm_array, rhs[rhs_number], x[rhs_number]);
+            }
+        } else {
+            solve_multiple_once(data, block_perm_array, rhs, x);
+        }
+    }
+
+    // prepare the low-rank correction of the pre-factorized matrix from the original, unfactorized, matrix to the
+    // modified matrix, both in the pattern of the solver
+    // returns false if the low-rank correction can not be used, i.e. if the matrices differ in more than max_rows rows
+    // and columns, if the modified matrix is (nearly) singular, e.g. because a branch outage splits the grid, or if
+    // the factorization needed a pivot perturbation or was not done in-place in double precision
+    bool prepare_low_rank_update(std::vector<Tensor> const& data,        // pre-factorized data, const ref
+                                 BlockPermArray const& block_perm_array, // pre-calculated permutation, const ref
+                                 std::vector<Tensor> const& original, std::vector<Tensor> const& modified,
+                                 Idx max_rows, LowRankUpdate& update) const {
+        assert(std::ssize(original) == nnz_);
+        assert(std::ssize(modified) == nnz_);
+        if (has_pivot_perturbation_ || !is_factorized_in_place()) {
+            return false;
+        }
+
+        // position of the changed rows and columns in the dense correction, or -1
+        IdxVector position(size_, -1);
+        for (Idx row = 0; row != size_; ++row) {
+            for (Idx data_idx = row_indptr_[row]; data_idx != row_indptr_[row + 1]; ++data_idx) {
+                if (!equal_entry(original[data_idx], modified[data_idx])) {
+                    position[row] = 0;
+                    position[col_indices_[data_idx]] = 0;
+                }
+            }
+        }
+        update.rows.clear();
+        for (Idx row = 0; row != size_; ++row) {
+            if (position[row] != -1) {
+                if (std::ssize(update.rows) == max_rows) {
+                    update.rows.clear();
+                    return false;
+                }
+                position[row] = std::ssize(update.rows);
+                update.rows.push_back(row);
+            }
+        }
+        Idx const n_rows = std::ssize(update.rows);
+        Idx const rank = n_rows * block_size;
+        if (n_rows == 0) {
+            return true;
+        }
+
+        // dense correction D
+        update.correction.setZero(rank, rank);
+        for (Idx i = 0; i != n_rows; ++i) {
+            Idx const row = update.rows[i];
+            for (Idx data_idx = row_indptr_[row]; data_idx != row_indptr_[row + 1]; ++data_idx) {
+                Idx const j = position[col_indices_[data_idx]];
+                if (j == -1) {
+                    continue;
+                }
+                if constexpr (is_block) {
+                    update.correction.block(i * block_size, j * block_size, block_size, block_size) =
+                        (modified[data_idx] - original[data_idx]).matrix();
+                } else {
+                    update.correction(i, j) = modified[data_idx] - original[data_idx];
+                }
+            }
+        }
+
+        // W = A^-1 E, the columns of E are the unit vectors of the rows, permuted for block matrix
+        MultipleRHS& inverse_columns = update.inverse_columns;
+        inverse_columns.setZero(size_ * block_size, rank);
+        for (Idx i = 0; i != n_rows; ++i) {
+            if constexpr (is_block) {
+                rhs_row_block(inverse_columns, update.rows[i]).middleCols(i * block_size, block_size) =
+                    block_perm_array[update.rows[i]].p * entry_trait::Matrix::Identity();
+            } else {
+                inverse_columns(update.rows[i], i) = Scalar{1.0};
+            }
+        }
+        substitute_multiple_in_place(data, inverse_columns);
+        if constexpr (is_block) {
+            for (Idx row = 0; row != size_; ++row) {
+                auto inverse_row = rhs_row_block(inverse_columns, row);
+                using PermutedRows = Eigen::Matrix<Scalar, block_size, Eigen::Dynamic>;
+                PermutedRows const permuted = block_perm_array[row].q * inverse_row;
+                inverse_row = permuted;
+            }
+        }
+
+        // capacitance matrix C = I + D W(rows)
+        DenseMatrix inverse_rows(rank, rank);
+        for (Idx i = 0; i != n_rows; ++i) {
+            inverse_rows.middleRows(i * block_size, block_size) =
+                inverse_columns.middleRows(update.rows[i] * block_size, block_size);
+        }
+        update.capacitance.compute(DenseMatrix::Identity(rank, rank) + update.correction * inverse_rows);
+        update.capacitance.setThreshold(low_rank_singular_threshold);
+        if (!update.capacitance.isInvertible()) {
+            update.rows.clear();
+            return false;
+        }
+        return true;
+    }
+
+    // solve the pre-factorized matrix with a low-rank correction, see prepare_low_rank_update
+    void solve_with_low_rank_update(std::vector<Tensor> const& data,        // pre-factorized data, const ref
+                                    BlockPermArray const& block_perm_array, // pre-calculated permutation, const ref
+                                    LowRankUpdate const& update, std::vector<RHSVector> const& rhs,
+                                    std::vector<XVector>& x) const {
+        assert(!has_pivot_perturbation_);
+        assert(is_factorized_in_place());
+        // z = A^-1 b
+        solve_once(data, block_perm_array, rhs, x);
+        Idx const n_rows = std::ssize(update.rows);
+        if (n_rows == 0) {
+            return;
+        }
+
+        // c = C^-1 D z(rows)
+        Eigen::Matrix<Scalar, Eigen::Dynamic, 1> x_rows(n_rows * block_size);
+        for (Idx i = 0; i != n_rows; ++i) {
+            if constexpr (is_block) {
+                x_rows.segment(i * block_size, block_size) = x[update.rows[i]].matrix();
+            } else {
+                x_rows(i) = x[update.rows[i]];
+            }
+        }
+        Eigen::Matrix<Scalar, Eigen::Dynamic, 1> const coefficients =
+            update.capacitance.solve(update.correction * x_rows);
+
+        // x = z - W c
+        for (Idx row = 0; row != size_; ++row) {
+            if constexpr (is_block) {
+                x[row] -= (update.inverse_columns.template middleRows<block_size>(row * block_size) * coefficients)
+                              .array();
+            } else {
+                x[row] -= (update.inverse_columns.row(row) * coefficients).value();
+            }
+        }
+    }
+
     // Compute Takahashi dependency blocks over the solver's stored sparse pattern
     // row_indptr_/col_indices_. This pattern includes fill-ins and can be larger
     // than the downstream target pattern, e.g. the original y_bus pattern.
@@ -330,7 +838,7 @@ template <class Tensor, class RHSVector, class XVector> class SparseLUSolver {
             throw SparseMatrixError{};
         } else {
             // we first handle the case without pivot perturbation
-            if (has_pivot_perturbation_) {
+            if (has_pivot_perturbation_ || !is_factorized_in_place()) {
                 throw SparseMatrixError{};
             }
             inplace_selective_inverse_block_matrix(data, block_perm_array);
@@ -343,165 +851,367 @@ template <class Tensor, class RHSVector, class XVector> class SparseLUSolver {
     // diagonals of U have values
     // fill-ins should be pre-allocated with zero
     // block permutation array should be pre-allocated
+    // with mixed precision, the data is not factorized in-place, see set_factorization_precision
     void prefactorize(std::vector<Tensor>& data, BlockPermArray& block_perm_array,
                       bool use_pivot_perturbation = false) {
         reset_matrix_cache();
+        if constexpr (has_low_precision) {
+            if (factorization_precision_ == FactorizationPrecision::mixed_precision && !use_pivot_perturbation &&
+                prefactorize_low_precision(data)) {
+                return;
+            }
+        }
         if (use_pivot_perturbation) {
             initialize_pivot_perturbation(data);
         }
         double const perturb_threshold = epsilon_perturbation * matrix_norm_;
 
-        // local reference
-        auto const& diag_lu = diag_lu_;
-        // lu matrix inplace
-        std::vector<Tensor>& lu_matrix = data;
+        if (use_level_schedule()) {
+            prefactorize_level_scheduled(data, block_perm_array, perturb_threshold, use_pivot_perturbation);
+        } else {
+            prefactorize_sequential(data, block_perm_array, perturb_threshold, use_pivot_perturbation);
+        }
+        // if no pivot perturbation happened, reset cache
+        if (!has_pivot_perturbation_) {
+            reset_matrix_cache();
+        }
+    }
 
-        // column position idx per row for LU matrix
-        IdxVector col_position_idx(row_indptr_.begin(), row_indptr_.end() - 1);
+  private:
+    // the solvers of all precisions share their factorization routines
+    template <class, class, class> friend class SparseLUSolver;
 
-        // start pivoting, it is always the diagonal
-        for (Idx pivot_row_col = 0; pivot_row_col != size_; ++pivot_row_col) {
-            Idx const pivot_idx = diag_lu[pivot_row_col];
+    static constexpr Idx linear_search_threshold = 16;
 
-            // Dense LU factorize pivot for block matrix in-place
-            // A_pivot,pivot, becomes P_pivot^-1 * L_pivot * U_pivot * Q_pivot^-1
-            // return reference to pivot permutation
-            BlockPerm const& block_perm = [&]() -> std::conditional_t<is_block, BlockPerm const&, BlockPerm> {
-                if constexpr (is_block) {
-                    // use machine precision by default
-                    // record block permutation
-                    auto pivot_matrix = lu_matrix[pivot_idx].matrix();
-                    LUFactor::factorize_block_in_place(pivot_matrix, block_perm_array[pivot_row_col], perturb_threshold,
-                                                       use_pivot_perturbation, has_pivot_perturbation_);
-                    return block_perm_array[pivot_row_col];
-                } else {
-                    if (use_pivot_perturbation) {
-                        // use machine precision by default
-                        // record pivot perturbation
-                        double abs_pivot = cabs(lu_matrix[pivot_idx]);
-                        perturb_pivot_if_needed(perturb_threshold, lu_matrix[pivot_idx], abs_pivot,
-                                                has_pivot_perturbation_);
-                    }
-                    if (!is_normal(lu_matrix[pivot_idx])) {
-                        throw SparseMatrixError{};
-                    }
-                    return {};
-                }
-            }();
-            // reference to pivot
-            Tensor const& pivot = lu_matrix[pivot_idx];
-
-            // for block matrix
-            // permute rows of L's in the left of the pivot
-            // L_k,pivot = P_pivot * L_k,pivot    k < pivot
-            // permute columns of U's above the pivot
-            // U_pivot,k = U_pivot,k * Q_pivot    k < pivot
-            if constexpr (is_block) {
-                // loop rows and columns at the same time
-                // since the matrix is symmetric
-                for (Idx l_idx = row_indptr_[pivot_row_col]; l_idx < pivot_idx; ++l_idx) {
-                    // permute rows of L_k,pivot
-                    lu_matrix[l_idx] = (block_perm.p * lu_matrix[l_idx].matrix()).array();
-                    // get row and idx of u
-                    Idx const u_row = col_indices_[l_idx];
-                    Idx const u_idx = col_position_idx[u_row];
-                    // we should exactly find the current column
-                    assert(col_indices_[u_idx] == pivot_row_col);
-                    // permute columns of U_pivot,k
-                    lu_matrix[u_idx] = (lu_matrix[u_idx].matrix() * block_perm.q).array();
-                    // increment column position
-                    ++col_position_idx[u_row];
-                }
-            }
+    template <class LUTensor, class LUBlockPermArray> struct Factorization {
+        std::vector<LUTensor> lu_matrix;
+        LUBlockPermArray block_perm_array;
+    };
+    using LowPrecisionFactorization =
+        Factorization<LowPrecisionTensor,
+                      typename sparse_lu_entry_trait<LowPrecisionTensor, LowPrecisionVector,
+                                                     LowPrecisionVector>::BlockPermArray>;
 
-            // for block matrix
-            // calculate U blocks in the right of the pivot, in-place
-            // L_pivot * U_pivot,k = P_pivot * A_pivot,k       k > pivot
-            if constexpr (is_block) {
-                for (Idx u_idx = pivot_idx + 1; u_idx < row_indptr_[pivot_row_col + 1]; ++u_idx) {
-                    Tensor& u = lu_matrix[u_idx];
-                    // permutation
-                    u = (block_perm.p * u.matrix()).array();
-                    // forward substitution (left,lower solve), per row in u
-                    LUFactor::template triangular_solve_inplace<TriangularSolveSide::left, TriangularFactor::lower>(
-                        pivot.matrix(), u);
-                }
+    bool is_factorized_in_place() const {
+        return !low_precision_factorization_.has_value() && !double_precision_fallback_.has_value();
+    }
+
+    // factorize a single-precision copy of the matrix
+    // returns false if the single-precision factorization failed, e.g. because the matrix is too ill-conditioned
+    bool prefactorize_low_precision(std::vector<Tensor> const& data) {
+        LowPrecisionFactorization factorization{.lu_matrix = std::vector<LowPrecisionTensor>(nnz_),
+                                                .block_perm_array = {}};
+        for (Idx idx = 0; idx != nnz_; ++idx) {
+            factorization.lu_matrix[idx] = to_low_precision(data[idx]);
+        }
+        if constexpr (is_block) {
+            factorization.block_perm_array.resize(size_);
+        }
+        try {
+            LowPrecisionSolver{row_indptr_, col_indices_, diag_lu_, symbolic_}.prefactorize(
+                factorization.lu_matrix, factorization.block_perm_array);
+        } catch (SparseMatrixError const&) {
+            return false;
+        }
+        low_precision_factorization_ = std::move(factorization);
+        return true;
+    }
+
+    // data is the original matrix, which is not factorized in-place
+    void solve_with_low_precision_factorization(std::vector<Tensor> const& data, std::vector<RHSVector> const& rhs,
+                                                std::vector<XVector>& x) {
+        auto const& factorization = low_precision_factorization_.value();
+        LowPrecisionSolver const low_precision_solver{row_indptr_, col_indices_, diag_lu_, symbolic_};
+        std::vector<LowPrecisionVector> low_precision_residual(size_);
+        std::vector<LowPrecisionVector> low_precision_dx(size_);
+
+        // the correction is solved in single precision, the residual is calculated in double precision
+        auto const solve_correction = [&](std::vector<RHSVector> const& residual, std::vector<XVector>& dx) {
+            for (Idx row = 0; row != size_; ++row) {
+                low_precision_residual[row] = to_low_precision(residual[row]);
             }
+            low_precision_solver.solve_once(factorization.lu_matrix, factorization.block_perm_array,
+                                            low_precision_residual, low_precision_dx);
+            for (Idx row = 0; row != size_; ++row) {
+                dx[row] = to_double_precision<XVector>(low_precision_dx[row]);
+            }
+        };
+        if (iterative_refinement(data, rhs, x, solve_correction)) {
+            return;
+        }
 
-            // Calculate L blocks below the pivot and apply the sparse Schur-complement update:
+        // the single-precision factorization is not accurate enough for this matrix, continue in double precision
+        // the right-hand side may be the same vector as x, use the copy of the refinement
+        Factorization<Tensor, BlockPermArray> fallback{.lu_matrix = data, .block_perm_array = BlockPermArray(size_)};
+        if (use_level_schedule()) {
+            prefactorize_level_scheduled(fallback.lu_matrix, fallback.block_perm_array, 0.0, false);
+        } else {
+            prefactorize_sequential(fallback.lu_matrix, fallback.block_perm_array, 0.0, false);
+        }
+        low_precision_factorization_.reset();
+        double_precision_fallback_ = std::move(fallback);
+        solve_once(double_precision_fallback_->lu_matrix, double_precision_fallback_->block_perm_array, rhs_.value(),
+                   x);
+        reset_refinement_cache();
+    }
+
+    template <class Value> static auto to_low_precision(Value const& value) {
+        if constexpr (is_block) {
+            return value.template cast<low_precision_scalar_t<Scalar>>().eval();
+        } else {
+            return static_cast<low_precision_scalar_t<Scalar>>(value);
+        }
+    }
+
+    template <class Value, class LowPrecisionValue> static Value to_double_precision(LowPrecisionValue const& value) {
+        if constexpr (is_block) {
+            return Value{value.template cast<Scalar>()};
+        } else {
+            return static_cast<Scalar>(value);
+        }
+    }
+
+    // right-looking factorization, pivot by pivot
+    void prefactorize_sequential(std::vector<Tensor>& lu_matrix, BlockPermArray& block_perm_array,
+                                 double perturb_threshold, bool use_pivot_perturbation) {
+        // local reference
+        auto const& transpose_entry = symbolic_->transpose_entry;
+        auto const& schur_u_end = symbolic_->schur_u_end;
+        auto const& schur_update_entry = symbolic_->schur_update_entry;
+        auto const& supernodes = symbolic_->supernodes;
+
+        // position in the Schur-complement updates and the supernodes of the symbolic factorization
+        Idx schur_update_idx = 0;
+        auto next_supernode = supernodes.cbegin();
+
+        // start pivoting, it is always the diagonal
+        for (Idx pivot_row_col = 0; pivot_row_col != size_; ++pivot_row_col) {
+            factorize_pivot(lu_matrix, block_perm_array, pivot_row_col, perturb_threshold, use_pivot_perturbation,
+                            has_pivot_perturbation_);
+            Idx const pivot_idx = diag_lu_[pivot_row_col];
+
+            // Apply the sparse Schur-complement update:
             // A_k,j = A_k,j - L_k,pivot * U_pivot,j    k, j > pivot
             // The outer and inner loops visit only structurally non-zero blocks of L_k,pivot and U_pivot,j.
             // Because the matrix is symmetric,
             //    looking for col_indices at pivot_row_col, starting from the diagonal (pivot_row_col, pivot_row_col)
             //    we get also the non-zero row indices under the pivot
             for (Idx l_ref_idx = pivot_idx + 1; l_ref_idx < row_indptr_[pivot_row_col + 1]; ++l_ref_idx) {
-                // find index of l in corresponding row
-                Idx const l_row = col_indices_[l_ref_idx];
-                Idx const l_idx = col_position_idx[l_row];
-                // we should exactly find the current column
-                assert(col_indices_[l_idx] == pivot_row_col);
-                // calculating l at (l_row, pivot_row_col)
-                if constexpr (is_block) {
-                    // for block matrix
-                    // calculate L blocks below the pivot, in-place
-                    // L_k,pivot * U_pivot = A_k_pivot * Q_pivot    k > pivot
-                    Tensor& l = lu_matrix[l_idx];
-                    // permutation
-                    l = (l.matrix() * block_perm.q).array();
-                    // forward substitution, per column in l
-                    // l0 = [l00, l10]^T
-                    // l1 = [l01, l11]^T
-                    // l = [l0, l1]
-                    // a = [a0, a1]
-                    // u = [[u00, u01]
-                    //      [0  , u11]]
-                    // l * u = a
-                    // l0 * u00 = a0
-                    // l0 * u01 + l1 * u11 = a1
-                    LUFactor::template triangular_solve_inplace<TriangularSolveSide::right, TriangularFactor::upper>(
-                        pivot.matrix(), l);
-                } else {
-                    // for scalar matrix, just divide
-                    // L_k,pivot = A_k,pivot / U_pivot    k > pivot
-                    lu_matrix[l_idx] = lu_matrix[l_idx] / pivot;
-                }
-                Tensor const& l = lu_matrix[l_idx];
+                Tensor const& l = lu_matrix[transpose_entry[l_ref_idx]];
 
                 // Perform Schur-complement update for row l_row of the trailing unfactorized block. For each
-                // structurally non-zero U entry to the right of the pivot, find the corresponding entry in l_row and
-                // apply A(l_row, u_col) -= l * U(pivot_row_col, u_col). it can create fill-ins, but the fill-ins are
-                // pre-allocated it is guaranteed to have an entry at (l_row, u_col), if (pivot_row_col, u_col) is
-                // non-zero
-                Idx a_idx = l_idx;
-                // loop all columns in the right of (pivot_row_col, pivot_row_col), at pivot_row
-                for (Idx u_idx = pivot_idx + 1; u_idx < row_indptr_[pivot_row_col + 1]; ++u_idx) {
-                    Idx const u_col = col_indices_[u_idx];
-                    assert(u_col > pivot_row_col);
-                    // u_col is strictly increasing, so continue after the previous match.
-                    a_idx = find_entry(l_row, u_col, a_idx + 1, row_indptr_[l_row + 1]);
+                // structurally non-zero U entry to the right of the pivot, apply
+                // A(l_row, u_col) -= l * U(pivot_row_col, u_col). it can create fill-ins, but the fill-ins are
+                // pre-allocated. The position of A(l_row, u_col) is taken from the symbolic factorization.
+                // loop all columns in the right of (pivot_row_col, pivot_row_col), at pivot_row, except the trailing
+                // block of a supernode
+                for (Idx u_idx = pivot_idx + 1; u_idx < schur_u_end[l_ref_idx]; ++u_idx) {
+                    Idx const a_idx = schur_update_entry[schur_update_idx++];
+                    assert(col_indices_[a_idx] == col_indices_[u_idx]);
                     // subtract
                     lu_matrix[a_idx] -= dot(l, lu_matrix[u_idx]);
                 }
-                // iterate column position
-                ++col_position_idx[l_row];
             }
-            // iterate column position for the pivot
-            ++col_position_idx[pivot_row_col];
+
+            // the trailing block of a supernode is updated by all its pivots at once
+            if (next_supernode != supernodes.cend() && next_supernode->last == pivot_row_col) {
+                update_supernode_trailing_block(lu_matrix, *next_supernode);
+                ++next_supernode;
+            }
         }
-        // if no pivot perturbation happened, reset cache
-        if (!has_pivot_perturbation_) {
-            reset_matrix_cache();
+        assert(schur_update_idx == std::ssize(schur_update_entry));
+        assert(next_supernode == supernodes.cend());
+    }
+
+    // left-looking factorization, level by level of the elimination tree
+    // instead of scattering its Schur-complement updates to the pivots above it, each pivot gathers the updates of its
+    // own row and column from the pivots below it, which are all in lower levels. The pivots of a level only write
+    // their own row and column, so they are factorized in parallel. The supernodes are not used.
+    void prefactorize_level_scheduled(std::vector<Tensor>& lu_matrix, BlockPermArray& block_perm_array,
+                                      double perturb_threshold, bool use_pivot_perturbation) {
+        auto const& schedule = symbolic_->level_schedule;
+        // the perturbation is recorded per pivot, so that it does not depend on the order in which the threads
+        // process the pivots of a level
+        // like in the sequential factorization, a pivot counts as perturbed if a pivot that updates it, i.e. a pivot
+        // below it in the elimination tree, is perturbed
+        std::vector<std::uint8_t> pivot_perturbation(size_, 0);
+
+        for_each_pivot_by_level(false, [&](Idx pivot_row_col) {
+            bool perturbed{false};
+            for (Idx update_idx = schedule.update_indptr[pivot_row_col];
+                 update_idx != schedule.update_indptr[pivot_row_col + 1]; ++update_idx) {
+                auto const& update = schedule.updates[update_idx];
+                lu_matrix[update.a_idx] -= dot(lu_matrix[update.l_idx], lu_matrix[update.u_idx]);
+                // L_k,pivot is in the column of the updating pivot
+                perturbed = perturbed || pivot_perturbation[col_indices_[update.l_idx]] != 0;
+            }
+            factorize_pivot(lu_matrix, block_perm_array, pivot_row_col, perturb_threshold, use_pivot_perturbation,
+                            perturbed);
+            pivot_perturbation[pivot_row_col] = static_cast<std::uint8_t>(perturbed);
+        });
+        has_pivot_perturbation_ =
+            std::ranges::any_of(pivot_perturbation, [](std::uint8_t perturbed) { return perturbed != 0; });
+    }
+
+    // factorize the pivot and calculate the row of U right of it and the column of L below it
+    // the Schur-complement updates of the pivot itself have to be applied already
+    // has_pivot_perturbation is set if the pivot is perturbed. Once set, also by an earlier pivot, a block pivot is not
+    // checked for its condition.
+    void factorize_pivot(std::vector<Tensor>& lu_matrix, BlockPermArray& block_perm_array, Idx pivot_row_col,
+                         double perturb_threshold, bool use_pivot_perturbation, bool& has_pivot_perturbation) const {
+        auto const& transpose_entry = symbolic_->transpose_entry;
+        Idx const pivot_idx = diag_lu_[pivot_row_col];
+        // Dense LU factorize pivot for block matrix in-place
+        // A_pivot,pivot, becomes P_pivot^-1 * L_pivot * U_pivot * Q_pivot^-1
+        // return reference to pivot permutation
+        BlockPerm const& block_perm = [&]() -> std::conditional_t<is_block, BlockPerm const&, BlockPerm> {
+            if constexpr (is_block) {
+                // use machine precision by default
+                // record block permutation
+                auto pivot_matrix = lu_matrix[pivot_idx].matrix();
+                LUFactor::factorize_block_in_place(pivot_matrix, block_perm_array[pivot_row_col], perturb_threshold,
+                                                   use_pivot_perturbation, has_pivot_perturbation);
+                return block_perm_array[pivot_row_col];
+            } else {
+                if (use_pivot_perturbation) {
+                    // use machine precision by default
+                    // record pivot perturbation
+                    double abs_pivot = cabs(lu_matrix[pivot_idx]);
+                    perturb_pivot_if_needed(perturb_threshold, lu_matrix[pivot_idx], abs_pivot,
+                                            has_pivot_perturbation);
+                }
+                if (!is_normal(lu_matrix[pivot_idx])) {
+                    throw SparseMatrixError{};
+                }
+                return {};
+            }
+        }();
+        // reference to pivot
+        Tensor const& pivot = lu_matrix[pivot_idx];
+
+        // for block matrix
+        // permute rows of L's in the left of the pivot
+        // L_k,pivot = P_pivot * L_k,pivot    k < pivot
+        // permute columns of U's above the pivot
+        // U_pivot,k = U_pivot,k * Q_pivot    k < pivot
+        if constexpr (is_block) {
+            // loop rows and columns at the same time
+            // since the matrix is symmetric
+            for (Idx l_idx = row_indptr_[pivot_row_col]; l_idx < pivot_idx; ++l_idx) {
+                // permute rows of L_k,pivot
+                lu_matrix[l_idx] = (block_perm.p * lu_matrix[l_idx].matrix()).array();
+                // get idx of u
+                Idx const u_idx = transpose_entry[l_idx];
+                // we should exactly find the current column
+                assert(col_indices_[u_idx] == pivot_row_col);
+                // permute columns of U_pivot,k
+                lu_matrix[u_idx] = (lu_matrix[u_idx].matrix() * block_perm.q).array();
+            }
+        }
+
+        // for block matrix
+        // calculate U blocks in the right of the pivot, in-place
+        // L_pivot * U_pivot,k = P_pivot * A_pivot,k       k > pivot
+        if constexpr (is_block) {
+            for (Idx u_idx = pivot_idx + 1; u_idx < row_indptr_[pivot_row_col + 1]; ++u_idx) {
+                Tensor& u = lu_matrix[u_idx];
+                // permutation
+                u = (block_perm.p * u.matrix()).array();
+                // forward substitution (left,lower solve), per row in u
+                LUFactor::template triangular_solve_inplace<TriangularSolveSide::left, TriangularFactor::lower>(
+                    pivot.matrix(), u);
+            }
+        }
+
+        // Calculate L blocks below the pivot
+        // Because the matrix is symmetric,
+        //    looking for col_indices at pivot_row_col, starting from the diagonal (pivot_row_col, pivot_row_col)
+        //    we get also the non-zero row indices under the pivot
+        for (Idx l_ref_idx = pivot_idx + 1; l_ref_idx < row_indptr_[pivot_row_col + 1]; ++l_ref_idx) {
+            // find index of l in corresponding row
+            Idx const l_idx = transpose_entry[l_ref_idx];
+            // we should exactly find the current column
+            assert(col_indices_[l_idx] == pivot_row_col);
+            // calculating l at (l_row, pivot_row_col)
+            if constexpr (is_block) {
+                // for block matrix
+                // calculate L blocks below the pivot, in-place
+                // L_k,pivot * U_pivot = A_k_pivot * Q_pivot    k > pivot
+                Tensor& l = lu_matrix[l_idx];
+                // permutation
+                l = (l.matrix() * block_perm.q).array();
+                // forward substitution, per column in l
+                // l0 = [l00, l10]^T
+                // l1 = [l01, l11]^T
+                // l = [l0, l1]
+                // a = [a0, a1]
+                // u = [[u00, u01]
+                //      [0  , u11]]
+                // l * u = a
+                // l0 * u00 = a0
+                // l0 * u01 + l1 * u11 = a1
+                LUFactor::template triangular_solve_inplace<TriangularSolveSide::right, TriangularFactor::upper>(
+                    pivot.matrix(), l);
+            } else {
+                // for scalar matrix, just divide
+                // L_k,pivot = A_k,pivot / U_pivot    k > pivot
+                lu_matrix[l_idx] = lu_matrix[l_idx] / pivot;
+            }
         }
     }
 
-  private:
-    static constexpr Idx linear_search_threshold = 16;
+    // A(R, R) -= L(R, supernode) * U(supernode, R), as one dense matrix product
+    void update_supernode_trailing_block(std::vector<Tensor>& lu_matrix,
+                                         SparseLUSymbolic::Supernode const& supernode) const {
+        using DenseMatrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+
+        Idx const n_pivots = supernode.last - supernode.first + 1;
+        Idx const n_trailing = supernode.n_trailing;
+        DenseMatrix l_dense(n_trailing * block_size, n_pivots * block_size);
+        DenseMatrix u_dense(n_pivots * block_size, n_trailing * block_size);
+
+        // gather: the trailing columns are the last entries of each pivot row
+        for (Idx pivot = 0; pivot != n_pivots; ++pivot) {
+            Idx const u_begin = row_indptr_[supernode.first + pivot + 1] - n_trailing;
+            for (Idx trailing = 0; trailing != n_trailing; ++trailing) {
+                Idx const u_idx = u_begin + trailing;
+                Idx const l_idx = symbolic_->transpose_entry[u_idx];
+                if constexpr (is_block) {
+                    l_dense.template block<block_size, block_size>(trailing * block_size, pivot * block_size) =
+                        lu_matrix[l_idx].matrix();
+                    u_dense.template block<block_size, block_size>(pivot * block_size, trailing * block_size) =
+                        lu_matrix[u_idx].matrix();
+                } else {
+                    l_dense(trailing, pivot) = lu_matrix[l_idx];
+                    u_dense(pivot, trailing) = lu_matrix[u_idx];
+                }
+            }
+        }
+
+        DenseMatrix const update = l_dense * u_dense;
+
+        // scatter
+        for (Idx row = 0; row != n_trailing; ++row) {
+            for (Idx col = 0; col != n_trailing; ++col) {
+                Tensor& a = lu_matrix[supernode.trailing_entry[row * n_trailing + col]];
+                if constexpr (is_block) {
+                    a -= update.template block<block_size, block_size>(row * block_size, col * block_size).array();
+                } else {
+                    a -= update(row, col);
+                }
+            }
+        }
+    }
 
     Idx size_;
     Idx nnz_; // number of non zeroes (in block)
     std::span<Idx const> row_indptr_;
     std::span<Idx const> col_indices_;
     std::span<Idx const> diag_lu_;
+    std::shared_ptr<SparseLUSymbolic const> symbolic_;
+    // workers for the levels of the level schedule, not owned
+    JobExecutor* level_executor_{nullptr};
+    Idx n_level_thread_{1};
     // cache value for pivot perturbation for the factorize step
     bool has_pivot_perturbation_{false};
     double matrix_norm_{};
@@ -510,10 +1220,27 @@ template <class Tensor, class RHSVector, class XVector> class SparseLUSolver {
     std::optional<std::vector<XVector>> dx_;
     std::optional<std::vector<RHSVector>> residual_;
     std::optional<std::vector<RHSVector>> rhs_;
+    // mixed precision
+    FactorizationPrecision factorization_precision_{FactorizationPrecision::double_precision};
+    std::optional<LowPrecisionFactorization> low_precision_factorization_;
+    std::optional<Factorization<Tensor, BlockPermArray>> double_precision_fallback_;
 
     void solve_with_refinement(std::vector<Tensor> const& data,        // pre-factorized data, const ref
                                BlockPermArray const& block_perm_array, // pre-calculated permutation, const ref
                                std::vector<RHSVector> const& rhs, std::vector<XVector>& x) {
+        if (!iterative_refinement(original_matrix_.value(), rhs, x,
+                                  [&](std::vector<RHSVector> const& residual, std::vector<XVector>& dx) {
+                                      solve_once(data, block_perm_array, residual, dx);
+                                  })) {
+            throw SparseMatrixError{};
+        }
+    }
+
+    // refine x until the backward error of the original matrix converges, solving the correction with solve_correction
+    // returns false if it does not converge, the refinement cache is then kept
+    template <std::invocable<std::vector<RHSVector> const&, std::vector<XVector>&> SolveCorrection>
+    bool iterative_refinement(std::vector<Tensor> const& original_matrix, std::vector<RHSVector> const& rhs,
+                              std::vector<XVector>& x, SolveCorrection const& solve_correction) {
         // initialize refinement
         initialize_refinement(rhs, x);
         double backward_error{std::numeric_limits<double>::max()};
@@ -524,17 +1251,18 @@ template <class Tensor, class RHSVector, class XVector> class SparseLUSolver {
         while (backward_error > epsilon_converge) {
             // check maximum iteration, including one initial run
             if (num_iter++ == max_iterative_refinement + 1) {
-                throw SparseMatrixError{};
+                return false;
             }
             // solve with residual (first time it is the b vector)
-            solve_once(data, block_perm_array, residual_.value(), dx_.value());
+            solve_correction(residual_.value(), dx_.value());
             // calculate backward error and then iterate x
-            backward_error = iterate_and_backward_error(x);
+            backward_error = iterate_and_backward_error(original_matrix, x);
             // calculate residual
-            calculate_residual(x);
+            calculate_residual(original_matrix, x);
         }
         // reset refinement cache
         reset_refinement_cache();
+        return true;
     }
 
     void reset_refinement_cache() {
@@ -562,8 +1290,7 @@ template <class Tensor, class RHSVector, class XVector> class SparseLUSolver {
         dx_ = x;
     }
 
-    void calculate_residual(std::vector<XVector> const& x) {
-        auto const& original_matrix = original_matrix_.value();
+    void calculate_residual(std::vector<Tensor> const& original_matrix, std::vector<XVector> const& x) {
         auto const& rhs = rhs_.value();
         auto& residual = residual_.value();
         // calculate residual
@@ -577,8 +1304,7 @@ template <class Tensor, class RHSVector, class XVector> class SparseLUSolver {
         }
     }
 
-    double iterate_and_backward_error(std::vector<XVector>& x) {
-        auto const& original_matrix = original_matrix_.value();
+    double iterate_and_backward_error(std::vector<Tensor> const& original_matrix, std::vector<XVector>& x) {
         auto const& rhs = rhs_.value();
         auto const& residual = residual_.value();
         auto const& dx = dx_.value();
@@ -652,6 +1378,8 @@ template <class Tensor, class RHSVector, class XVector> class SparseLUSolver {
         has_pivot_perturbation_ = false;
         matrix_norm_ = 0.0;
         original_matrix_.reset();
+        low_precision_factorization_.reset();
+        double_precision_fallback_.reset();
     }
 
     void inplace_selective_inverse_block_matrix(std::vector<Tensor>& data, BlockPermArray const& block_perm_array) const
@@ -769,59 +1497,217 @@ template <class Tensor, class RHSVector, class XVector> class SparseLUSolver {
     void solve_once(std::vector<Tensor> const& data,        // pre-factorized data, const ref
                     BlockPermArray const& block_perm_array, // pre-calculated permutation, const ref
                     std::vector<RHSVector> const& rhs, std::vector<XVector>& x) const {
-        // local reference
-        auto const& diag_lu = diag_lu_;
-        auto const& lu_matrix = data;
+        if (use_level_schedule()) {
+            // the rows of L of a level only depend on lower levels, the rows of U only on higher levels
+            for_each_pivot_by_level(false,
+                                    [&](Idx row) { forward_substitute_row(data, block_perm_array, rhs, x, row); });
+            for_each_pivot_by_level(true, [&](Idx row) { backward_substitute_row(data, x, row); });
+        } else {
+            for (Idx row = 0; row != size_; ++row) {
+                forward_substitute_row(data, block_perm_array, rhs, x, row);
+            }
+            for (Idx row = size_ - 1; row != -1; --row) {
+                backward_substitute_row(data, x, row);
+            }
+        }
+        // restore permutation for block matrix
+        if constexpr (is_block) {
+            for (Idx row = 0; row != size_; ++row) {
+                x[row] = (block_perm_array[row].q * x[row].matrix()).array();
+            }
+        }
+    }
 
-        // forward substitution with L
-        for (Idx row = 0; row != size_; ++row) {
-            // permutation if needed
-            if constexpr (is_block) {
-                x[row] = (block_perm_array[row].p * rhs[row].matrix()).array();
-            } else {
-                x[row] = rhs[row];
+    void solve_multiple_once(std::vector<Tensor> const& data, BlockPermArray const& block_perm_array,
+                             std::span<std::vector<RHSVector> const> rhs, std::span<std::vector<XVector>> x) const {
+        Idx const n_rhs = std::ssize(rhs);
+        // rows of the interleaved right-hand sides are contiguous
+        MultipleRHS work(size_ * block_size, n_rhs);
+
+        // permutation if needed
+        for (Idx rhs_number = 0; rhs_number != n_rhs; ++rhs_number) {
+            for (Idx row = 0; row != size_; ++row) {
+                if constexpr (is_block) {
+                    rhs_row_block(work, row).col(rhs_number) =
+                        block_perm_array[row].p * rhs[rhs_number][row].matrix();
+                } else {
+                    work(row, rhs_number) = rhs[rhs_number][row];
+                }
             }
+        }
+
+        substitute_multiple_in_place(data, work);
 
-            // loop all columns until diagonal
-            for (Idx l_idx = row_indptr_[row]; l_idx < diag_lu[row]; ++l_idx) {
-                Idx const col = col_indices_[l_idx];
-                // never overshoot
-                assert(col < row);
-                // forward subtract
-                x[row] -= dot(lu_matrix[l_idx], x[col]);
+        // restore permutation for block matrix
+        for (Idx rhs_number = 0; rhs_number != n_rhs; ++rhs_number) {
+            for (Idx row = 0; row != size_; ++row) {
+                if constexpr (is_block) {
+                    x[rhs_number][row] = (block_perm_array[row].q * rhs_row_block(work, row).col(rhs_number)).array();
+                } else {
+                    x[rhs_number][row] = work(row, rhs_number);
+                }
             }
-            // forward substitution inside block, for block matrix
-            if constexpr (is_block) {
-                Tensor const& pivot = lu_matrix[diag_lu[row]];
-                LUFactor::template triangular_solve_inplace<TriangularSolveSide::left, TriangularFactor::lower>(
-                    pivot.matrix(), x[row]);
+        }
+    }
+
+    // forward and backward substitution of the permuted right-hand sides, in-place
+    void substitute_multiple_in_place(std::vector<Tensor> const& data, MultipleRHS& work) const {
+        if (use_level_schedule()) {
+            for_each_pivot_by_level(false, [&](Idx row) { forward_substitute_row(data, work, row); });
+            for_each_pivot_by_level(true, [&](Idx row) { backward_substitute_row(data, work, row); });
+        } else {
+            for (Idx row = 0; row != size_; ++row) {
+                forward_substitute_row(data, work, row);
+            }
+            for (Idx row = size_ - 1; row != -1; --row) {
+                backward_substitute_row(data, work, row);
             }
         }
+    }
+
+    static bool equal_entry(Tensor const& lhs, Tensor const& rhs) {
+        if constexpr (is_block) {
+            return (lhs == rhs).all();
+        } else {
+            return lhs == rhs;
+        }
+    }
 
-        // backward substitution with U
-        for (Idx row = size_ - 1; row != -1; --row) {
-            // loop all columns from diagonal
-            for (Idx u_idx = row_indptr_[row + 1] - 1; u_idx > diag_lu[row]; --u_idx) {
-                Idx const col = col_indices_[u_idx];
-                // always in upper diagonal
-                assert(col > row);
-                // backward subtract
-                x[row] -= dot(lu_matrix[u_idx], x[col]);
+    // the block of rows of all right-hand sides at the row of the sparse matrix
+    static auto rhs_row_block(MultipleRHS& work, Idx row) {
+        if constexpr (is_block) {
+            return work.template middleRows<block_size>(row * block_size);
+        } else {
+            return work.row(row);
+        }
+    }
+
+    // forward substitution with L, for all right-hand sides
+    void forward_substitute_row(std::vector<Tensor> const& lu_matrix, MultipleRHS& work, Idx row) const {
+        auto x_row = rhs_row_block(work, row);
+        for (Idx l_idx = row_indptr_[row]; l_idx < diag_lu_[row]; ++l_idx) {
+            if constexpr (is_block) {
+                x_row.noalias() -= lu_matrix[l_idx].matrix() * rhs_row_block(work, col_indices_[l_idx]);
+            } else {
+                x_row -= lu_matrix[l_idx] * rhs_row_block(work, col_indices_[l_idx]);
             }
-            // solve the diagonal pivot
+        }
+        if constexpr (is_block) {
+            LUFactor::template triangular_solve_inplace<TriangularSolveSide::left, TriangularFactor::lower>(
+                lu_matrix[diag_lu_[row]].matrix(), x_row);
+        }
+    }
+
+    // backward substitution with U, for all right-hand sides
+    void backward_substitute_row(std::vector<Tensor> const& lu_matrix, MultipleRHS& work, Idx row) const {
+        auto x_row = rhs_row_block(work, row);
+        for (Idx u_idx = row_indptr_[row + 1] - 1; u_idx > diag_lu_[row]; --u_idx) {
             if constexpr (is_block) {
-                // backward substitution inside block
-                Tensor const& pivot = lu_matrix[diag_lu[row]];
-                LUFactor::template triangular_solve_inplace<TriangularSolveSide::left, TriangularFactor::upper>(
-                    pivot.matrix(), x[row]);
+                x_row.noalias() -= lu_matrix[u_idx].matrix() * rhs_row_block(work, col_indices_[u_idx]);
             } else {
-                x[row] = x[row] / lu_matrix[diag_lu[row]];
+                x_row -= lu_matrix[u_idx] * rhs_row_block(work, col_indices_[u_idx]);
             }
         }
-        // restore permutation for block matrix
         if constexpr (is_block) {
-            for (Idx row = 0; row != size_; ++row) {
-                x[row] = (block_perm_array[row].q * x[row].matrix()).array();
+            LUFactor::template triangular_solve_inplace<TriangularSolveSide::left, TriangularFactor::upper>(
+                lu_matrix[diag_lu_[row]].matrix(), x_row);
+        } else {
+            x_row /= lu_matrix[diag_lu_[row]];
+        }
+    }
+
+    // forward substitution with L
+    void forward_substitute_row(std::vector<Tensor> const& lu_matrix, BlockPermArray const& block_perm_array,
+                                std::vector<RHSVector> const& rhs, std::vector<XVector>& x, Idx row) const {
+        // permutation if needed
+        if constexpr (is_block) {
+            x[row] = (block_perm_array[row].p * rhs[row].matrix()).array();
+        } else {
+            x[row] = rhs[row];
+        }
+
+        // loop all columns until diagonal
+        for (Idx l_idx = row_indptr_[row]; l_idx < diag_lu_[row]; ++l_idx) {
+            Idx const col = col_indices_[l_idx];
+            // never overshoot
+            assert(col < row);
+            // forward subtract
+            x[row] -= dot(lu_matrix[l_idx], x[col]);
+        }
+        // forward substitution inside block, for block matrix
+        if constexpr (is_block) {
+            Tensor const& pivot = lu_matrix[diag_lu_[row]];
+            LUFactor::template triangular_solve_inplace<TriangularSolveSide::left, TriangularFactor::lower>(
+                pivot.matrix(), x[row]);
+        }
+    }
+
+    // backward substitution with U
+    void backward_substitute_row(std::vector<Tensor> const& lu_matrix, std::vector<XVector>& x, Idx row) const {
+        // loop all columns from diagonal
+        for (Idx u_idx = row_indptr_[row + 1] - 1; u_idx > diag_lu_[row]; --u_idx) {
+            Idx const col = col_indices_[u_idx];
+            // always in upper diagonal
+            assert(col > row);
+            // backward subtract
+            x[row] -= dot(lu_matrix[u_idx], x[col]);
+        }
+        // solve the diagonal pivot
+        if constexpr (is_block) {
+            // backward substitution inside block
+            Tensor const& pivot = lu_matrix[diag_lu_[row]];
+            LUFactor::template triangular_solve_inplace<TriangularSolveSide::left, TriangularFactor::upper>(
+                pivot.matrix(), x[row]);
+        } else {
+            x[row] = x[row] / lu_matrix[diag_lu_[row]];
+        }
+    }
+
+    // the level schedule only pays off if its levels are processed by multiple threads
+    // on a single thread, the sequential factorization, which also uses the supernodes, is faster
+    bool use_level_schedule() const {
+        return symbolic_->has_level_schedule() && level_executor_ != nullptr && n_level_thread_ > 1;
+    }
+
+    // call func(pivot_row_col) for all pivots, level by level of the elimination tree, or in reverse
+    // the pivots of a level are divided over the workers of the level executor, which wait for each other after each
+    // level
+    template <std::invocable<Idx> Func> void for_each_pivot_by_level(bool reverse, Func const& func) const {
+        assert(use_level_schedule());
+        auto const& level_indptr = symbolic_->level_schedule.level_indptr;
+        auto const& level_pivots = symbolic_->level_schedule.level_pivots;
+        Idx const n_level = std::ssize(level_indptr) - 1;
+
+        Idx const n_thread = std::min(n_level_thread_, level_executor_->n_threads());
+        std::atomic<bool> failed{false};
+        std::vector<std::exception_ptr> exceptions(n_thread);
+        std::barrier level_done{n_thread};
+
+        auto run = [&](Idx thread_number) {
+            for (Idx level_number = 0; level_number != n_level; ++level_number) {
+                Idx const level = reverse ? n_level - 1 - level_number : level_number;
+                // contiguous part of the pivots of the level
+                Idx const level_size = level_indptr[level + 1] - level_indptr[level];
+                Idx const begin = level_indptr[level] + level_size * thread_number / n_thread;
+                Idx const end = level_indptr[level] + level_size * (thread_number + 1) / n_thread;
+                if (!failed.load(std::memory_order_relaxed)) {
+                    try {
+                        for (Idx idx = begin; idx != end; ++idx) {
+                            func(level_pivots[idx]);
+                        }
+                    } catch (...) {
+                        exceptions[thread_number] = std::current_exception();
+                        failed.store(true, std::memory_order_relaxed);
+                    }
+                }
+                level_done.arrive_and_wait();
+            }
+        };
+
+        level_executor_->run(n_thread, run);
+        for (auto const& exception : exceptions) {
+            if (exception) {
+                std::rethrow_exception(exception);
             }
         }
     }
@@ -10,6 +10,7 @@
 #include "../common/enum.hpp"
 #include "../common/grouped_index_vector.hpp"
 #include "../common/three_phase_tensor.hpp"
+#include "sparse_lu_solver.hpp"
 
 #include <algorithm>
 #include <array>
@@ -117,6 +118,8 @@ struct YBusStructure {
     // for lu_transpose_entry[i] indicates the position i-th element in transposed lu matrix in CSR form
     // for entry in the diagonal lu_transpose_entry[i] = i
     IdxVector lu_transpose_entry;
+    // symbolic factorization of the LU structure, shared by the sparse LU solvers of all math solvers
+    SparseLUSymbolic lu_symbolic;
 
     // construct ybus structure
     explicit YBusStructure(MathModelTopology const& topo) {
@@ -290,6 +293,8 @@ struct YBusStructure {
             lu_transpose_entry[entry_1] = entry_2;
             lu_transpose_entry[entry_2] = entry_1;
         }
+
+        lu_symbolic = SparseLUSymbolic{row_indptr_lu, col_indices_lu, diag_lu, lu_transpose_entry};
     }
 };
 
@@ -333,6 +338,11 @@ template <symmetry_tag sym> class YBus {
     IdxVector const& bus_entry() const { return y_bus_structure().bus_entry; }
     IdxVector const& lu_diag() const { return y_bus_structure().diag_lu; }
     IdxVector const& map_lu_y_bus() const { return y_bus_structure().map_lu_y_bus; }
+    // shares the ownership of the y bus structure
+    std::shared_ptr<SparseLUSymbolic const> lu_symbolic() const {
+        assert(y_bus_struct_ != nullptr);
+        return {y_bus_struct_, &y_bus_struct_->lu_symbolic};
+    }
 
     std::shared_ptr<YBusStructure const> shared_y_bus_structure() const {
         assert(y_bus_struct_ != nullptr);
@@ -390,6 +400,10 @@ template <symmetry_tag sym> class YBus {
              std::views::zip(math_model_param_incrmt.source_param_to_change, math_model_param_incrmt.source_param)) {
             math_model_param_.source_param[idx_to_change] = params;
         }
+        // the source admittances are not part of the y bus, but they are part of the matrices of the solvers
+        if (!math_model_param_incrmt.source_param_to_change.empty()) {
+            parameters_changed(true);
+        }
 
         // process and update affected entries
         update_admittance_entries(by_ref(get_affected_admittance_entries(math_model_param_incrmt)));
@@ -566,6 +580,9 @@ template <symmetry_tag sym> class YBus {
         parameters_changed_callbacks_.erase(key);
     }
 
+    /// @brief unregister all callbacks, e.g. when the solvers they refer to are moved
+    void clear_parameters_changed_callbacks() { parameters_changed_callbacks_.clear(); }
+
   private:
     // csr structure
     std::shared_ptr<YBusStructure const> y_bus_struct_;
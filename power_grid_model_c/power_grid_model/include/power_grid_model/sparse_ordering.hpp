@@ -6,17 +6,87 @@
 
 #include "common/common.hpp"
 #include "common/counting_iterator.hpp"
+#include "common/hash.hpp"
+#include "common/lru_cache.hpp"
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <list>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
 #include <set>
+#include <span>
 #include <tuple>
 #include <utility>
 #include <vector>
 
 namespace power_grid_model {
 
+// undirected graph in compressed sparse row format
+// every edge is listed for both of its vertices, without self-loops or duplicates
+struct OrderingGraph {
+    IdxVector indptr{0};
+    IdxVector indices;
+
+    Idx n_vertices() const { return std::ssize(indptr) - 1; }
+    std::span<Idx const> adjacent(Idx vertex) const {
+        return std::span{indices}.subspan(indptr[vertex], indptr[vertex + 1] - indptr[vertex]);
+    }
+
+    friend bool operator==(OrderingGraph const& x, OrderingGraph const& y) = default;
+};
+
+inline OrderingGraph make_ordering_graph(Idx n_vertices, std::span<std::pair<Idx, Idx> const> edges) {
+    OrderingGraph graph{.indptr = IdxVector(n_vertices + 1, 0), .indices = {}};
+    for (auto const& [from, to] : edges) {
+        if (from != to) {
+            ++graph.indptr[from + 1];
+            ++graph.indptr[to + 1];
+        }
+    }
+    std::partial_sum(graph.indptr.begin(), graph.indptr.end(), graph.indptr.begin());
+    graph.indices.resize(graph.indptr.back());
+    IdxVector position{graph.indptr.begin(), graph.indptr.end() - 1};
+    for (auto const& [from, to] : edges) {
+        if (from != to) {
+            graph.indices[position[from]++] = to;
+            graph.indices[position[to]++] = from;
+        }
+    }
+    // sort and remove duplicate edges, compressing the indices in place
+    Idx n_unique = 0;
+    for (Idx vertex = 0; vertex != n_vertices; ++vertex) {
+        auto const begin = graph.indices.begin() + graph.indptr[vertex];
+        auto const end = graph.indices.begin() + graph.indptr[vertex + 1];
+        std::sort(begin, end);
+        auto const unique_end = std::unique(begin, end);
+        graph.indptr[vertex] = n_unique;
+        for (auto it = begin; it != unique_end; ++it) {
+            graph.indices[n_unique++] = *it;
+        }
+    }
+    graph.indptr[n_vertices] = n_unique;
+    graph.indices.resize(n_unique);
+    return graph;
+}
+
+// the automatic ordering keeps the exact minimum degree ordering for graphs up to this number of vertices
+constexpr Idx automatic_minimum_degree_max_size = 64;
+// parts of the nested dissection up to this number of vertices are ordered by approximate minimum degree
+constexpr Idx nested_dissection_leaf_size = 200;
+
+enum class SparseOrderingMethod : IntS {
+    automatic = 0,                  // minimum degree for small graphs, approximate minimum degree otherwise
+    minimum_degree = 1,             // exact minimum degree
+    approximate_minimum_degree = 2, // approximate minimum degree on the quotient graph
+    nested_dissection = 3,          // nested dissection, with approximate minimum degree on the small subgraphs
+};
+
 namespace detail {
 class DegreeLookup {
   public:
@@ -217,4 +287,671 @@ inline std::pair<IdxVector, std::vector<std::pair<Idx, Idx>>> minimum_degree_ord
     }
     return {alpha, fills};
 }
+
+namespace detail {
+constexpr Idx no_vertex = -1;
+
+// approximate minimum degree ordering on the quotient graph, stored in flat arrays
+// see P. R. Amestoy, T. A. Davis and I. S. Duff, An approximate minimum degree ordering algorithm, 1996
+//
+// the quotient graph consists of variables (not yet eliminated vertices) and elements (eliminated vertices)
+// the list of a variable holds its adjacent elements, followed by its adjacent variables
+// the list of an element holds its adjacent variables, i.e. the structure of its column in the factorization
+// indistinguishable variables are merged into a supervariable and eliminated together
+class ApproximateMinimumDegree {
+  public:
+    explicit ApproximateMinimumDegree(OrderingGraph const& graph)
+        : n_{graph.n_vertices()},
+          workspace_(graph.indices.size() + graph.indices.size() / 2 + 2 * n_),
+          begin_{graph.indptr.begin(), graph.indptr.end() - 1},
+          length_(n_),
+          n_elements_(n_, 0),
+          weight_(n_, 1),
+          degree_(n_),
+          next_member_(n_, no_vertex),
+          last_member_(n_),
+          status_(n_, NodeStatus::variable),
+          degree_head_(n_ + 1, no_vertex),
+          degree_next_(n_, no_vertex),
+          degree_prev_(n_, no_vertex),
+          w_(n_, 0),
+          hash_(n_, 0),
+          hash_head_(n_, no_vertex),
+          hash_next_(n_, no_vertex),
+          mark_(n_, 0) {
+        std::ranges::copy(graph.indices, workspace_.begin());
+        free_ = std::ssize(graph.indices);
+        std::iota(last_member_.begin(), last_member_.end(), Idx{0});
+        for (Idx vertex = 0; vertex != n_; ++vertex) {
+            length_[vertex] = graph.indptr[vertex + 1] - graph.indptr[vertex];
+            degree_[vertex] = length_[vertex];
+            insert_degree(vertex);
+        }
+    }
+
+    IdxVector order() {
+        IdxVector order;
+        order.reserve(n_);
+        Idx n_left = n_;
+        while (n_left > 0) {
+            Idx const pivot = select_pivot();
+            n_left -= weight_[pivot];
+            append_members(pivot, order);
+            create_element(pivot);
+            compute_element_differences(pivot);
+            n_left -= update_variables(pivot, order);
+            merge_indistinguishable_variables();
+            finalize_degrees(pivot, n_left);
+        }
+        return order;
+    }
+
+  private:
+    enum class NodeStatus : IntS { variable, element, absorbed };
+
+    Idx n_;
+    // lists of all nodes, in a single workspace that is compressed when it is full
+    IdxVector workspace_;
+    Idx free_{};
+    IdxVector begin_;
+    IdxVector length_;
+    IdxVector n_elements_;
+    // number of vertices in a supervariable, zero for a merged variable, negated while in the new element
+    IdxVector weight_;
+    // approximate external degree of a variable, or the number of vertices of the variables of an element
+    IdxVector degree_;
+    // members of a supervariable, as a linked list
+    IdxVector next_member_;
+    IdxVector last_member_;
+    std::vector<NodeStatus> status_;
+    // variables per degree, as doubly linked lists
+    IdxVector degree_head_;
+    IdxVector degree_next_;
+    IdxVector degree_prev_;
+    Idx min_degree_{0};
+    // w_[e] - w_flag_ is the number of vertices of element e outside the new element
+    IdxVector w_;
+    Idx w_flag_{1};
+    // supervariable detection
+    IdxVector hash_;
+    IdxVector hash_head_;
+    IdxVector hash_next_;
+    IdxVector mark_;
+    Idx mark_flag_{0};
+    // the new element, and a copy of the list of the variable that is updated
+    IdxVector new_element_;
+    IdxVector list_copy_;
+
+    void insert_degree(Idx variable) {
+        Idx const degree = degree_[variable];
+        Idx const head = degree_head_[degree];
+        degree_next_[variable] = head;
+        degree_prev_[variable] = no_vertex;
+        if (head != no_vertex) {
+            degree_prev_[head] = variable;
+        }
+        degree_head_[degree] = variable;
+        min_degree_ = std::min(min_degree_, degree);
+    }
+
+    void remove_degree(Idx variable) {
+        Idx const next = degree_next_[variable];
+        Idx const prev = degree_prev_[variable];
+        if (next != no_vertex) {
+            degree_prev_[next] = prev;
+        }
+        if (prev != no_vertex) {
+            degree_next_[prev] = next;
+        } else {
+            degree_head_[degree_[variable]] = next;
+        }
+    }
+
+    Idx select_pivot() {
+        while (degree_head_[min_degree_] == no_vertex) {
+            ++min_degree_;
+        }
+        Idx const pivot = degree_head_[min_degree_];
+        remove_degree(pivot);
+        return pivot;
+    }
+
+    void append_members(Idx variable, IdxVector& order) const {
+        for (Idx member = variable; member != no_vertex; member = next_member_[member]) {
+            order.push_back(member);
+        }
+    }
+
+    std::span<Idx> list(Idx node) { return std::span{workspace_}.subspan(begin_[node], length_[node]); }
+
+    bool is_principal_variable(Idx node) const { return status_[node] == NodeStatus::variable && weight_[node] > 0; }
+
+    void add_to_new_element(Idx variable) {
+        weight_[variable] = -weight_[variable];
+        new_element_.push_back(variable);
+    }
+
+    // the variables adjacent to the pivot, directly or via its elements, form the new element
+    // the elements of the pivot are absorbed into the new element
+    void create_element(Idx pivot) {
+        new_element_.clear();
+        weight_[pivot] = -weight_[pivot];
+        auto const pivot_list = list(pivot);
+        for (Idx k = 0; k != std::ssize(pivot_list); ++k) {
+            Idx const node = pivot_list[k];
+            if (k >= n_elements_[pivot]) {
+                if (is_principal_variable(node)) {
+                    add_to_new_element(node);
+                }
+                continue;
+            }
+            if (status_[node] != NodeStatus::element) {
+                continue;
+            }
+            for (Idx const variable : list(node)) {
+                if (is_principal_variable(variable)) {
+                    add_to_new_element(variable);
+                }
+            }
+            status_[node] = NodeStatus::absorbed;
+        }
+        weight_[pivot] = -weight_[pivot];
+        length_[pivot] = 0;
+        if (free_ + std::ssize(new_element_) > std::ssize(workspace_)) {
+            compress_workspace(std::ssize(new_element_));
+        }
+        status_[pivot] = NodeStatus::element;
+        begin_[pivot] = free_;
+        length_[pivot] = std::ssize(new_element_);
+        n_elements_[pivot] = 0;
+        std::ranges::copy(new_element_, workspace_.begin() + free_);
+        free_ += std::ssize(new_element_);
+
+        degree_[pivot] = 0;
+        for (Idx const variable : new_element_) {
+            degree_[pivot] -= weight_[variable];
+            remove_degree(variable);
+        }
+    }
+
+    void compress_workspace(Idx extra) {
+        Idx needed = extra;
+        for (Idx node = 0; node != n_; ++node) {
+            if (status_[node] != NodeStatus::absorbed) {
+                needed += length_[node];
+            }
+        }
+        IdxVector compressed(std::max(std::ssize(workspace_), 2 * needed));
+        Idx position = 0;
+        for (Idx node = 0; node != n_; ++node) {
+            if (status_[node] == NodeStatus::absorbed) {
+                length_[node] = 0;
+                continue;
+            }
+            auto const node_list = list(node);
+            std::ranges::copy(node_list, compressed.begin() + position);
+            begin_[node] = position;
+            position += std::ssize(node_list);
+        }
+        workspace_ = std::move(compressed);
+        free_ = position;
+    }
+
+    void compute_element_differences(Idx pivot) {
+        w_flag_ += n_ + 1;
+        for (Idx const variable : new_element_) {
+            Idx const variable_weight = -weight_[variable];
+            for (Idx const element : list(variable).first(n_elements_[variable])) {
+                if (status_[element] != NodeStatus::element || element == pivot) {
+                    continue;
+                }
+                if (w_[element] < w_flag_) {
+                    w_[element] = w_flag_ + degree_[element];
+                }
+                w_[element] -= variable_weight;
+            }
+        }
+    }
+
+    // prune the lists of the variables of the new element and compute their partial degrees
+    // elements that are a subset of the new element are absorbed
+    // variables that are only adjacent to the new element are eliminated together with the pivot
+    // return the number of vertices that are eliminated that way
+    Idx update_variables(Idx pivot, IdxVector& order) {
+        Idx n_eliminated = 0;
+        for (Idx const variable : new_element_) {
+            auto const variable_list = list(variable);
+            list_copy_.assign(variable_list.begin(), variable_list.end());
+            Idx const n_old_elements = n_elements_[variable];
+            Idx degree = 0;
+            Idx hash = 0;
+            Idx position = 0;
+            variable_list[position++] = pivot;
+            for (Idx k = 0; k != n_old_elements; ++k) {
+                Idx const element = list_copy_[k];
+                if (status_[element] != NodeStatus::element) {
+                    continue;
+                }
+                Idx const difference = w_[element] - w_flag_;
+                if (difference == 0) {
+                    status_[element] = NodeStatus::absorbed;
+                    continue;
+                }
+                degree += difference;
+                hash += element;
+                variable_list[position++] = element;
+            }
+            n_elements_[variable] = position;
+            for (Idx k = n_old_elements; k != std::ssize(list_copy_); ++k) {
+                Idx const adjacent = list_copy_[k];
+                if (is_principal_variable(adjacent)) {
+                    degree += weight_[adjacent];
+                    hash += adjacent;
+                    variable_list[position++] = adjacent;
+                }
+            }
+            assert(position <= std::ssize(list_copy_));
+            length_[variable] = position;
+
+            if (position == 1) {
+                Idx const variable_weight = -weight_[variable];
+                append_members(variable, order);
+                degree_[pivot] -= variable_weight;
+                n_eliminated += variable_weight;
+                weight_[variable] = 0;
+                status_[variable] = NodeStatus::absorbed;
+                continue;
+            }
+            degree_[variable] = degree;
+            hash_[variable] = hash % n_;
+            hash_next_[variable] = hash_head_[hash_[variable]];
+            hash_head_[hash_[variable]] = variable;
+        }
+        return n_eliminated;
+    }
+
+    bool is_indistinguishable(Idx variable, Idx other) {
+        if (length_[variable] != length_[other] || n_elements_[variable] != n_elements_[other]) {
+            return false;
+        }
+        return std::ranges::all_of(list(other), [this](Idx node) { return mark_[node] == mark_flag_; });
+    }
+
+    void merge_indistinguishable_variables() {
+        for (Idx const variable : new_element_) {
+            if (status_[variable] != NodeStatus::variable) {
+                continue;
+            }
+            Idx const bucket = hash_[variable];
+            Idx const head = hash_head_[bucket];
+            if (head == no_vertex) {
+                continue;
+            }
+            hash_head_[bucket] = no_vertex;
+            for (Idx first = head; first != no_vertex; first = hash_next_[first]) {
+                if (weight_[first] == 0 || hash_next_[first] == no_vertex) {
+                    continue;
+                }
+                ++mark_flag_;
+                for (Idx const node : list(first)) {
+                    mark_[node] = mark_flag_;
+                }
+                for (Idx second = hash_next_[first]; second != no_vertex; second = hash_next_[second]) {
+                    if (weight_[second] == 0 || hash_[second] != bucket || !is_indistinguishable(first, second)) {
+                        continue;
+                    }
+                    weight_[first] += weight_[second];
+                    weight_[second] = 0;
+                    status_[second] = NodeStatus::absorbed;
+                    next_member_[last_member_[first]] = second;
+                    last_member_[first] = last_member_[second];
+                }
+            }
+        }
+    }
+
+    void finalize_degrees(Idx pivot, Idx n_left) {
+        Idx const element_degree = degree_[pivot];
+        Idx n_variables = 0;
+        auto element_list = list(pivot);
+        for (Idx const variable : new_element_) {
+            if (status_[variable] != NodeStatus::variable) {
+                continue;
+            }
+            Idx const variable_weight = -weight_[variable];
+            weight_[variable] = variable_weight;
+            degree_[variable] =
+                std::min(degree_[variable] + element_degree - variable_weight, n_left - variable_weight);
+            insert_degree(variable);
+            element_list[n_variables++] = variable;
+        }
+        length_[pivot] = n_variables;
+    }
+};
+} // namespace detail
+
+// order the vertices to reduce the fill-in of the factorization, by approximate minimum degree
+inline IdxVector approximate_minimum_degree_ordering(OrderingGraph const& graph) {
+    return detail::ApproximateMinimumDegree{graph}.order();
+}
+
+namespace detail {
+// vertex subset of a graph, of which the elimination order occupies the positions before end
+struct DissectionPart {
+    IdxVector vertices;
+    Idx end{};
+};
+
+// nested dissection by level structures: each connected part is split by a level of a breadth first search from a
+// pseudo-peripheral vertex, the separator is eliminated after both halves
+// parts that are small, or that cannot be split, are ordered by approximate minimum degree
+class NestedDissection {
+  public:
+    NestedDissection(OrderingGraph const& graph, Idx leaf_size)
+        : graph_{graph},
+          leaf_size_{leaf_size},
+          part_(graph.n_vertices(), no_vertex),
+          visited_(graph.n_vertices(), 0),
+          level_(graph.n_vertices(), 0),
+          local_(graph.n_vertices(), no_vertex) {}
+
+    IdxVector order() {
+        Idx const n_vertices = graph_.n_vertices();
+        order_.resize(n_vertices);
+        IdxVector all(n_vertices);
+        std::iota(all.begin(), all.end(), Idx{0});
+        parts_.push_back({.vertices = std::move(all), .end = n_vertices});
+        while (!parts_.empty()) {
+            DissectionPart part = std::move(parts_.back());
+            parts_.pop_back();
+            dissect(part);
+        }
+        return std::move(order_);
+    }
+
+  private:
+    static constexpr Idx max_peripheral_searches = 4;
+
+    OrderingGraph const& graph_; // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
+    Idx leaf_size_;
+    IdxVector part_;
+    Idx part_id_{0};
+    IdxVector visited_;
+    Idx visit_flag_{0};
+    IdxVector level_;
+    IdxVector local_;
+    IdxVector queue_;
+    std::vector<DissectionPart> parts_;
+    IdxVector order_;
+
+    Idx degree(Idx vertex) const { return graph_.indptr[vertex + 1] - graph_.indptr[vertex]; }
+
+    // breadth first search within the current part, the queue holds the reached vertices in level order
+    // return the number of levels
+    Idx breadth_first_search(Idx root) {
+        ++visit_flag_;
+        queue_.assign(1, root);
+        visited_[root] = visit_flag_;
+        level_[root] = 0;
+        for (Idx k = 0; k != std::ssize(queue_); ++k) {
+            Idx const vertex = queue_[k];
+            for (Idx const adjacent : graph_.adjacent(vertex)) {
+                if (part_[adjacent] == part_id_ && visited_[adjacent] != visit_flag_) {
+                    visited_[adjacent] = visit_flag_;
+                    level_[adjacent] = level_[vertex] + 1;
+                    queue_.push_back(adjacent);
+                }
+            }
+        }
+        return level_[queue_.back()] + 1;
+    }
+
+    // search a root with a deep level structure, the queue holds the level structure of the returned root
+    Idx pseudo_peripheral_vertex(Idx root) {
+        Idx n_levels = breadth_first_search(root);
+        for (Idx search = 0; search != max_peripheral_searches; ++search) {
+            Idx candidate = queue_.back();
+            for (auto it = queue_.rbegin(); it != queue_.rend() && level_[*it] == n_levels - 1; ++it) {
+                if (degree(*it) < degree(candidate)) {
+                    candidate = *it;
+                }
+            }
+            Idx const candidate_levels = breadth_first_search(candidate);
+            root = candidate;
+            if (candidate_levels <= n_levels) {
+                break;
+            }
+            n_levels = candidate_levels;
+        }
+        return root;
+    }
+
+    void dissect(DissectionPart const& part) {
+        auto const size = std::ssize(part.vertices);
+        Idx const begin = part.end - size;
+        if (size <= leaf_size_) {
+            order_leaf(part.vertices, begin);
+            return;
+        }
+        ++part_id_;
+        for (Idx const vertex : part.vertices) {
+            part_[vertex] = part_id_;
+        }
+        pseudo_peripheral_vertex(part.vertices.front());
+
+        // a disconnected part is split in the connected component of the root and the rest
+        if (std::ssize(queue_) < size) {
+            IdxVector rest;
+            std::ranges::copy_if(part.vertices, std::back_inserter(rest),
+                                 [this](Idx vertex) { return visited_[vertex] != visit_flag_; });
+            parts_.push_back({.vertices = queue_, .end = begin + std::ssize(queue_)});
+            parts_.push_back({.vertices = std::move(rest), .end = part.end});
+            return;
+        }
+        Idx const n_levels = level_[queue_.back()] + 1;
+        if (n_levels < 3) {
+            order_leaf(part.vertices, begin);
+            return;
+        }
+
+        // the separator consists of the vertices of the middle level that are adjacent to the next level
+        Idx const middle = std::clamp(level_[queue_[size / 2]], Idx{1}, n_levels - 2);
+        IdxVector first_half;
+        IdxVector second_half;
+        IdxVector separator;
+        for (Idx const vertex : queue_) {
+            Idx const level = level_[vertex];
+            if (level > middle) {
+                second_half.push_back(vertex);
+            } else if (level == middle && std::ranges::any_of(graph_.adjacent(vertex), [this, middle](Idx adjacent) {
+                           return part_[adjacent] == part_id_ && level_[adjacent] == middle + 1;
+                       })) {
+                separator.push_back(vertex);
+            } else {
+                first_half.push_back(vertex);
+            }
+        }
+        std::ranges::copy(separator, order_.begin() + (part.end - std::ssize(separator)));
+        Idx const first_end = begin + std::ssize(first_half);
+        parts_.push_back({.vertices = std::move(first_half), .end = first_end});
+        parts_.push_back({.vertices = std::move(second_half), .end = part.end - std::ssize(separator)});
+    }
+
+    // order the subgraph induced by the vertices by approximate minimum degree
+    void order_leaf(IdxVector const& vertices, Idx begin) {
+        ++part_id_;
+        for (Idx k = 0; k != std::ssize(vertices); ++k) {
+            part_[vertices[k]] = part_id_;
+            local_[vertices[k]] = k;
+        }
+        OrderingGraph subgraph;
+        subgraph.indptr.reserve(vertices.size() + 1);
+        for (Idx const vertex : vertices) {
+            for (Idx const adjacent : graph_.adjacent(vertex)) {
+                if (part_[adjacent] == part_id_) {
+                    subgraph.indices.push_back(local_[adjacent]);
+                }
+            }
+            subgraph.indptr.push_back(std::ssize(subgraph.indices));
+        }
+        IdxVector const local_order = approximate_minimum_degree_ordering(subgraph);
+        for (Idx k = 0; k != std::ssize(local_order); ++k) {
+            order_[begin + k] = vertices[local_order[k]];
+        }
+    }
+};
+
+// the fill-ins of the factorization of the graph in the elimination order, by symbolic factorization along the
+// elimination tree: the structure of a column is the union of the adjacent later vertices and the structures of its
+// children in the elimination tree
+inline std::vector<std::pair<Idx, Idx>> elimination_fill_in(OrderingGraph const& graph, IdxVector const& order) {
+    Idx const n_vertices = graph.n_vertices();
+    IdxVector position(n_vertices);
+    for (Idx k = 0; k != n_vertices; ++k) {
+        position[order[k]] = k;
+    }
+    IdxVector column_indptr(n_vertices + 1, 0);
+    IdxVector column_indices;
+    IdxVector first_child(n_vertices, no_vertex);
+    IdxVector next_sibling(n_vertices, no_vertex);
+    IdxVector mark(n_vertices, no_vertex);
+    std::vector<std::pair<Idx, Idx>> fills;
+
+    for (Idx k = 0; k != n_vertices; ++k) {
+        Idx const vertex = order[k];
+        mark[k] = k;
+        for (Idx const adjacent : graph.adjacent(vertex)) {
+            if (Idx const j = position[adjacent]; j > k && mark[j] != k) {
+                mark[j] = k;
+                column_indices.push_back(j);
+            }
+        }
+        for (Idx child = first_child[k]; child != no_vertex; child = next_sibling[child]) {
+            for (Idx c = column_indptr[child]; c != column_indptr[child + 1]; ++c) {
+                if (Idx const j = column_indices[c]; mark[j] != k) {
+                    mark[j] = k;
+                    column_indices.push_back(j);
+                    fills.emplace_back(vertex, order[j]);
+                }
+            }
+        }
+        column_indptr[k + 1] = std::ssize(column_indices);
+        if (column_indptr[k + 1] != column_indptr[k]) {
+            Idx const parent = *std::min_element(column_indices.begin() + column_indptr[k], column_indices.end());
+            next_sibling[k] = first_child[parent];
+            first_child[parent] = k;
+        }
+    }
+    return fills;
+}
+
+inline std::map<Idx, IdxVector> to_adjacency_map(OrderingGraph const& graph) {
+    std::map<Idx, IdxVector> adjacency;
+    for (Idx vertex = 0; vertex != graph.n_vertices(); ++vertex) {
+        if (auto const adjacent = graph.adjacent(vertex); !adjacent.empty()) {
+            adjacency.try_emplace(vertex, adjacent.begin(), adjacent.end());
+        }
+    }
+    return adjacency;
+}
+} // namespace detail
+
+// order the vertices to reduce the fill-in of the factorization, by nested dissection
+inline IdxVector nested_dissection_ordering(OrderingGraph const& graph,
+                                            Idx leaf_size = nested_dissection_leaf_size) {
+    return detail::NestedDissection{graph, leaf_size}.order();
+}
+
+// order the vertices to reduce the fill-in of the factorization
+// return the elimination order and the fill-ins, in vertices of the graph
+inline std::pair<IdxVector, std::vector<std::pair<Idx, Idx>>>
+sparse_ordering(OrderingGraph const& graph, SparseOrderingMethod method = SparseOrderingMethod::automatic) {
+    using enum SparseOrderingMethod;
+
+    if (method == automatic) {
+        method = graph.n_vertices() <= automatic_minimum_degree_max_size ? minimum_degree : approximate_minimum_degree;
+    }
+    switch (method) {
+    case minimum_degree:
+        return minimum_degree_ordering(detail::to_adjacency_map(graph));
+    case nested_dissection: {
+        IdxVector order = nested_dissection_ordering(graph);
+        auto fills = detail::elimination_fill_in(graph, order);
+        return {std::move(order), std::move(fills)};
+    }
+    case approximate_minimum_degree:
+        [[fallthrough]];
+    default: {
+        IdxVector order = approximate_minimum_degree_ordering(graph);
+        auto fills = detail::elimination_fill_in(graph, order);
+        return {std::move(order), std::move(fills)};
+    }
+    }
+}
+
+// bounded least-recently-used cache of the sparse orderings of graphs
+//
+// the meshed islands of a grid are mostly the same in many switching states, e.g. when only a switch in a radial
+// feeder or in another island changes, so their orderings can be reused. All access is guarded by a mutex, so that the
+// cache can be shared between the copies of a model
+class SparseOrderingCache {
+  public:
+    using Ordering = std::pair<IdxVector, std::vector<std::pair<Idx, Idx>>>;
+
+    static constexpr Idx default_capacity = 64;
+
+    explicit SparseOrderingCache(Idx capacity = default_capacity) : entries_{capacity} {}
+
+    std::shared_ptr<Ordering const> find(OrderingGraph const& graph, SparseOrderingMethod method) {
+        auto const entry = entries_.find(hash_graph(graph), [&graph, method](Entry const& cached) {
+            return cached.method == method && cached.graph == graph;
+        });
+        return entry == nullptr ? nullptr : entry->ordering;
+    }
+
+    // another thread may have ordered the same graph in the meantime, in which case that one is kept
+    void insert(OrderingGraph graph, SparseOrderingMethod method, std::shared_ptr<Ordering const> ordering) {
+        assert(ordering != nullptr);
+        std::size_t const hash = hash_graph(graph);
+        auto entry = std::make_shared<Entry const>(
+            Entry{.method = method, .graph = std::move(graph), .ordering = std::move(ordering)});
+        OrderingGraph const& cached_graph = entry->graph;
+        entries_.insert(hash, std::move(entry), [&cached_graph, method](Entry const& cached) {
+            return cached.method == method && cached.graph == cached_graph;
+        });
+    }
+
+    Idx size() const { return entries_.size(); }
+    Idx capacity() const { return entries_.capacity(); }
+
+  private:
+    struct Entry {
+        SparseOrderingMethod method{};
+        OrderingGraph graph;
+        std::shared_ptr<Ordering const> ordering;
+    };
+
+    LruCache<Entry> entries_;
+
+    static std::size_t hash_graph(OrderingGraph const& graph) {
+        std::size_t seed{0};
+        auto const combine = [&seed](Idx value) { combine_hash(seed, std::hash<Idx>{}(value)); };
+        std::ranges::for_each(graph.indptr, combine);
+        std::ranges::for_each(graph.indices, combine);
+        return seed;
+    }
+};
+
+// order the vertices to reduce the fill-in of the factorization, reusing the ordering of the same graph if it is in the
+// cache
+inline std::shared_ptr<SparseOrderingCache::Ordering const> sparse_ordering(OrderingGraph graph,
+                                                                           SparseOrderingMethod method,
+                                                                           SparseOrderingCache& cache) {
+    if (auto cached = cache.find(graph, method); cached != nullptr) {
+        return cached;
+    }
+    auto ordering = std::make_shared<SparseOrderingCache::Ordering const>(sparse_ordering(graph, method));
+    cache.insert(std::move(graph), method, ordering);
+    return ordering;
+}
 } // namespace power_grid_model
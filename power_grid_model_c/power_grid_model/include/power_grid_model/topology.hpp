@@ -14,24 +14,14 @@
 #include "common/grouped_index_vector.hpp"
 #include "index_mapping.hpp"
 
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/compressed_sparse_row_graph.hpp>
-#include <boost/graph/depth_first_search.hpp>
-#include <boost/graph/graph_selectors.hpp>
-#include <boost/graph/graph_traits.hpp>
-#include <boost/graph/iteration_macros.hpp>
-#include <boost/graph/properties.hpp>
-#include <boost/iterator/counting_iterator.hpp>
-#include <boost/pending/property.hpp>
-
 #include <algorithm>
 #include <array>
 #include <cassert>
 #include <concepts>
 #include <cstddef>
 #include <iterator>
-#include <map>
 #include <memory>
+#include <numeric>
 #include <ranges>
 #include <type_traits>
 #include <utility>
@@ -44,17 +34,97 @@
 
 namespace power_grid_model::topology {
 
+namespace detail {
+using GraphIdx = std::size_t;
+
+// sparse directed graph in compressed sparse row format, with a value per edge
+// the out-going edges of a vertex keep the order in which they were added
+template <typename EdgeValue> class CompressedGraph {
+  public:
+    CompressedGraph() = default;
+    CompressedGraph(GraphIdx n_vertices, std::vector<std::pair<GraphIdx, GraphIdx>> const& edges,
+                    std::vector<EdgeValue> const& edge_values)
+        : indptr_(n_vertices + 1, 0), targets_(edges.size()), edge_values_(edges.size()) {
+        assert(edges.size() == edge_values.size());
+        for (auto const& edge : edges) {
+            ++indptr_[edge.first + 1];
+        }
+        std::partial_sum(indptr_.cbegin(), indptr_.cend(), indptr_.begin());
+        std::vector<GraphIdx> position{indptr_.cbegin(), indptr_.cend() - 1};
+        for (auto const& [edge, edge_value] : std::views::zip(edges, edge_values)) {
+            GraphIdx const edge_idx = position[edge.first]++;
+            targets_[edge_idx] = edge.second;
+            edge_values_[edge_idx] = edge_value;
+        }
+    }
+
+    GraphIdx n_vertices() const { return indptr_.empty() ? 0 : indptr_.size() - 1; }
+    GraphIdx edges_begin(GraphIdx vertex) const { return indptr_[vertex]; }
+    GraphIdx edges_end(GraphIdx vertex) const { return indptr_[vertex + 1]; }
+    GraphIdx target(GraphIdx edge) const { return targets_[edge]; }
+    EdgeValue const& operator[](GraphIdx edge) const { return edge_values_[edge]; }
+
+  private:
+    std::vector<GraphIdx> indptr_;
+    std::vector<GraphIdx> targets_;
+    std::vector<EdgeValue> edge_values_;
+};
+
+enum class VertexColor : IntS { white = 0, gray = 1, black = 2 };
+
+template <typename Visitor, typename Graph>
+concept dfs_visitor_c = requires(Visitor visitor, Graph const& graph, GraphIdx vertex) {
+    visitor.discover_vertex(vertex, graph);
+    visitor.tree_edge(vertex, vertex, vertex, graph);
+    visitor.back_edge(vertex, vertex, vertex, graph);
+};
+
+// iterative depth first search from the root, on the vertices that are still white
+// the vertices and edges are visited in the same order as boost::depth_first_visit does:
+//   tree edges are reported before the discovery of their target
+//   edges to a gray vertex, i.e. a vertex on the current path, are back edges
+//   edges to a black vertex, i.e. a finished vertex, are forward or cross edges and are ignored
+// the stack is a workspace of (vertex, next edge) pairs that may be reused between searches
+template <typename EdgeValue, dfs_visitor_c<CompressedGraph<EdgeValue>> Visitor>
+void depth_first_visit(CompressedGraph<EdgeValue> const& graph, GraphIdx root, std::vector<VertexColor>& color,
+                       std::vector<std::pair<GraphIdx, GraphIdx>>& stack, Visitor&& visitor) {
+    color[root] = VertexColor::gray;
+    visitor.discover_vertex(root, graph);
+    stack.assign(1, {root, graph.edges_begin(root)});
+    while (!stack.empty()) {
+        GraphIdx const source = stack.back().first;
+        GraphIdx const edge = stack.back().second;
+        if (edge == graph.edges_end(source)) {
+            color[source] = VertexColor::black;
+            stack.pop_back();
+            continue;
+        }
+        ++stack.back().second;
+        GraphIdx const target = graph.target(edge);
+        switch (color[target]) {
+        case VertexColor::white:
+            visitor.tree_edge(source, target, edge, graph);
+            color[target] = VertexColor::gray;
+            visitor.discover_vertex(target, graph);
+            stack.emplace_back(target, graph.edges_begin(target));
+            break;
+        case VertexColor::gray:
+            visitor.back_edge(source, target, edge, graph);
+            break;
+        default:
+            break;
+        }
+    }
+}
+} // namespace detail
+
 class Topology {
-    using GraphIdx = size_t;
+    using GraphIdx = detail::GraphIdx;
 
     struct GlobalEdge {
         double phase_shift;
     };
 
-    struct GlobalVertex {
-        boost::default_color_type color;
-    };
-
     // sparse directed graph
     // edge i -> j, the phase shift is node_j - node_i
     // so to move forward from i to j, the phase shift is appended by value at (i, j)
@@ -62,11 +132,10 @@ class Topology {
     // n_node + k, k as branch3 sequence number
     // branch3 #0, has internal node idx n_node
     // branch3 #1, has internal node idx n_node + 1
-    using GlobalGraph = boost::compressed_sparse_row_graph<boost::directedS, GlobalVertex, GlobalEdge,
-                                                           boost::no_property, GraphIdx, GraphIdx>;
+    using GlobalGraph = detail::CompressedGraph<GlobalEdge>;
 
     // dfs visitor for global graph
-    class GlobalDFSVisitor : public boost::dfs_visitor<> {
+    class GlobalDFSVisitor {
       public:
         GlobalDFSVisitor(Idx math_group, std::vector<Idx2D>& node_coupling, std::vector<double>& phase_shift,
                          std::vector<Idx>& dfs_node, std::vector<GraphIdx>& predecessors,
@@ -80,9 +149,7 @@ class Topology {
 
         // accumulate phase shift
         // assign predecessor
-        void tree_edge(GlobalGraph::edge_descriptor e, GlobalGraph const& g) {
-            GraphIdx const source = boost::source(e, g);
-            GraphIdx const target = boost::target(e, g);
+        void tree_edge(GraphIdx source, GraphIdx target, GraphIdx e, GlobalGraph const& g) {
             phase_shift_[target] = phase_shift_[source] + g[e].phase_shift;
             predecessors_[target] = source;
         }
@@ -93,9 +160,7 @@ class Topology {
         //    cross edge does not exist
 
         // back edge, judge if it forms a cycle
-        void back_edge(GlobalGraph::edge_descriptor e, GlobalGraph const& g) {
-            GraphIdx const source = boost::source(e, g);
-            GraphIdx const target = boost::target(e, g);
+        void back_edge(GraphIdx source, GraphIdx target, GraphIdx /* e */, GlobalGraph const& /* g */) {
             // if this edge matches in the current tree as target->source
             // it does not form a cycle, but an anti-parallel edge
             // else it forms a cycle
@@ -106,7 +171,7 @@ class Topology {
 
         // assign node to math group
         // append node to dfs list
-        void discover_vertex(GlobalGraph::vertex_descriptor u, GlobalGraph const& /* unused_value */) {
+        void discover_vertex(GraphIdx u, GlobalGraph const& /* unused_value */) {
             node_coupling_[u].group = math_group_;
             dfs_node_.push_back(static_cast<Idx>(u));
         }
@@ -124,14 +189,20 @@ class Topology {
     };
 
   public:
-    Topology(ReducedComponentTopology const& comp_topo, ComponentConnections const& comp_conn)
+    // the orderings of the meshed islands are reused from the sparse ordering cache, if provided
+    Topology(ReducedComponentTopology const& comp_topo, ComponentConnections const& comp_conn,
+             SparseOrderingMethod sparse_ordering_method = SparseOrderingMethod::automatic,
+             SparseOrderingCache* sparse_ordering_cache = nullptr)
         : comp_topo_{comp_topo},
           comp_conn_{comp_conn},
+          sparse_ordering_method_{sparse_ordering_method},
+          sparse_ordering_cache_{sparse_ordering_cache},
           phase_shift_(comp_topo_.n_node_total(), 0.0),
-          predecessors_(
-              boost::counting_iterator<GraphIdx>{0}, // Predecessors is initialized as 0, 1, 2, ..., n_node_total() - 1
-              boost::counting_iterator<GraphIdx>{narrow_cast<GraphIdx>(comp_topo_.n_node_total())}),
-          node_status_(comp_topo_.n_node_total(), not_processed) {}
+          predecessors_(comp_topo_.n_node_total()),
+          node_status_(comp_topo_.n_node_total(), not_processed) {
+        // Predecessors is initialized as 0, 1, 2, ..., n_node_total() - 1
+        std::iota(predecessors_.begin(), predecessors_.end(), GraphIdx{0});
+    }
 
     // build topology
     std::pair<std::vector<std::shared_ptr<MathModelTopology const>>,
@@ -159,9 +230,13 @@ class Topology {
     // input
     ReducedComponentTopology const& comp_topo_; // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
     ComponentConnections const& comp_conn_;     // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
+    SparseOrderingMethod sparse_ordering_method_;
+    SparseOrderingCache* sparse_ordering_cache_;
 
     // intermediate
     GlobalGraph global_graph_;
+    std::vector<detail::VertexColor> vertex_color_;
+    std::vector<std::pair<GraphIdx, GraphIdx>> dfs_stack_;
     DoubleVector phase_shift_;
     std::vector<GraphIdx> predecessors_;
     // node status
@@ -189,10 +264,6 @@ class Topology {
         comp_coup_.voltage_regulator.resize(comp_topo_.regulated_object_idx.size(), unknown_idx2d);
     }
 
-    template <functor_c F> static void for_all_vertices(GlobalGraph const& graph, F func) {
-        BGL_FORALL_VERTICES(v, graph, GlobalGraph) { func(v); }
-    }
-
     void build_sparse_graph() {
         std::vector<std::pair<GraphIdx, GraphIdx>> edges;
         std::vector<GlobalEdge> edge_props;
@@ -229,11 +300,8 @@ class Topology {
             }
         }
         // build graph
-        global_graph_ = GlobalGraph{boost::edges_are_unsorted_multi_pass, edges.cbegin(), edges.cend(),
-                                    edge_props.cbegin(), narrow_cast<GraphIdx>(comp_topo_.n_node_total())};
-        for_all_vertices(global_graph_, [this](boost::graph_traits<GlobalGraph>::vertex_descriptor const& v) {
-            global_graph_[v].color = boost::default_color_type::white_color;
-        });
+        global_graph_ = GlobalGraph{narrow_cast<GraphIdx>(comp_topo_.n_node_total()), edges, edge_props};
+        vertex_color_.assign(comp_topo_.n_node_total(), detail::VertexColor::white);
     }
 
     void dfs_search() {
@@ -256,10 +324,9 @@ class Topology {
             // back edges
             std::vector<std::pair<GraphIdx, GraphIdx>> back_edges;
             // start dfs search
-            boost::depth_first_visit(
-                global_graph_, narrow_cast<GraphIdx>(source_node),
-                GlobalDFSVisitor{math_solver_idx, comp_coup_.node, phase_shift_, dfs_node, predecessors_, back_edges},
-                boost::get(&GlobalVertex::color, global_graph_));
+            detail::depth_first_visit(
+                global_graph_, narrow_cast<GraphIdx>(source_node), vertex_color_, dfs_stack_,
+                GlobalDFSVisitor{math_solver_idx, comp_coup_.node, phase_shift_, dfs_node, predecessors_, back_edges});
 
             // begin to construct math topology
             MathModelTopology math_topo_single{};
@@ -297,7 +364,7 @@ class Topology {
         }
     }
 
-    // re-order dfs_node using minimum degree
+    // re-order dfs_node using the sparse ordering method, minimum degree by default
     // return list of fill-ins when factorize the matrix
     std::vector<BranchIdx> reorder_node(std::vector<Idx>& dfs_node,
                                         std::vector<std::pair<GraphIdx, GraphIdx>> const& back_edges) {
@@ -334,30 +401,38 @@ class Topology {
             return fill_in;
         }
 
-        std::map<Idx, std::vector<Idx>> unique_nearest_neighbours;
+        // the cyclic nodes are numbered in ascending order in the ordering graph
+        std::ranges::sort(cyclic_node);
+        auto const local_node = [&cyclic_node](Idx node) {
+            return static_cast<Idx>(std::ranges::lower_bound(cyclic_node, node) - cyclic_node.begin());
+        };
+        std::vector<std::pair<Idx, Idx>> edges;
+        edges.reserve(cyclic_node.size() + back_edges.size());
         for (Idx const node_idx : cyclic_node) {
             auto predecessor = static_cast<Idx>(predecessors_[node_idx]);
             if (predecessor != node_idx) {
-                unique_nearest_neighbours[node_idx] = {predecessor};
+                edges.emplace_back(local_node(node_idx), local_node(predecessor));
             }
         }
         for (auto const& [from_node, to_node] : back_edges) {
-            auto const from{static_cast<Idx>(from_node)};
-            auto const to{static_cast<Idx>(to_node)};
-            if (!detail::in_graph(std::pair{from, to}, unique_nearest_neighbours)) {
-                unique_nearest_neighbours[from].push_back(to);
-            }
+            edges.emplace_back(local_node(static_cast<Idx>(from_node)), local_node(static_cast<Idx>(to_node)));
         }
 
-        auto [reordered, fills] = minimum_degree_ordering(std::move(unique_nearest_neighbours));
+        auto ordering_graph = make_ordering_graph(std::ssize(cyclic_node), edges);
+        auto const ordering = sparse_ordering_cache_ != nullptr
+                                  ? sparse_ordering(std::move(ordering_graph), sparse_ordering_method_,
+                                                    *sparse_ordering_cache_)
+                                  : std::make_shared<SparseOrderingCache::Ordering const>(
+                                        sparse_ordering(ordering_graph, sparse_ordering_method_));
+        auto const& [reordered, fills] = *ordering;
 
         const auto n_non_cyclic_nodes = static_cast<Idx>(dfs_node.size());
-        std::map<Idx, Idx> permuted_node_indices;
+        IdxVector permuted_node_indices(reordered.size());
         for (Idx const idx : IdxRange{std::ssize(reordered)}) {
             permuted_node_indices[reordered[idx]] = n_non_cyclic_nodes + idx;
+            dfs_node.push_back(cyclic_node[reordered[idx]]);
         }
 
-        dfs_node.insert(dfs_node.end(), reordered.begin(), reordered.end());
         for (auto [from, to] : fills) {
             auto from_reordered = permuted_node_indices[from];
             auto to_reordered = permuted_node_indices[to];
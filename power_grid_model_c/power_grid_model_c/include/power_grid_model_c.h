@@ -30,6 +30,7 @@
 #include "power_grid_model_c/basics.h"
 #include "power_grid_model_c/buffer.h"
 #include "power_grid_model_c/dataset.h"
+#include "power_grid_model_c/executor.h"
 #include "power_grid_model_c/handle.h"
 #include "power_grid_model_c/meta_data.h"
 #include "power_grid_model_c/model.h"
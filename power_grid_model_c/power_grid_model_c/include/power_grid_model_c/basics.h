@@ -85,6 +85,14 @@ typedef struct PGM_Handle PGM_Handle;
  */
 typedef struct PGM_Options PGM_Options;
 
+/**
+ * @brief Opaque struct for the executor class.
+ *
+ * The executor class is a pool of worker threads for batch calculations, which is kept alive between calculations.
+ *
+ */
+typedef struct PGM_Executor PGM_Executor;
+
 /**
  * @brief Opaque struct for the attribute meta class.
  *
@@ -234,6 +242,82 @@ enum PGM_TapChangingStrategy {
         4, /**< adjust tap position automatically; optimize for any value in the voltage band; binary search */
 };
 
+/**
+ * @brief Enumeration of the strategies to distribute the scenarios of a batch calculation over the threads.
+ *
+ */
+enum PGM_BatchScheduling {
+    PGM_batch_scheduling_static = 0, /**< fixed stride assignment of scenarios to threads */
+    PGM_batch_scheduling_dynamic =
+        1, /**< threads pull chunks of scenarios on demand; balances scenarios with uneven run times */
+};
+
+/**
+ * @brief Enumeration of the orders in which the scenarios of a batch calculation are calculated.
+ *
+ */
+enum PGM_ScenarioOrdering {
+    PGM_scenario_ordering_input = 0, /**< calculate the scenarios in the order of the update data */
+    PGM_scenario_ordering_group_by_topology =
+        1, /**< calculate scenarios with the same topology changes consecutively, to reuse the topology */
+};
+
+/**
+ * @brief Enumeration of the ways in which a batch calculation goes from one scenario to the next.
+ *
+ */
+enum PGM_ScenarioTransition {
+    PGM_scenario_transition_restore = 0, /**< restore the original model before applying the next scenario */
+    PGM_scenario_transition_delta =
+        1, /**< apply only the difference between consecutive scenarios that update the same components */
+};
+
+/**
+ * @brief Enumeration of the initial voltages of the iterative power flow methods.
+ *
+ */
+enum PGM_PowerFlowInitialization {
+    PGM_power_flow_initialization_default = 0,    /**< flat start or linear initial guess, depending on the method */
+    PGM_power_flow_initialization_warm_start = 1, /**< previous solution of the same thread, if it converges */
+};
+
+/**
+ * @brief Enumeration of the ways to calculate branch outages.
+ *
+ */
+enum PGM_ContingencyMode {
+    PGM_contingency_mode_full_rebuild = 0, /**< rebuild the topology and factorize the matrices again */
+    PGM_contingency_mode_low_rank_update =
+        1, /**< keep the topology and factorization of the base case, apply outages as low-rank updates */
+};
+
+/**
+ * @brief Enumeration of the precisions of the sparse LU factorization.
+ *
+ */
+enum PGM_FactorizationPrecision {
+    PGM_factorization_precision_double = 0, /**< factorize in double precision */
+    PGM_factorization_precision_mixed = 1,  /**< factorize in single precision and refine to double precision */
+};
+
+/**
+ * @brief Enumeration of the ways to solve the independent islands of one calculation.
+ *
+ */
+enum PGM_IslandParallelism {
+    PGM_island_parallelism_sequential = 0, /**< solve the islands one after another */
+    PGM_island_parallelism_parallel = 1,   /**< solve the islands concurrently, largest island first */
+};
+
+/**
+ * @brief Enumeration of the ways to solve the power flow of batch scenarios that share the topology.
+ *
+ */
+enum PGM_BatchLockstep {
+    PGM_batch_lockstep_disabled = 0, /**< solve every scenario on its own */
+    PGM_batch_lockstep_enabled = 1,  /**< solve consecutive scenarios of a thread with the same topology at once */
+};
+
 /**
  * @brief Enumeration of experimental features.
  *
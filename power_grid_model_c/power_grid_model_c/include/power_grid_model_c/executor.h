@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+/**
+ * @brief header file which includes executor functions
+ *
+ */
+
+#pragma once
+#ifndef POWER_GRID_MODEL_C_EXECUTOR_H
+#define POWER_GRID_MODEL_C_EXECUTOR_H
+
+#include "basics.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Create a persistent executor for batch calculations.
+ *
+ * The executor starts its worker threads once and keeps them alive until it is destroyed.
+ * Attach it to the calculation options with PGM_set_executor() to run batch calculations on it.
+ * Each worker also keeps its private copy of the model between calculations, which avoids copying the model for every
+ * batch calculation. The copies are released when the executor is destroyed.
+ *
+ * An executor can be shared by multiple models and calling threads. Calculations on the same executor are run one
+ * after another.
+ *
+ * @param handle
+ * @param n_threads Number of worker threads. Use 0 for the number of machine available threads.
+ * @return The pointer to the executor instance. Should be freed by PGM_destroy_executor().
+ *     Returns NULL if errors occured (check the handle for error information).
+ */
+PGM_API PGM_Executor* PGM_create_executor(PGM_Handle* handle, PGM_Idx n_threads) PGM_NOEXCEPT;
+
+/**
+ * @brief Free an executor instance.
+ *
+ * No calculation may be running on the executor.
+ *
+ * @param executor The pointer to the executor instance created by PGM_create_executor().
+ */
+PGM_API void PGM_destroy_executor(PGM_Executor* executor) PGM_NOEXCEPT;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -28,6 +28,15 @@ extern "C" {
  *   - err_tol: 1e-8
  *   - max_iter: 20
  *   - threading: -1
+ *   - batch_scheduling: PGM_batch_scheduling_static
+ *   - scenario_ordering: PGM_scenario_ordering_input
+ *   - scenario_transition: PGM_scenario_transition_restore
+ *   - power_flow_initialization: PGM_power_flow_initialization_default
+ *   - contingency_mode: PGM_contingency_mode_full_rebuild
+ *   - factorization_precision: PGM_factorization_precision_double
+ *   - island_parallelism: PGM_island_parallelism_sequential
+ *   - batch_lockstep: PGM_batch_lockstep_disabled
+ *   - executor: NULL
  *   - short_circuit_voltage_scaling: PGM_short_circuit_voltage_scaling_maximum
  *   - experimental_features: PGM_experimental_features_disabled
  *
@@ -103,6 +112,137 @@ PGM_API void PGM_set_max_iter(PGM_Handle* handle, PGM_Options* opt, PGM_Idx max_
  */
 PGM_API void PGM_set_threading(PGM_Handle* handle, PGM_Options* opt, PGM_Idx threading) PGM_NOEXCEPT;
 
+/**
+ * @brief Specify how the scenarios are distributed over the threads. Only applicable for multi-threaded batch
+ * calculation.
+ *
+ * The static strategy gives every thread a fixed stride of scenarios, so the scenarios handled by each thread are
+ * reproducible. The dynamic strategy lets threads pull chunks of scenarios on demand, which keeps all threads busy when
+ * the calculation time differs a lot between scenarios.
+ *
+ * @param handle
+ * @param opt The pointer to the option instance.
+ * @param batch_scheduling See #PGM_BatchScheduling .
+ */
+PGM_API void PGM_set_batch_scheduling(PGM_Handle* handle, PGM_Options* opt, PGM_Idx batch_scheduling) PGM_NOEXCEPT;
+
+/**
+ * @brief Specify a persistent executor to run batch calculations on. Only applicable for batch calculation.
+ *
+ * If an executor is set, the batch calculation runs on the worker threads of the executor instead of creating new
+ * threads. The workers keep their private copy of the model between calculations, as long as the model is not updated
+ * in the meantime. The threading option still applies, but is limited by the number of threads of the executor.
+ *
+ * The option does not take ownership. The executor must outlive all calculations that use it.
+ *
+ * @param handle
+ * @param opt The pointer to the option instance.
+ * @param executor The pointer to the executor created by PGM_create_executor(), or NULL to not use an executor.
+ */
+PGM_API void PGM_set_executor(PGM_Handle* handle, PGM_Options* opt, PGM_Executor* executor) PGM_NOEXCEPT;
+
+/**
+ * @brief Specify the order in which the scenarios of a batch calculation are calculated.
+ *
+ * Grouping the scenarios by their topology changes (switching statuses) lets every thread build each distinct topology
+ * only once. The results are always written to the position of the scenario in the update data.
+ *
+ * @param handle
+ * @param opt The pointer to the option instance.
+ * @param scenario_ordering See #PGM_ScenarioOrdering .
+ */
+PGM_API void PGM_set_scenario_ordering(PGM_Handle* handle, PGM_Options* opt, PGM_Idx scenario_ordering) PGM_NOEXCEPT;
+
+/**
+ * @brief Specify how a batch calculation goes from one scenario to the next.
+ *
+ * With the delta transition, consecutive scenarios of a thread that update the same components (e.g. a time series)
+ * are applied on top of each other: only the attributes that differ are updated, and only the components of which the
+ * state actually changes are marked as changed. Other scenarios restore the original model first.
+ *
+ * @param handle
+ * @param opt The pointer to the option instance.
+ * @param scenario_transition See #PGM_ScenarioTransition .
+ */
+PGM_API void PGM_set_scenario_transition(PGM_Handle* handle, PGM_Options* opt,
+                                         PGM_Idx scenario_transition) PGM_NOEXCEPT;
+
+/**
+ * @brief Specify the initial voltages of the iterative power flow methods.
+ *
+ * With the warm start, the Newton-Raphson and iterative current methods start from the solution of the previous power
+ * flow calculation of the same thread on the same island, e.g. the previous scenario of a time series batch. If that
+ * does not converge, the calculation is repeated with the default initialization. The results are the same within the
+ * error tolerance.
+ *
+ * @param handle
+ * @param opt The pointer to the option instance.
+ * @param power_flow_initialization See #PGM_PowerFlowInitialization .
+ */
+PGM_API void PGM_set_power_flow_initialization(PGM_Handle* handle, PGM_Options* opt,
+                                               PGM_Idx power_flow_initialization) PGM_NOEXCEPT;
+
+/**
+ * @brief Specify how branch outages are calculated, e.g. the scenarios of an N-1 contingency analysis.
+ *
+ * With the low-rank update, a power flow or short circuit calculation in which branches are disconnected compared to
+ * the previously built topology keeps that topology. The disconnected branches have zero admittance, and the linear and
+ * iterative current power flow and the short circuit solvers apply them as a low-rank update of the factorization of
+ * the previous matrix, instead of factorizing again. If the outages split the grid or other switching states change,
+ * the topology is rebuilt as usual. The results are the same.
+ *
+ * @param handle
+ * @param opt The pointer to the option instance.
+ * @param contingency_mode See #PGM_ContingencyMode .
+ */
+PGM_API void PGM_set_contingency_mode(PGM_Handle* handle, PGM_Options* opt, PGM_Idx contingency_mode) PGM_NOEXCEPT;
+
+/**
+ * @brief Specify the precision of the sparse LU factorization of the state estimation.
+ *
+ * With mixed precision, the gain matrix is factorized in single precision, which halves the memory traffic of the
+ * factorization of large grids. The solution is then refined to double precision with the residual of the original
+ * matrix. If the refinement does not converge, or if the matrix needs pivot perturbation, the matrix is factorized in
+ * double precision instead. The results are the same within the error tolerance.
+ *
+ * @param handle
+ * @param opt The pointer to the option instance.
+ * @param factorization_precision See #PGM_FactorizationPrecision .
+ */
+PGM_API void PGM_set_factorization_precision(PGM_Handle* handle, PGM_Options* opt,
+                                             PGM_Idx factorization_precision) PGM_NOEXCEPT;
+
+/**
+ * @brief Specify whether the independent islands of a calculation are solved in parallel.
+ *
+ * The admittance matrices and solvers of the islands are then also built in parallel when the topology changes. The
+ * number of threads follows the threading setting. In a multi-threaded batch calculation, the islands of a scenario
+ * only use the threads that are not already taken by the scenarios themselves.
+ *
+ * @param handle
+ * @param opt The pointer to the option instance.
+ * @param island_parallelism See #PGM_IslandParallelism .
+ */
+PGM_API void PGM_set_island_parallelism(PGM_Handle* handle, PGM_Options* opt, PGM_Idx island_parallelism) PGM_NOEXCEPT;
+
+/**
+ * @brief Specify whether the power flow of batch scenarios that share the topology is solved in lockstep.
+ *
+ * With the lockstep, every thread of a batch power flow calculation takes up to four consecutive scenarios at once. The
+ * scenarios that have the same topology and branch parameters as the first one, e.g. the scenarios of a time series,
+ * share its admittance matrix: the linear and Newton-Raphson methods then factorize and solve their matrices together,
+ * which vectorizes over the scenarios. The other scenarios, and scenarios of which the lockstep calculation fails, are
+ * calculated on their own. The results are the same within the error tolerance.
+ *
+ * The lockstep is only used for power flow calculations with the linear or Newton-Raphson method, without tap changing
+ * and with the default initialization.
+ *
+ * @param handle
+ * @param opt The pointer to the option instance.
+ * @param batch_lockstep See #PGM_BatchLockstep .
+ */
+PGM_API void PGM_set_batch_lockstep(PGM_Handle* handle, PGM_Options* opt, PGM_Idx batch_lockstep) PGM_NOEXCEPT;
+
 /**
  * @brief Specify the voltage scaling min/max for short circuit calculations
  *
@@ -0,0 +1,41 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#define PGM_DLL_EXPORTS
+
+#include "forward_declarations.hpp"
+#include "handle.hpp"
+#include "input_sanitization.hpp"
+#include "safe_memory_handling.hpp"
+
+#include "power_grid_model_c/basics.h"
+#include "power_grid_model_c/executor.h"
+
+#include <power_grid_model/common/common.hpp>
+#include <power_grid_model/common/exception.hpp>
+#include <power_grid_model/job_executor.hpp>
+
+#include <string>
+
+namespace {
+using namespace power_grid_model;
+
+using power_grid_model_c::call_with_catch;
+using power_grid_model_c::cast_to_c;
+using power_grid_model_c::cast_to_cpp;
+using power_grid_model_c::create;
+using power_grid_model_c::destroy;
+} // namespace
+
+PGM_Executor* PGM_create_executor(PGM_Handle* handle, PGM_Idx n_threads) noexcept {
+    return call_with_catch(handle, [n_threads] {
+        if (n_threads < 0) {
+            throw InvalidArguments{"PGM_create_executor", InvalidArguments::TypeValuePair{
+                                                              .name = "n_threads", .value = std::to_string(n_threads)}};
+        }
+        return cast_to_c(create<JobExecutor>(n_threads));
+    });
+}
+
+void PGM_destroy_executor(PGM_Executor* executor) noexcept { destroy(cast_to_cpp(executor)); }
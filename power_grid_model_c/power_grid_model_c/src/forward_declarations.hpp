@@ -16,6 +16,7 @@
 namespace power_grid_model {
 
 class MainModel;
+class JobExecutor;
 
 namespace meta_data {
 
@@ -62,6 +63,7 @@ template <class first_map, class... rest_maps> struct type_mapping_list_impl<fir
 
 using type_mapping_list = type_mapping_list_impl<
     c_cpp_type_map<PGM_PowerGridModel, power_grid_model::MainModel>,
+    c_cpp_type_map<PGM_Executor, power_grid_model::JobExecutor>,
     c_cpp_type_map<PGM_MetaAttribute, power_grid_model::meta_data::MetaAttribute>,
     c_cpp_type_map<PGM_MetaComponent, power_grid_model::meta_data::MetaComponent>,
     c_cpp_type_map<PGM_MetaDataset, power_grid_model::meta_data::MetaDataset>,
@@ -17,16 +17,21 @@
 #include <power_grid_model/common/common.hpp>
 #include <power_grid_model/common/enum.hpp>
 #include <power_grid_model/common/exception.hpp>
+#include <power_grid_model/job_dispatch.hpp>
+#include <power_grid_model/job_executor.hpp>
 #include <power_grid_model/main_model.hpp>
 #include <power_grid_model/main_model_fwd.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <concepts>
 #include <exception>
 #include <ranges>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace {
 using namespace power_grid_model;
@@ -166,6 +171,36 @@ constexpr auto get_optimizer_strategy(PGM_Options const& opt) {
     }
 }
 
+constexpr auto get_batch_scheduling(PGM_Options const& opt) {
+    return safe_enum<BatchScheduling>(opt.batch_scheduling);
+}
+
+constexpr auto get_scenario_ordering(PGM_Options const& opt) {
+    return safe_enum<ScenarioOrdering>(opt.scenario_ordering);
+}
+
+constexpr auto get_scenario_transition(PGM_Options const& opt) {
+    return safe_enum<ScenarioTransition>(opt.scenario_transition);
+}
+
+constexpr auto get_power_flow_initialization(PGM_Options const& opt) {
+    return safe_enum<PowerFlowInitialization>(opt.power_flow_initialization);
+}
+
+constexpr auto get_contingency_mode(PGM_Options const& opt) {
+    return safe_enum<ContingencyMode>(opt.contingency_mode);
+}
+
+constexpr auto get_factorization_precision(PGM_Options const& opt) {
+    return safe_enum<FactorizationPrecision>(opt.factorization_precision);
+}
+
+constexpr auto get_island_parallelism(PGM_Options const& opt) {
+    return safe_enum<IslandParallelism>(opt.island_parallelism);
+}
+
+constexpr auto get_batch_lockstep(PGM_Options const& opt) { return safe_enum<BatchLockstep>(opt.batch_lockstep); }
+
 constexpr auto get_short_circuit_voltage_scaling(PGM_Options const& opt) {
     return safe_enum<ShortCircuitVoltageScaling>(opt.short_circuit_voltage_scaling);
 }
@@ -179,6 +214,15 @@ constexpr auto extract_calculation_options(PGM_Options const& opt) {
                               .err_tol = opt.err_tol,
                               .max_iter = opt.max_iter,
                               .threading = opt.threading,
+                              .batch_scheduling = get_batch_scheduling(opt),
+                              .scenario_ordering = get_scenario_ordering(opt),
+                              .scenario_transition = get_scenario_transition(opt),
+                              .power_flow_initialization = get_power_flow_initialization(opt),
+                              .contingency_mode = get_contingency_mode(opt),
+                              .factorization_precision = get_factorization_precision(opt),
+                              .executor = cast_to_cpp(opt.executor),
+                              .island_parallelism = get_island_parallelism(opt),
+                              .batch_lockstep = get_batch_lockstep(opt),
                               .short_circuit_voltage_scaling = get_short_circuit_voltage_scaling(opt)};
 }
 
@@ -301,30 +345,65 @@ void calculate_multi_dimensional_impl(MainModel& model, MainModel::Options const
     Idx const first_batch_size = safe_batch_dataset.batch_size();
     Idx const stride_size = get_stride_size(batch_dataset);
 
-    PGM_Handle local_handle{};
+    // the slices of the first dimension are calculated in parallel; the remaining dimensions get the threads that
+    // are left
+    Idx const n_thread = JobDispatch::n_threads(first_batch_size, options.threading);
+    auto sub_options = options; // copy
+    if (n_thread > 1) {
+        sub_options.threading = JobDispatch::nested_threading(first_batch_size, options.threading);
+        // the warm model copies of an executor are bound to one model, while every slice calculates on a fresh copy
+        sub_options.executor = nullptr;
+    }
 
-    // loop over the first dimension batch
-    for (Idx i = 0; i < first_batch_size; ++i) {
-        // a new handle
-        call_with_catch(
-            &local_handle,
-            [&model, &options, &output_dataset, &safe_batch_dataset, i, stride_size] {
-                // create sliced datasets for the rest of dimensions
-                ConstDataset const single_update_dataset = safe_batch_dataset.get_individual_scenario(i);
-                MutableDataset const sliced_output_dataset =
-                    output_dataset.get_slice_scenario(i * stride_size, (i + 1) * stride_size);
-
-                // create a model copy
-                MainModel local_model{model};
-
-                // apply the update
-                local_model.update_components<permanent_update_t>(single_update_dataset);
-
-                // recursive call
-                calculate_multi_dimensional_impl(local_model, options, sliced_output_dataset,
-                                                 safe_batch_dataset.get_next_cartesian_product_dimension());
-            },
-            MDBatchExceptionHandler{i * stride_size, stride_size});
+    // a handle per slice, so that the slices can report their errors concurrently
+    std::vector<PGM_Handle> local_handles(first_batch_size);
+    std::atomic<Idx> next_slice{0};
+
+    auto const calculate_slices = [&model, &sub_options, &output_dataset, &safe_batch_dataset, &local_handles,
+                                   &next_slice, first_batch_size, stride_size] {
+        for (Idx i = next_slice.fetch_add(1, std::memory_order_relaxed); i < first_batch_size;
+             i = next_slice.fetch_add(1, std::memory_order_relaxed)) {
+            call_with_catch(
+                &local_handles[i],
+                [&model, &sub_options, &output_dataset, &safe_batch_dataset, i, stride_size] {
+                    // create sliced datasets for the rest of dimensions
+                    ConstDataset const single_update_dataset = safe_batch_dataset.get_individual_scenario(i);
+                    MutableDataset const sliced_output_dataset =
+                        output_dataset.get_slice_scenario(i * stride_size, (i + 1) * stride_size);
+
+                    // create a model copy; at most one per thread is alive at any time
+                    MainModel local_model{model};
+
+                    // apply the update
+                    local_model.update_components<permanent_update_t>(single_update_dataset);
+
+                    // recursive call
+                    calculate_multi_dimensional_impl(local_model, sub_options, sliced_output_dataset,
+                                                     safe_batch_dataset.get_next_cartesian_product_dimension());
+                },
+                MDBatchExceptionHandler{i * stride_size, stride_size});
+        }
+    };
+
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(n_thread - 1);
+        for (Idx thread_number = 1; thread_number < n_thread; ++thread_number) {
+            threads.emplace_back(calculate_slices);
+        }
+        calculate_slices();
+    } // join
+
+    // collect the errors of all slices in scenario order
+    PGM_Handle local_handle{};
+    for (auto& slice_handle : local_handles) {
+        if (slice_handle.err_code == PGM_no_error) {
+            continue;
+        }
+        local_handle.err_code = slice_handle.err_code;
+        local_handle.err_msg = std::move(slice_handle.err_msg);
+        append_range(local_handle.failed_scenarios, by_ref(slice_handle.failed_scenarios));
+        append_range(local_handle.batch_errs, by_ref(slice_handle.batch_errs));
     }
 
     if (local_handle.err_code != PGM_no_error) {
@@ -44,6 +44,39 @@ void PGM_set_max_iter(PGM_Handle* handle, PGM_Options* opt, PGM_Idx max_iter) no
 void PGM_set_threading(PGM_Handle* handle, PGM_Options* opt, PGM_Idx threading) noexcept {
     call_with_catch(handle, [opt, threading] { safe_ptr_get(opt).threading = threading; });
 }
+void PGM_set_batch_scheduling(PGM_Handle* handle, PGM_Options* opt, PGM_Idx batch_scheduling) noexcept {
+    call_with_catch(handle, [opt, batch_scheduling] { safe_ptr_get(opt).batch_scheduling = batch_scheduling; });
+}
+void PGM_set_executor(PGM_Handle* handle, PGM_Options* opt, PGM_Executor* executor) noexcept {
+    call_with_catch(handle, [opt, executor] { safe_ptr_get(opt).executor = executor; });
+}
+void PGM_set_scenario_ordering(PGM_Handle* handle, PGM_Options* opt, PGM_Idx scenario_ordering) noexcept {
+    call_with_catch(handle, [opt, scenario_ordering] { safe_ptr_get(opt).scenario_ordering = scenario_ordering; });
+}
+void PGM_set_scenario_transition(PGM_Handle* handle, PGM_Options* opt, PGM_Idx scenario_transition) noexcept {
+    call_with_catch(handle,
+                    [opt, scenario_transition] { safe_ptr_get(opt).scenario_transition = scenario_transition; });
+}
+void PGM_set_power_flow_initialization(PGM_Handle* handle, PGM_Options* opt,
+                                       PGM_Idx power_flow_initialization) noexcept {
+    call_with_catch(handle, [opt, power_flow_initialization] {
+        safe_ptr_get(opt).power_flow_initialization = power_flow_initialization;
+    });
+}
+void PGM_set_contingency_mode(PGM_Handle* handle, PGM_Options* opt, PGM_Idx contingency_mode) noexcept {
+    call_with_catch(handle, [opt, contingency_mode] { safe_ptr_get(opt).contingency_mode = contingency_mode; });
+}
+void PGM_set_factorization_precision(PGM_Handle* handle, PGM_Options* opt, PGM_Idx factorization_precision) noexcept {
+    call_with_catch(handle, [opt, factorization_precision] {
+        safe_ptr_get(opt).factorization_precision = factorization_precision;
+    });
+}
+void PGM_set_island_parallelism(PGM_Handle* handle, PGM_Options* opt, PGM_Idx island_parallelism) noexcept {
+    call_with_catch(handle, [opt, island_parallelism] { safe_ptr_get(opt).island_parallelism = island_parallelism; });
+}
+void PGM_set_batch_lockstep(PGM_Handle* handle, PGM_Options* opt, PGM_Idx batch_lockstep) noexcept {
+    call_with_catch(handle, [opt, batch_lockstep] { safe_ptr_get(opt).batch_lockstep = batch_lockstep; });
+}
 void PGM_set_short_circuit_voltage_scaling(PGM_Handle* handle, PGM_Options* opt,
                                            PGM_Idx short_circuit_voltage_scaling) noexcept {
     call_with_catch(handle, [opt, short_circuit_voltage_scaling] {
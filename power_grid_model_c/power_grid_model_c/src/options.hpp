@@ -21,7 +21,16 @@ struct PGM_Options {
     double err_tol{1e-8};
     Idx max_iter{20};
     Idx threading{-1};
+    Idx batch_scheduling{PGM_batch_scheduling_static};
+    Idx scenario_ordering{PGM_scenario_ordering_input};
+    Idx scenario_transition{PGM_scenario_transition_restore};
+    Idx power_flow_initialization{PGM_power_flow_initialization_default};
+    Idx contingency_mode{PGM_contingency_mode_full_rebuild};
+    Idx factorization_precision{PGM_factorization_precision_double};
+    Idx island_parallelism{PGM_island_parallelism_sequential};
+    Idx batch_lockstep{PGM_batch_lockstep_disabled};
     Idx short_circuit_voltage_scaling{PGM_short_circuit_voltage_scaling_maximum};
     Idx tap_changing_strategy{PGM_tap_changing_strategy_disabled};
     Idx experimental_features{PGM_experimental_features_disabled};
+    PGM_Executor* executor{nullptr};
 };
@@ -11,6 +11,7 @@
 #include "power_grid_model_cpp/basics.hpp"
 #include "power_grid_model_cpp/buffer.hpp"
 #include "power_grid_model_cpp/dataset.hpp"
+#include "power_grid_model_cpp/executor.hpp"
 #include "power_grid_model_cpp/handle.hpp"
 #include "power_grid_model_cpp/meta_data.hpp"
 #include "power_grid_model_cpp/model.hpp"
@@ -39,6 +39,7 @@ using RawMutableDataset = PGM_MutableDataset;
 using RawWritableDataset = PGM_WritableDataset;
 using RawDatasetInfo = PGM_DatasetInfo;
 using RawOptions = PGM_Options;
+using RawExecutor = PGM_Executor;
 using RawDeserializer = PGM_Deserializer;
 using RawSerializer = PGM_Serializer;
 
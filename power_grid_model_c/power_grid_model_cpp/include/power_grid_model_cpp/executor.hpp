@@ -0,0 +1,28 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#ifndef POWER_GRID_MODEL_CPP_EXECUTOR_HPP
+#define POWER_GRID_MODEL_CPP_EXECUTOR_HPP
+
+#include "basics.hpp"
+#include "handle.hpp"
+
+#include "power_grid_model_c/executor.h"
+
+namespace power_grid_model_cpp {
+class Executor {
+  public:
+    explicit Executor(Idx n_threads = 0) : executor_{handle_.call_with(PGM_create_executor, n_threads)} {}
+
+    RawExecutor* get() { return executor_.get(); }
+    RawExecutor const* get() const { return executor_.get(); }
+
+  private:
+    Handle handle_{};
+    detail::UniquePtr<RawExecutor, &PGM_destroy_executor> executor_;
+};
+} // namespace power_grid_model_cpp
+
+#endif // POWER_GRID_MODEL_CPP_EXECUTOR_HPP
@@ -7,6 +7,7 @@
 #define POWER_GRID_MODEL_CPP_OPTIONS_HPP
 
 #include "basics.hpp"
+#include "executor.hpp"
 #include "handle.hpp"
 
 #include "power_grid_model_c/options.h"
@@ -31,6 +32,41 @@ class Options {
 
     void set_threading(Idx threading) { handle_.call_with(PGM_set_threading, get(), threading); }
 
+    void set_batch_scheduling(Idx batch_scheduling) {
+        handle_.call_with(PGM_set_batch_scheduling, get(), batch_scheduling);
+    }
+
+    // the executor must outlive all calculations that use these options
+    void set_executor(Executor& executor) { handle_.call_with(PGM_set_executor, get(), executor.get()); }
+
+    void reset_executor() { handle_.call_with(PGM_set_executor, get(), nullptr); }
+
+    void set_scenario_ordering(Idx scenario_ordering) {
+        handle_.call_with(PGM_set_scenario_ordering, get(), scenario_ordering);
+    }
+
+    void set_scenario_transition(Idx scenario_transition) {
+        handle_.call_with(PGM_set_scenario_transition, get(), scenario_transition);
+    }
+
+    void set_power_flow_initialization(Idx power_flow_initialization) {
+        handle_.call_with(PGM_set_power_flow_initialization, get(), power_flow_initialization);
+    }
+
+    void set_contingency_mode(Idx contingency_mode) {
+        handle_.call_with(PGM_set_contingency_mode, get(), contingency_mode);
+    }
+
+    void set_factorization_precision(Idx factorization_precision) {
+        handle_.call_with(PGM_set_factorization_precision, get(), factorization_precision);
+    }
+
+    void set_island_parallelism(Idx island_parallelism) {
+        handle_.call_with(PGM_set_island_parallelism, get(), island_parallelism);
+    }
+
+    void set_batch_lockstep(Idx batch_lockstep) { handle_.call_with(PGM_set_batch_lockstep, get(), batch_lockstep); }
+
     void set_short_circuit_voltage_scaling(Idx short_circuit_voltage_scaling) {
         handle_.call_with(PGM_set_short_circuit_voltage_scaling, get(), short_circuit_voltage_scaling);
     }
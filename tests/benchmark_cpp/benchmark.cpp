@@ -8,11 +8,19 @@
 #include <power_grid_model/common/calculation_info.hpp>
 #include <power_grid_model/common/common.hpp>
 #include <power_grid_model/common/timer.hpp>
+#include <power_grid_model/link_solver.hpp>
 #include <power_grid_model/main_model.hpp>
 #include <power_grid_model/math_solver/math_solver.hpp>
+#include <power_grid_model/sparse_ordering.hpp>
+#include <power_grid_model/topology.hpp>
 
+#include <boost/graph/compressed_sparse_row_graph.hpp>
+#include <boost/graph/depth_first_search.hpp>
+
+#include <chrono>
 #include <iomanip>
 #include <iostream>
+#include <random>
 
 namespace power_grid_model::benchmark {
 namespace {
@@ -234,6 +242,189 @@ struct PowerGridBenchmark {
     std::unique_ptr<MainModel> main_model;
     FictionalGridGenerator generator;
 };
+
+// fill-in and runtime of the sparse ordering methods on square meshed grids of side * side nodes
+// the exact minimum degree ordering is only run up to max_side_minimum_degree, as it is too slow beyond
+void run_sparse_ordering_benchmark(std::vector<Idx> const& sides, Idx max_side_minimum_degree) {
+    using enum SparseOrderingMethod;
+    using namespace std::string_literals;
+
+    for (Idx const side : sides) {
+        std::vector<std::pair<Idx, Idx>> edges;
+        for (Idx row = 0; row != side; ++row) {
+            for (Idx col = 0; col != side; ++col) {
+                Idx const vertex = row * side + col;
+                if (col + 1 != side) {
+                    edges.emplace_back(vertex, vertex + 1);
+                }
+                if (row + 1 != side) {
+                    edges.emplace_back(vertex, vertex + side);
+                }
+            }
+        }
+        OrderingGraph const graph = make_ordering_graph(side * side, edges);
+        std::cout << std::format("============= Sparse ordering: meshed grid of {} nodes =============\n",
+                                 graph.n_vertices());
+
+        for (auto const& [method, name] : {std::pair{minimum_degree, "Minimum degree"s},
+                                           std::pair{approximate_minimum_degree, "Approximate minimum degree"s},
+                                           std::pair{nested_dissection, "Nested dissection"s}}) {
+            if (method == minimum_degree && side > max_side_minimum_degree) {
+                continue;
+            }
+            auto const start = std::chrono::steady_clock::now();
+            auto const [order, fills] = sparse_ordering(graph, method);
+            auto const stop = std::chrono::steady_clock::now();
+            std::cout << std::format("{}: {} fill-ins, {:.3f} ms\n", name, fills.size(),
+                                     std::chrono::duration<double, std::milli>(stop - start).count());
+        }
+        std::cout << '\n';
+    }
+}
+
+// depth first search of the topology on the flat graph, against the boost graph that was used before
+// the graph is a random tree of n_node nodes with one extra branch per 100 nodes, both directions per branch
+void run_graph_search_benchmark(Idx n_node) {
+    using topology::detail::GraphIdx;
+    struct Edge {
+        double phase_shift;
+    };
+    struct Vertex {
+        boost::default_color_type color;
+    };
+    using BoostGraph = boost::compressed_sparse_row_graph<boost::directedS, Vertex, Edge, boost::no_property,
+                                                          GraphIdx, GraphIdx>;
+    using FlatGraph = topology::detail::CompressedGraph<Edge>;
+
+    std::mt19937_64 generator{0};
+    std::vector<std::pair<GraphIdx, GraphIdx>> edges;
+    std::vector<Edge> edge_values;
+    auto const add_branch = [&edges, &edge_values](GraphIdx from, GraphIdx to) {
+        edges.emplace_back(from, to);
+        edge_values.push_back({0.1});
+        edges.emplace_back(to, from);
+        edge_values.push_back({-0.1});
+    };
+    for (GraphIdx node = 1; node != static_cast<GraphIdx>(n_node); ++node) {
+        add_branch(std::uniform_int_distribution<GraphIdx>{0, node - 1}(generator), node);
+    }
+    for (Idx branch = 0; branch != n_node / 100; ++branch) {
+        std::uniform_int_distribution<GraphIdx> node_distribution{0, static_cast<GraphIdx>(n_node) - 1};
+        add_branch(node_distribution(generator), node_distribution(generator));
+    }
+
+    // the same work as the topology visitor: phase shift, predecessors, back edges and the discovered nodes
+    struct SearchResult {
+        std::vector<double> phase_shift;
+        std::vector<GraphIdx> predecessors;
+        std::vector<std::pair<GraphIdx, GraphIdx>> back_edges;
+        std::vector<Idx> dfs_node;
+
+        explicit SearchResult(Idx n) : phase_shift(n, 0.0), predecessors(n) {
+            std::iota(predecessors.begin(), predecessors.end(), GraphIdx{0});
+        }
+        void tree_edge(GraphIdx source, GraphIdx target, double phase_shift_edge) {
+            phase_shift[target] = phase_shift[source] + phase_shift_edge;
+            predecessors[target] = source;
+        }
+        void back_edge(GraphIdx source, GraphIdx target) {
+            if (predecessors[source] != target) {
+                back_edges.emplace_back(source, target);
+            }
+        }
+    };
+    struct BoostVisitor : boost::dfs_visitor<> {
+        SearchResult* result;
+        void tree_edge(BoostGraph::edge_descriptor e, BoostGraph const& g) const {
+            result->tree_edge(boost::source(e, g), boost::target(e, g), g[e].phase_shift);
+        }
+        void back_edge(BoostGraph::edge_descriptor e, BoostGraph const& g) const {
+            result->back_edge(boost::source(e, g), boost::target(e, g));
+        }
+        void discover_vertex(GraphIdx u, BoostGraph const& /* g */) const {
+            result->dfs_node.push_back(static_cast<Idx>(u));
+        }
+    };
+    struct FlatVisitor {
+        SearchResult* result;
+        void tree_edge(GraphIdx source, GraphIdx target, GraphIdx e, FlatGraph const& g) const {
+            result->tree_edge(source, target, g[e].phase_shift);
+        }
+        void back_edge(GraphIdx source, GraphIdx target, GraphIdx /* e */, FlatGraph const& /* g */) const {
+            result->back_edge(source, target);
+        }
+        void discover_vertex(GraphIdx u, FlatGraph const& /* g */) const {
+            result->dfs_node.push_back(static_cast<Idx>(u));
+        }
+    };
+
+    std::cout << std::format("============= Graph search: {} nodes =============\n", n_node);
+    auto const start_boost = std::chrono::steady_clock::now();
+    SearchResult boost_result{n_node};
+    {
+        BoostGraph graph{boost::edges_are_unsorted_multi_pass, edges.cbegin(), edges.cend(), edge_values.cbegin(),
+                         static_cast<GraphIdx>(n_node)};
+        for (GraphIdx node = 0; node != static_cast<GraphIdx>(n_node); ++node) {
+            graph[node].color = boost::default_color_type::white_color;
+        }
+        BoostVisitor visitor{};
+        visitor.result = &boost_result;
+        boost::depth_first_visit(graph, GraphIdx{0}, visitor, boost::get(&Vertex::color, graph));
+    }
+    auto const stop_boost = std::chrono::steady_clock::now();
+
+    auto const start_flat = std::chrono::steady_clock::now();
+    SearchResult flat_result{n_node};
+    {
+        FlatGraph const graph{static_cast<GraphIdx>(n_node), edges, edge_values};
+        std::vector<topology::detail::VertexColor> color(n_node, topology::detail::VertexColor::white);
+        std::vector<std::pair<GraphIdx, GraphIdx>> stack;
+        topology::detail::depth_first_visit(graph, GraphIdx{0}, color, stack, FlatVisitor{&flat_result});
+    }
+    auto const stop_flat = std::chrono::steady_clock::now();
+
+    std::cout << std::format("Boost graph: {:.3f} ms\n",
+                             std::chrono::duration<double, std::milli>(stop_boost - start_boost).count());
+    std::cout << std::format("Flat graph: {:.3f} ms\n",
+                             std::chrono::duration<double, std::milli>(stop_flat - start_flat).count());
+    std::cout << std::format("Same visit order: {}\n\n", boost_result.dfs_node == flat_result.dfs_node &&
+                                                              boost_result.back_edges == flat_result.back_edges);
+}
+
+// load distribution over the links of one large topological node, e.g. a substation with many bus couplers
+// the links form a random tree of n_node nodes with one extra link per 1000 nodes, each of which closes a loop
+void run_link_solver_benchmark(Idx n_node) {
+    std::mt19937_64 generator{0};
+    std::vector<BranchIdx> edges;
+    for (Idx node = 1; node != n_node; ++node) {
+        edges.push_back({std::uniform_int_distribution<Idx>{0, node - 1}(generator), node});
+    }
+    for (Idx loop = 0; loop != n_node / 1000; ++loop) {
+        std::uniform_int_distribution<Idx> node_distribution{0, n_node - 2};
+        Idx const from_node = node_distribution(generator);
+        edges.push_back({from_node, std::uniform_int_distribution<Idx>{from_node + 1, n_node - 1}(generator)});
+    }
+    DoubleComplex const load{1.0, 0.5};
+    std::vector<DoubleComplex> node_loads(n_node, load);
+    node_loads[0] = -static_cast<double>(n_node - 1) * load;
+
+    std::cout << std::format("============= Link solver: {} links, {} nodes =============\n", edges.size(), n_node);
+    auto const start = std::chrono::steady_clock::now();
+    auto const link_loads = link_solver::compute_loads_link_elements(edges, node_loads);
+    auto const stop = std::chrono::steady_clock::now();
+
+    // the loads of the links should balance the node loads
+    std::vector<DoubleComplex> balance = node_loads;
+    for (auto const& [edge, link_load] : std::views::zip(edges, link_loads)) {
+        balance[edge[0]] -= link_load;
+        balance[edge[1]] += link_load;
+    }
+    double const max_mismatch =
+        std::ranges::max(balance | std::views::transform([](DoubleComplex const& x) { return cabs(x); }));
+    std::cout << std::format("Runtime: {:.3f} ms\n",
+                             std::chrono::duration<double, std::milli>(stop - start).count());
+    std::cout << std::format("Maximum mismatch of the node loads: {:.3e}\n\n", max_mismatch);
+}
 } // namespace
 } // namespace power_grid_model::benchmark
 
@@ -253,6 +444,10 @@ int main(int /* argc */, char** /* argv */) {
     option.n_lv_feeder = 2;
     option.n_connection_per_lv_feeder = 4;
     power_grid_model::Idx constexpr batch_size = 10;
+    std::vector<power_grid_model::Idx> const ordering_sides{10, 20};
+    power_grid_model::Idx constexpr max_side_minimum_degree = 20;
+    power_grid_model::Idx constexpr graph_search_n_node = 10000;
+    std::vector<power_grid_model::Idx> const link_solver_n_nodes{1000, 10000};
 #else
     option.n_node_total_specified = 1500;
     option.n_mv_feeder = 20;
@@ -260,8 +455,23 @@ int main(int /* argc */, char** /* argv */) {
     option.n_lv_feeder = 10;
     option.n_connection_per_lv_feeder = 40;
     power_grid_model::Idx constexpr batch_size = 1000;
+    std::vector<power_grid_model::Idx> const ordering_sides{32, 64, 128, 550};
+    power_grid_model::Idx constexpr max_side_minimum_degree = 64;
+    power_grid_model::Idx constexpr graph_search_n_node = 300000;
+    std::vector<power_grid_model::Idx> const link_solver_n_nodes{10000, 100000};
 #endif
 
+    std::cout << "\n\n##### BENCHMARK SPARSE ORDERING #####\n\n";
+    power_grid_model::benchmark::run_sparse_ordering_benchmark(ordering_sides, max_side_minimum_degree);
+
+    std::cout << "\n\n##### BENCHMARK GRAPH SEARCH #####\n\n";
+    power_grid_model::benchmark::run_graph_search_benchmark(graph_search_n_node);
+
+    std::cout << "\n\n##### BENCHMARK LINK SOLVER #####\n\n";
+    for (power_grid_model::Idx const n_node : link_solver_n_nodes) {
+        power_grid_model::benchmark::run_link_solver_benchmark(n_node);
+    }
+
     std::cout << "\n\n##### BENCHMARK POWER FLOW #####\n\n";
     option.has_measurements = false;
     option.has_fault = false;
@@ -0,0 +1,134 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include <power_grid_model/main_core/island_solve.hpp>
+
+#include <power_grid_model/common/calculation_info.hpp>
+#include <power_grid_model/common/common.hpp>
+#include <power_grid_model/common/logging.hpp>
+
+#include <doctest/doctest.h>
+
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace power_grid_model::main_core {
+
+namespace {
+struct MockIslandOutput {
+    Idx island{-1};
+    std::thread::id thread_id{};
+};
+
+// like a y bus or solver, an island object is not default constructible
+class MockIslandObject {
+  public:
+    explicit MockIslandObject(Idx island) : island_{island} {}
+    Idx island() const { return island_; }
+
+  private:
+    Idx island_;
+};
+} // namespace
+
+TEST_CASE("Test solve islands in parallel") {
+    std::vector<Idx> const island_sizes{3, 10, 1, 10, 7};
+
+    SUBCASE("Largest island first order") {
+        CHECK(largest_island_first_order(island_sizes) == std::vector<Idx>{1, 3, 4, 0, 2});
+        CHECK(largest_island_first_order({}).empty());
+    }
+
+    SUBCASE("Output and logs are in island order") {
+        for (Idx const n_thread : {Idx{1}, Idx{2}, Idx{4}, Idx{8}}) {
+            CAPTURE(n_thread);
+
+            std::mutex mutex;
+            std::vector<Idx> solved_islands;
+            auto const solve_island = [&mutex, &solved_islands](Idx island, Logger& logger) {
+                {
+                    std::scoped_lock const lock{mutex};
+                    solved_islands.push_back(island);
+                }
+                logger.log(LogEvent::math_solver, 1.0);
+                logger.log(LogEvent::max_num_iter, island);
+                return MockIslandOutput{.island = island, .thread_id = std::this_thread::get_id()};
+            };
+
+            CalculationInfo info;
+            auto const output = solve_islands_parallel(solve_island, island_sizes, n_thread, info);
+
+            REQUIRE(output.size() == island_sizes.size());
+            for (Idx island = 0; island != static_cast<Idx>(output.size()); ++island) {
+                CHECK(output[island].island == island);
+            }
+            CHECK(solved_islands.size() == island_sizes.size());
+            CHECK(info.report().at(LogEvent::math_solver) == doctest::Approx(5.0));
+            CHECK(info.report().at(LogEvent::max_num_iter) == doctest::Approx(4.0));
+
+            if (n_thread == 1) {
+                CHECK(solved_islands == std::vector<Idx>{1, 3, 4, 0, 2});
+                for (auto const& island_output : output) {
+                    CHECK(island_output.thread_id == std::this_thread::get_id());
+                }
+            }
+        }
+    }
+
+    SUBCASE("First failing island is rethrown") {
+        auto const solve_island = [](Idx island, Logger& /*logger*/) {
+            if (island == 3 || island == 4) {
+                throw std::runtime_error{std::to_string(island)};
+            }
+            return MockIslandOutput{.island = island, .thread_id = std::this_thread::get_id()};
+        };
+
+        for (Idx const n_thread : {Idx{1}, Idx{4}}) {
+            CAPTURE(n_thread);
+            CalculationInfo info;
+            CHECK_THROWS_WITH_AS(solve_islands_parallel(solve_island, island_sizes, n_thread, info), "3",
+                                 std::runtime_error);
+        }
+    }
+
+    SUBCASE("No islands") {
+        CalculationInfo info;
+        auto const solve_island = [](Idx island, Logger& /*logger*/) {
+            return MockIslandOutput{.island = island, .thread_id = std::this_thread::get_id()};
+        };
+        auto const output = solve_islands_parallel(solve_island, {}, 4, info);
+        CHECK(output.empty());
+    }
+}
+
+TEST_CASE("Test build islands in parallel") {
+    std::vector<Idx> const island_sizes{3, 10, 1, 10, 7};
+
+    SUBCASE("Objects are in island order") {
+        for (Idx const n_thread : {Idx{1}, Idx{2}, Idx{8}}) {
+            CAPTURE(n_thread);
+            auto const objects =
+                build_islands_parallel([](Idx island) { return MockIslandObject{island}; }, island_sizes, n_thread);
+            REQUIRE(objects.size() == island_sizes.size());
+            for (Idx island = 0; island != static_cast<Idx>(objects.size()); ++island) {
+                CHECK(objects[island].island() == island);
+            }
+        }
+    }
+
+    SUBCASE("First failing island is rethrown") {
+        auto const build_island = [](Idx island) {
+            if (island == 1 || island == 4) {
+                throw std::runtime_error{std::to_string(island)};
+            }
+            return MockIslandObject{island};
+        };
+        CHECK_THROWS_WITH_AS(build_islands_parallel(build_island, island_sizes, 4), "1", std::runtime_error);
+    }
+}
+
+} // namespace power_grid_model::main_core
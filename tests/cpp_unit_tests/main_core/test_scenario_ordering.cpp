@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include <power_grid_model/main_core/scenario_ordering.hpp>
+
+#include <power_grid_model/all_components.hpp>
+#include <power_grid_model/auxiliary/dataset.hpp>
+#include <power_grid_model/auxiliary/meta_data_gen.hpp>
+#include <power_grid_model/auxiliary/update.hpp>
+#include <power_grid_model/common/common.hpp>
+#include <power_grid_model/main_core/main_model_type.hpp>
+
+#include <doctest/doctest.h>
+
+#include <vector>
+
+namespace power_grid_model::main_core::update {
+
+TEST_CASE("Test topology grouped scenario order") {
+    using ModelType = MainModelType<AllExtraRetrievableTypes, AllComponents>;
+
+    // scenarios 0 and 2 open the same line, scenarios 1 and 3 do not switch anything
+    std::vector<BranchUpdate> const line_updates{{.id = 1, .from_status = 0, .to_status = na_IntS},
+                                                 {.id = 1, .from_status = na_IntS, .to_status = na_IntS},
+                                                 {.id = 1, .from_status = 0, .to_status = na_IntS},
+                                                 {.id = 1, .from_status = na_IntS, .to_status = na_IntS}};
+    std::vector<SymLoadGenUpdate> const load_updates{
+        {.id = 2, .status = na_IntS, .p_specified = 1.0, .q_specified = nan},
+        {.id = 2, .status = na_IntS, .p_specified = 2.0, .q_specified = nan},
+        {.id = 2, .status = 0, .p_specified = 3.0, .q_specified = nan},
+        {.id = 2, .status = na_IntS, .p_specified = 4.0, .q_specified = nan}};
+
+    SUBCASE("Scenarios with the same topology changes are grouped") {
+        ConstDataset update_data{true, 4, "update", meta_data::meta_data_gen::meta_data};
+        update_data.add_buffer("line", 1, 4, nullptr, line_updates.data());
+        update_data.add_buffer("sym_load", 1, 4, nullptr, load_updates.data());
+
+        // appliance statuses do not affect the topology
+        CHECK(topology_fingerprint<ModelType>(update_data, 0) == topology_fingerprint<ModelType>(update_data, 2));
+        CHECK(topology_fingerprint<ModelType>(update_data, 1) == topology_fingerprint<ModelType>(update_data, 3));
+        CHECK(topology_fingerprint<ModelType>(update_data, 0) != topology_fingerprint<ModelType>(update_data, 1));
+
+        auto const order = topology_grouped_scenario_order<ModelType>(update_data);
+        bool const open_line_first = order.front() == 0;
+        CHECK(order == (open_line_first ? IdxVector{0, 2, 1, 3} : IdxVector{1, 3, 0, 2}));
+    }
+
+    SUBCASE("No reordering without topology changes") {
+        ConstDataset update_data{true, 4, "update", meta_data::meta_data_gen::meta_data};
+        update_data.add_buffer("sym_load", 1, 4, nullptr, load_updates.data());
+
+        CHECK(topology_grouped_scenario_order<ModelType>(update_data).empty());
+    }
+}
+
+} // namespace power_grid_model::main_core::update
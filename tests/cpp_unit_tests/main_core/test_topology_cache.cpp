@@ -0,0 +1,129 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include <power_grid_model/main_core/topology_cache.hpp>
+
+#include <power_grid_model/calculation_parameters.hpp>
+#include <power_grid_model/common/common.hpp>
+
+#include <doctest/doctest.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace power_grid_model::main_core {
+
+namespace {
+ComponentConnections switching_state(IntS from_status, IntS source_status) {
+    return ComponentConnections{.branch_connected = {{from_status, 1}, {1, 1}},
+                                .branch3_connected = {{1, 1, 1}},
+                                .link_connected = {},
+                                .branch_phase_shift = {0.0, 0.0},
+                                .branch3_phase_shift = {{0.0, 0.0, 0.0}},
+                                .source_connected = {source_status}};
+}
+
+std::shared_ptr<TopologyCacheEntry const> make_entry(ComponentConnections const& comp_conn) {
+    return std::make_shared<TopologyCacheEntry const>(
+        TopologyCacheEntry{.hash = hash_component_connections(comp_conn),
+                           .comp_conn = std::make_shared<ComponentConnections const>(comp_conn),
+                           .reduced_topology = {},
+                           .math_topology = {std::make_shared<MathModelTopology const>()},
+                           .topo_comp_coup = {},
+                           .y_bus_structure = {}});
+}
+} // namespace
+
+TEST_CASE("Test topology cache") {
+    auto const closed = switching_state(1, 1);
+    auto const open = switching_state(0, 1);
+    auto const source_off = switching_state(1, 0);
+
+    SUBCASE("Hash of switching state") {
+        CHECK(hash_component_connections(closed) == hash_component_connections(switching_state(1, 1)));
+        CHECK(hash_component_connections(closed) != hash_component_connections(open));
+        CHECK(hash_component_connections(closed) != hash_component_connections(source_off));
+    }
+
+    SUBCASE("Find shares the cached entry") {
+        TopologyCache cache;
+        CHECK(cache.capacity() == TopologyCache::default_capacity);
+        CHECK(cache.find(closed, hash_component_connections(closed)) == nullptr);
+
+        auto const entry = make_entry(closed);
+        cache.insert(entry);
+        CHECK(cache.size() == 1);
+        CHECK(cache.find(closed, hash_component_connections(closed)) == entry);
+        CHECK(cache.find(open, hash_component_connections(open)) == nullptr);
+
+        // a wrong hash is never a hit, an equal hash is only a hit if the switching states are equal
+        CHECK(cache.find(closed, hash_component_connections(closed) + 1) == nullptr);
+        CHECK(cache.find(open, hash_component_connections(closed)) == nullptr);
+
+        // inserting the same switching state twice keeps the first entry
+        cache.insert(make_entry(closed));
+        CHECK(cache.size() == 1);
+        CHECK(cache.find(closed, hash_component_connections(closed)) == entry);
+    }
+
+    SUBCASE("Least recently used entry is evicted") {
+        TopologyCache cache{2};
+        cache.insert(make_entry(closed));
+        cache.insert(make_entry(open));
+        // use closed, so that open is the least recently used
+        CHECK(cache.find(closed, hash_component_connections(closed)) != nullptr);
+        cache.insert(make_entry(source_off));
+
+        CHECK(cache.size() == 2);
+        CHECK(cache.find(closed, hash_component_connections(closed)) != nullptr);
+        CHECK(cache.find(source_off, hash_component_connections(source_off)) != nullptr);
+        CHECK(cache.find(open, hash_component_connections(open)) == nullptr);
+    }
+
+    SUBCASE("Concurrent access") {
+        TopologyCache cache{4};
+        std::vector<ComponentConnections> const states{closed, open, source_off};
+        {
+            std::vector<std::jthread> threads;
+            for (Idx thread_number = 0; thread_number != 4; ++thread_number) {
+                threads.emplace_back([&cache, &states] {
+                    for (Idx iteration = 0; iteration != 100; ++iteration) {
+                        for (auto const& state : states) {
+                            if (cache.find(state, hash_component_connections(state)) == nullptr) {
+                                cache.insert(make_entry(state));
+                            }
+                        }
+                    }
+                });
+            }
+        }
+        CHECK(cache.size() == 3);
+    }
+    SUBCASE("Y bus structure of an island") {
+        auto const make_math_topology = [](std::vector<BranchIdx> branch_bus_idx, std::vector<BranchIdx> fill_in) {
+            MathModelTopology math_topo;
+            math_topo.slack_bus = 0;
+            math_topo.phase_shift.resize(4);
+            math_topo.branch_bus_idx = std::move(branch_bus_idx);
+            math_topo.fill_in = std::move(fill_in);
+            math_topo.shunts_per_bus = DenseGroupedIdxVector{from_sparse, {0, 0, 0, 0, 0}};
+            return std::make_shared<MathModelTopology const>(std::move(math_topo));
+        };
+        std::vector<BranchIdx> const ring{{0, 1}, {1, 2}, {2, 3}, {3, 0}};
+
+        TopologyCache cache;
+        auto const y_bus_structure = cache.get_y_bus_structure(make_math_topology(ring, {{1, 3}}));
+        CHECK(y_bus_structure->row_indptr_lu.back() == 14);
+        CHECK(cache.y_bus_structure_size() == 1);
+
+        // the same island in another switching state shares the structure
+        CHECK(cache.get_y_bus_structure(make_math_topology(ring, {{1, 3}})) == y_bus_structure);
+        // another fill-in is another structure
+        CHECK(cache.get_y_bus_structure(make_math_topology(ring, {{0, 2}})) != y_bus_structure);
+        CHECK(cache.y_bus_structure_size() == 2);
+    }
+}
+
+} // namespace power_grid_model::main_core
@@ -8,6 +8,7 @@
 
 #include "power_grid_model/calculation_parameters.hpp"
 #include "power_grid_model/common/common.hpp"
+#include "power_grid_model/common/enum.hpp"
 #include "power_grid_model/common/exception.hpp"
 #include "power_grid_model/common/logging.hpp"
 #include "power_grid_model/common/three_phase_tensor.hpp"
@@ -16,6 +17,8 @@
 #include <complex>
 #include <cstddef>
 #include <limits>
+#include <span>
+#include <vector>
 #include <power_grid_model/math_solver/sparse_lu_solver.hpp>
 #include <power_grid_model/math_solver/y_bus.hpp>
 
@@ -34,6 +37,17 @@ inline auto run_power_flow(SolverType& solver, YBus<typename SolverType::sym> co
     }
 };
 
+template <typename SolverType>
+inline auto run_power_flow_lockstep(SolverType& solver, YBus<typename SolverType::sym> const& y_bus,
+                                    std::span<PowerFlowInput<typename SolverType::sym> const> inputs, double err_tol,
+                                    Idx max_iter, Logger& log) {
+    if constexpr (SolverType::is_iterative) {
+        return solver.run_power_flow_lockstep(y_bus, inputs, err_tol, max_iter, log);
+    } else {
+        return solver.run_power_flow_lockstep(y_bus, inputs, log);
+    }
+};
+
 template <symmetry_tag sym_type> struct PFSolverTestGrid : public SteadyStateSolverTestGrid<sym_type> {
     using sym = sym_type;
 
@@ -137,6 +151,115 @@ TEST_CASE_TEMPLATE_DEFINE("Test math solver - PF", SolverType, test_math_solver_
             pf_input.s_injection[6] = ComplexValue<sym>{1e6};
             CHECK_THROWS_AS(run_power_flow(solver, y_bus, pf_input, 1e-12, 20, log), IterationDiverge);
         }
+        SUBCASE("Test warm start") {
+            constexpr auto cache_run = false;
+            constexpr auto warm_start = PowerFlowInitialization::warm_start;
+
+            SolverType solver{y_bus, topo};
+            NoLogger log;
+
+            PowerFlowInput<sym> const pf_input = grid.pf_input();
+            SolverOutput<sym> output = solver.run_power_flow(y_bus, pf_input, 1e-12, 20, cache_run, log, warm_start);
+            assert_output(output, grid.output_ref());
+
+            // starting from the converged solution, a single iteration is accurate
+            output = solver.run_power_flow(y_bus, pf_input, std::numeric_limits<double>::infinity(), 1, cache_run, log,
+                                           warm_start);
+            assert_output(output, grid.output_ref());
+
+            // a calculation that does not converge at all keeps the previous solution
+            PowerFlowInput<sym> diverging_input = grid.pf_input();
+            diverging_input.s_injection[6] = ComplexValue<sym>{1e6};
+            CHECK_THROWS_AS(solver.run_power_flow(y_bus, diverging_input, 1e-12, 20, cache_run, log, warm_start),
+                            IterationDiverge);
+            output = solver.run_power_flow(y_bus, pf_input, 1e-12, 20, cache_run, log, warm_start);
+            assert_output(output, grid.output_ref());
+        }
+    }
+
+    if constexpr (!SolverType::is_iterative) {
+        SUBCASE("Test reuse of the factorization") {
+            SolverType solver{y_bus, topo};
+            y_bus.register_parameters_changed_callback([&solver](bool changed) { solver.parameters_changed(changed); });
+            NoLogger log;
+
+            // the same matrix is factorized once
+            PowerFlowInput<sym> const pf_input_z = grid.pf_input_z();
+            for (Idx run = 0; run != 2; ++run) {
+                SolverOutput<sym> const output = run_power_flow(solver, y_bus, pf_input_z, 1e-12, 20, log);
+                assert_output(output, grid.output_ref_z());
+            }
+            CHECK(solver.n_factorization() == 1);
+
+            // the parameters change
+            auto singular_param = grid.param();
+            singular_param.branch_param[0] = BranchCalcParam<sym>{};
+            singular_param.branch_param[1] = BranchCalcParam<sym>{};
+            singular_param.shunt_param[0] = ComplexTensor<sym>{};
+            y_bus.update_admittance(std::move(singular_param));
+            PowerFlowInput<sym> const pf_input = grid.pf_input();
+            CHECK_THROWS_AS(run_power_flow(solver, y_bus, pf_input, 1e-12, 20, log), SparseMatrixError);
+            CHECK(solver.n_factorization() == 2);
+        }
+    }
+
+    SUBCASE("Test change of branch parameters") {
+        // only the solvers with a single factorization of the y bus support low-rank updates
+        constexpr bool has_low_rank_update = requires(SolverType& s) { s.set_contingency_mode(ContingencyMode{}); };
+
+        SolverType solver{y_bus, topo};
+        y_bus.register_parameters_changed_callback([&solver](bool changed) { solver.parameters_changed(changed); });
+        if constexpr (has_low_rank_update) {
+            solver.set_contingency_mode(ContingencyMode::low_rank_update);
+        }
+        NoLogger log;
+
+        PowerFlowInput<sym> const pf_input = grid.pf_input();
+        SolverOutput<sym> output = run_power_flow(solver, y_bus, pf_input, 1e-12, 20, log);
+        assert_output(output, grid.output_ref(), false, SolverType::is_iterative ? 1e-12 : 0.15);
+
+        // e.g. the outage of one of two parallel lines, which is a low-rank update of the factorized matrix
+        MathModelParamIncrement<sym> param_increment;
+        param_increment.branch_param = {grid.param().branch_param[0]};
+        for (auto& element : param_increment.branch_param[0].value) {
+            element *= 0.5;
+        }
+        param_increment.branch_param_to_change = {0};
+        y_bus.update_admittance_increment(param_increment);
+        output = run_power_flow(solver, y_bus, pf_input, 1e-12, 20, log);
+        if constexpr (has_low_rank_update) {
+            // the buses of the branch
+            CHECK(solver.low_rank_update_size() == 2);
+        }
+
+        // same as a new solver
+        SolverType new_solver{y_bus, topo};
+        SolverOutput<sym> const output_ref = run_power_flow(new_solver, y_bus, pf_input, 1e-12, 20, log);
+        assert_output(output, output_ref);
+    }
+
+    SUBCASE("Test lockstep pf solver") {
+        SolverType solver{y_bus, topo};
+        NoLogger log;
+
+        // more scenarios than lanes, with different loads
+        std::vector<PowerFlowInput<sym>> inputs{grid.pf_input(), grid.pf_input_z(), grid.pf_input(),
+                                                grid.pf_input_z(), grid.pf_input()};
+        for (auto& injection : inputs[2].s_injection) {
+            injection *= 0.5;
+        }
+        std::vector<SolverOutput<sym>> const outputs = run_power_flow_lockstep(
+            solver, y_bus, std::span<PowerFlowInput<sym> const>{inputs}, 1e-12, 20, log);
+        REQUIRE(outputs.size() == inputs.size());
+
+        // same as one scenario at a time
+        for (size_t scenario = 0; scenario != inputs.size(); ++scenario) {
+            CAPTURE(scenario);
+            SolverType single_solver{y_bus, topo};
+            SolverOutput<sym> const output_ref = run_power_flow(single_solver, y_bus, inputs[scenario], 1e-12, 20, log);
+            assert_output(outputs[scenario], output_ref);
+        }
+        assert_output(outputs[1], grid.output_ref_z());
     }
 
     SUBCASE("Test singular ybus") {
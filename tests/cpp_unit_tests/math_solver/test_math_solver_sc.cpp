@@ -309,6 +309,42 @@ TEST_CASE("Short circuit solver") {
         assert_sc_output<symmetric_t>(sym_output, sym_sc_output_ref);
     }
 
+    SUBCASE("Test reuse of the factorization") {
+        YBus<asymmetric_t> y_bus_asym{topo_sc, param_sc_asym};
+        ShortCircuitSolver<asymmetric_t> solver{y_bus_asym, topo_sc};
+        y_bus_asym.register_parameters_changed_callback(
+            [&solver](bool changed) { solver.parameters_changed(changed); });
+
+        // only the source voltage changes, so the factorization is reused
+        for (double const u_ref : {vref, 1.0, vref}) {
+            auto sc_input = create_sc_test_input(three_phase, FaultPhase::abc, y_fault, u_ref, fault_buses);
+            auto sc_output_ref = create_sc_test_output<asymmetric_t>(three_phase, z_fault, z0, z0_0, u_ref, zref);
+            auto output = solver.run_short_circuit(y_bus_asym, sc_input);
+            assert_sc_output<asymmetric_t>(output, sc_output_ref);
+        }
+        CHECK(solver.n_factorization() == 1);
+
+        // the fault changes
+        auto sc_input = create_sc_test_input(single_phase_to_ground, FaultPhase::a, y_fault_solid, vref, fault_buses);
+        auto sc_output_ref =
+            create_sc_test_output<asymmetric_t>(single_phase_to_ground, z_fault_solid, z0, z0_0, vref, zref);
+        auto output = solver.run_short_circuit(y_bus_asym, sc_input);
+        assert_sc_output<asymmetric_t>(output, sc_output_ref);
+        CHECK(solver.n_factorization() == 2);
+
+        // the source admittance changes
+        DoubleComplex const yref_2{20.0 - 100.0i};
+        MathModelParamIncrement<asymmetric_t> param_increment;
+        param_increment.source_param = {SourceCalcParam{.y1 = yref_2, .y0 = yref_2}};
+        param_increment.source_param_to_change = {0};
+        y_bus_asym.update_admittance_increment(param_increment);
+        sc_output_ref =
+            create_sc_test_output<asymmetric_t>(single_phase_to_ground, z_fault_solid, z0, z0_0, vref, 1.0 / yref_2);
+        output = solver.run_short_circuit(y_bus_asym, sc_input);
+        assert_sc_output<asymmetric_t>(output, sc_output_ref);
+        CHECK(solver.n_factorization() == 3);
+    }
+
     SUBCASE("Test fault on source bus") {
         // Grid for short circuit
         MathModelTopology topo_comp;
@@ -367,6 +367,16 @@ TEST_CASE_TEMPLATE_DEFINE("Test math solver - SE", SolverType, test_math_solver_
                 run_state_estimation(solver, y_bus, se_input, error_tolerance, num_iter, log);
             assert_output(output, grid.output_ref());
         }
+
+        SUBCASE("Test se with mixed precision factorization") {
+            SolverType solver{y_bus, topo};
+            auto log = get_logger();
+
+            auto const se_input = grid.se_input_angle();
+            SolverOutput<sym> const output = solver.run_state_estimation(y_bus, se_input, error_tolerance, num_iter,
+                                                                         log, FactorizationPrecision::mixed_precision);
+            assert_output(output, grid.output_ref());
+        }
     }
 
     SUBCASE("se input angle with current sensors") {
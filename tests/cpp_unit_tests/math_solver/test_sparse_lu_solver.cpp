@@ -2,9 +2,13 @@
 //
 // SPDX-License-Identifier: MPL-2.0
 
+#include <power_grid_model/math_solver/sparse_lu_lockstep_solver.hpp>
 #include <power_grid_model/math_solver/sparse_lu_solver.hpp>
 
+#include <power_grid_model/job_executor.hpp>
+
 #include <power_grid_model/common/common.hpp>
+#include <power_grid_model/common/enum.hpp>
 #include <power_grid_model/common/exception.hpp>
 #include <power_grid_model/common/three_phase_tensor.hpp>
 #include <power_grid_model/common/typing.hpp>
@@ -13,8 +17,11 @@
 #include <doctest/doctest.h>
 
 #include <algorithm>
+#include <array>
+#include <complex>
 #include <cstddef>
 #include <iterator>
+#include <memory>
 #include <type_traits>
 #include <vector>
 
@@ -24,12 +31,14 @@ using lu_trait_double = math_solver::sparse_lu_entry_trait<double, double, doubl
 static_assert(!lu_trait_double::is_block);
 static_assert(lu_trait_double::block_size == 1);
 static_assert(std::is_same_v<lu_trait_double::Scalar, double>);
+static_assert(std::is_same_v<lu_trait_double::LowPrecisionTensor, float>);
 
 using lu_trait_tensor = math_solver::sparse_lu_entry_trait<Eigen::Array33cd, Eigen::Array3cd, Eigen::Array3cd>;
 static_assert(std::is_base_of_v<Eigen::ArrayBase<Eigen::Array33cd>, Eigen::Array33cd>);
 static_assert(lu_trait_tensor::is_block);
 static_assert(lu_trait_tensor::block_size == 3);
 static_assert(std::is_same_v<lu_trait_tensor::Scalar, DoubleComplex>);
+static_assert(std::is_same_v<lu_trait_tensor::LowPrecisionTensor::Scalar, std::complex<float>>);
 
 template <class T> void check_result(std::vector<T> const& x, std::vector<T> const& x_solver) {
     CHECK(x.size() == x_solver.size());
@@ -330,6 +339,218 @@ TEST_CASE("Dense LU factor") {
         check_matrix_result(inverse, expected_inverse);
         check_matrix_result(matrix * inverse, Matrix3::Identity());
     }
+
+    SUBCASE("Full pivoting of a 6*6 block") {
+        using Matrix6 = Eigen::Matrix<double, 6, 6>;
+        using LUFactor6 = DenseLUFactor<Matrix6>;
+
+        // zero diagonal, so every pivot has to be found off the diagonal
+        Matrix6 matrix{};
+        for (int row = 0; row != 6; ++row) {
+            for (int col = 0; col != 6; ++col) {
+                matrix(row, col) = (row == col) ? 0.0 : 1.0 / (1.0 + row + col);
+            }
+            matrix(row, (row + 1) % 6) += 10.0;
+        }
+
+        Matrix6 factorized_matrix = matrix;
+        LUFactor6::BlockPerm block_perm{};
+        bool has_pivot_perturbation = false;
+
+        LUFactor6::factorize_block_in_place(factorized_matrix, block_perm, epsilon, false, has_pivot_perturbation);
+        Matrix6 const unit_lower = factorized_matrix.triangularView<Eigen::UnitLower>();
+        Matrix6 const upper = factorized_matrix.triangularView<Eigen::Upper>();
+
+        CHECK(has_pivot_perturbation == false);
+        check_matrix_result(unit_lower * upper, block_perm.p * matrix * block_perm.q);
+        check_matrix_result(matrix * LUFactor6::dense_inverse(factorized_matrix, block_perm), Matrix6::Identity());
+    }
+
+    SUBCASE("Pivot perturbation of a singular 6*6 block") {
+        using Matrix6 = Eigen::Matrix<double, 6, 6>;
+        using LUFactor6 = DenseLUFactor<Matrix6>;
+
+        Matrix6 factorized_matrix = Matrix6::Ones();
+        LUFactor6::BlockPerm block_perm{};
+        bool has_pivot_perturbation = false;
+
+        LUFactor6::factorize_block_in_place(factorized_matrix, block_perm, epsilon, true, has_pivot_perturbation);
+
+        CHECK(has_pivot_perturbation == true);
+        CHECK(factorized_matrix.diagonal().cwiseAbs().minCoeff() > 0.0);
+    }
+}
+
+TEST_CASE("Sparse LU symbolic factorization") {
+    // 3 * 3 matrix, with diagonal, two fill-ins
+    /// x x x
+    /// x x f
+    /// x f x
+    auto const row_indptr = IdxVector{0, 3, 6, 9};
+    auto const col_indices = IdxVector{0, 1, 2, 0, 1, 2, 0, 1, 2};
+    auto const diag_lu = IdxVector{0, 4, 8};
+
+    SparseLUSymbolic const symbolic{row_indptr, col_indices, diag_lu};
+    CHECK(symbolic.transpose_entry == IdxVector{0, 3, 6, 1, 4, 7, 2, 5, 8});
+    // pivot 0 updates (1, 1), (1, 2), (2, 1), (2, 2); pivot 1 updates (2, 2)
+    CHECK(symbolic.schur_update_entry == IdxVector{4, 5, 7, 8, 8});
+
+    SUBCASE("Known transpose entries") {
+        SparseLUSymbolic const known_transpose_symbolic{row_indptr, col_indices, diag_lu, symbolic.transpose_entry};
+        CHECK(known_transpose_symbolic.transpose_entry == symbolic.transpose_entry);
+        CHECK(known_transpose_symbolic.schur_u_end == symbolic.schur_u_end);
+        CHECK(known_transpose_symbolic.schur_update_entry == symbolic.schur_update_entry);
+    }
+
+    SUBCASE("Shared between solvers") {
+        auto const matrix = three_block_rows_with_preallocated_fill_ins_lu_test_matrix();
+        auto const shared_symbolic =
+            std::make_shared<SparseLUSymbolic const>(matrix.row_indptr, matrix.col_indices, matrix.diag_lu);
+        std::vector<Array> const rhs = {{38, 356}, {-389, 2}, {44, 611}};
+        std::vector<Array> const x_ref = {{3, 4}, {-1, -2}, {5, 6}};
+
+        for (Idx solver_number = 0; solver_number != 2; ++solver_number) {
+            std::vector<Tensor> data = matrix.data;
+            std::vector<Array> x(3, Array::Zero());
+            SparseLUSolver<Tensor, Array, Array> solver{matrix.row_indptr, matrix.col_indices, matrix.diag_lu,
+                                                        shared_symbolic};
+            SparseLUSolver<Tensor, Array, Array>::BlockPermArray block_perm(matrix.row_indptr.size() - 1);
+            solver.prefactorize_and_solve(data, block_perm, rhs, x);
+            check_result(x, x_ref);
+        }
+    }
+
+    SUBCASE("Supernodes of a dense matrix") {
+        // 10 * 10 dense blocks, i.e. a fully meshed network or a lot of fill-ins
+        constexpr Idx size = 10;
+        BlockSparseMatrix matrix;
+        matrix.row_indptr.push_back(0);
+        for (Idx row = 0; row != size; ++row) {
+            for (Idx col = 0; col != size; ++col) {
+                if (row == col) {
+                    matrix.diag_lu.push_back(std::ssize(matrix.col_indices));
+                }
+                matrix.col_indices.push_back(col);
+                // diagonally dominant, non-symmetric
+                auto const value = static_cast<double>(row + 2 * col + 1);
+                matrix.data.push_back(row == col ? Tensor{{100.0 + value, 1.0}, {-2.0, 90.0 - value}}
+                                                 : Tensor{{1.0 / value, 0.5}, {-0.25, value / 20.0}});
+            }
+            matrix.row_indptr.push_back(std::ssize(matrix.col_indices));
+        }
+
+        SparseLUSymbolic const dense_symbolic{matrix.row_indptr, matrix.col_indices, matrix.diag_lu};
+        // pivots 0 to 3 update the trailing pivots 4 to 9 at once, pivots 4 to 7 update pivots 8 and 9 at once
+        REQUIRE(dense_symbolic.supernodes.size() == 2);
+        CHECK(dense_symbolic.supernodes[0].first == 0);
+        CHECK(dense_symbolic.supernodes[0].last == 3);
+        CHECK(dense_symbolic.supernodes[0].n_trailing == 6);
+        CHECK(dense_symbolic.supernodes[1].first == 4);
+        CHECK(dense_symbolic.supernodes[1].last == 7);
+        CHECK(dense_symbolic.supernodes[1].n_trailing == 2);
+
+        std::vector<Array> x_ref(size);
+        for (Idx row = 0; row != size; ++row) {
+            x_ref[row] = Array{static_cast<double>(row), -1.0};
+        }
+        Eigen::VectorXd dense_x(size * 2);
+        for (Idx row = 0; row != size; ++row) {
+            dense_x.segment<2>(row * 2) = x_ref[row].matrix();
+        }
+        Eigen::VectorXd const dense_rhs =
+            assemble_dense_matrix(matrix.row_indptr, matrix.col_indices, matrix.data) * dense_x;
+        std::vector<Array> rhs(size);
+        for (Idx row = 0; row != size; ++row) {
+            rhs[row] = dense_rhs.segment<2>(row * 2).array();
+        }
+
+        std::vector<Tensor> data = matrix.data;
+        std::vector<Array> x(size, Array::Zero());
+        SparseLUSolver<Tensor, Array, Array> solver{matrix.row_indptr, matrix.col_indices, matrix.diag_lu};
+        SparseLUSolver<Tensor, Array, Array>::BlockPermArray block_perm(size);
+        solver.prefactorize_and_solve(data, block_perm, rhs, x);
+        check_result(x, x_ref);
+    }
+
+    SUBCASE("Level schedule of a radial matrix") {
+        // radial network, the leaves are eliminated first
+        //     6
+        //   /   \
+        //  4     5
+        // / \   / \
+        // 0 1   2 3
+        BlockSparseMatrix matrix{.row_indptr = {0, 2, 4, 6, 8, 12, 16, 19},
+                                 .col_indices = {0, 4, 1, 4, 2, 5, 3, 5, 0, 1, 4, 6, 2, 3, 5, 6, 4, 5, 6},
+                                 .diag_lu = {0, 2, 4, 6, 10, 14, 18},
+                                 .data = {}};
+        Idx const size = std::ssize(matrix.row_indptr) - 1;
+        for (Idx row = 0; row != size; ++row) {
+            for (Idx idx = matrix.row_indptr[row]; idx != matrix.row_indptr[row + 1]; ++idx) {
+                auto const value = static_cast<double>(row + matrix.col_indices[idx] + 1);
+                matrix.data.push_back(matrix.col_indices[idx] == row ? Tensor{{10.0 + value, 1.0}, {2.0, 8.0 + value}}
+                                                                     : Tensor{{-1.0, 0.5 / value}, {0.25, -value}});
+            }
+        }
+
+        auto radial_symbolic =
+            std::make_shared<SparseLUSymbolic>(matrix.row_indptr, matrix.col_indices, matrix.diag_lu);
+        CHECK_FALSE(radial_symbolic->has_level_schedule());
+        radial_symbolic->build_level_schedule(matrix.row_indptr, matrix.col_indices, matrix.diag_lu);
+        REQUIRE(radial_symbolic->has_level_schedule());
+        CHECK(radial_symbolic->level_schedule.level_indptr == IdxVector{0, 4, 6, 7});
+        CHECK(radial_symbolic->level_schedule.level_pivots == IdxVector{0, 1, 2, 3, 4, 5, 6});
+        // the leaves update the diagonal of their parent, the parents update the diagonal of the root
+        CHECK(radial_symbolic->level_schedule.update_indptr == IdxVector{0, 0, 0, 0, 0, 2, 4, 6});
+
+        std::vector<Array> x_ref(size);
+        for (Idx row = 0; row != size; ++row) {
+            x_ref[row] = Array{static_cast<double>(row) - 3.0, 2.0};
+        }
+        Eigen::VectorXd dense_x(size * 2);
+        for (Idx row = 0; row != size; ++row) {
+            dense_x.segment<2>(row * 2) = x_ref[row].matrix();
+        }
+        Eigen::VectorXd const dense_rhs =
+            assemble_dense_matrix(matrix.row_indptr, matrix.col_indices, matrix.data) * dense_x;
+        std::vector<Array> rhs(size);
+        for (Idx row = 0; row != size; ++row) {
+            rhs[row] = dense_rhs.segment<2>(row * 2).array();
+        }
+
+        // without a level executor, the level schedule is not used
+        std::vector<Tensor> data = matrix.data;
+        std::vector<Array> x(size, Array::Zero());
+        SparseLUSolver<Tensor, Array, Array> solver{matrix.row_indptr, matrix.col_indices, matrix.diag_lu,
+                                                    radial_symbolic};
+        SparseLUSolver<Tensor, Array, Array>::BlockPermArray block_perm(size);
+        solver.prefactorize_and_solve(data, block_perm, rhs, x);
+        check_result(x, x_ref);
+
+        std::vector<Tensor> sequential_data = matrix.data;
+        std::vector<Array> sequential_x(size, Array::Zero());
+        SparseLUSolver<Tensor, Array, Array> sequential_solver{matrix.row_indptr, matrix.col_indices,
+                                                               matrix.diag_lu};
+        SparseLUSolver<Tensor, Array, Array>::BlockPermArray sequential_block_perm(size);
+        sequential_solver.prefactorize_and_solve(sequential_data, sequential_block_perm, rhs, sequential_x);
+        check_result(x, sequential_x);
+        for (Idx idx = 0; idx != std::ssize(data); ++idx) {
+            CHECK((data[idx] == sequential_data[idx]).all());
+        }
+
+        // the levels divided over the workers of an executor give the same result as the sequential factorization
+        JobExecutor executor{3};
+        std::vector<Tensor> threaded_data = matrix.data;
+        std::vector<Array> threaded_x(size, Array::Zero());
+        SparseLUSolver<Tensor, Array, Array> threaded_solver{matrix.row_indptr, matrix.col_indices, matrix.diag_lu,
+                                                             radial_symbolic};
+        threaded_solver.set_level_parallelism(&executor, executor.n_threads());
+        SparseLUSolver<Tensor, Array, Array>::BlockPermArray threaded_block_perm(size);
+        threaded_solver.prefactorize_and_solve(threaded_data, threaded_block_perm, rhs, threaded_x);
+        check_result(threaded_x, sequential_x);
+        for (Idx idx = 0; idx != std::ssize(threaded_data); ++idx) {
+            CHECK((threaded_data[idx] == sequential_data[idx]).all());
+        }
+    }
 }
 
 TEST_CASE("Test Sparse LU solver") {
@@ -369,6 +590,93 @@ TEST_CASE("Test Sparse LU solver") {
             solver.solve_with_prefactorized_matrix(data_ref, block_perm, rhs, x);
             check_result(x, x_ref);
         }
+
+        SUBCASE("Test multiple right-hand sides") {
+            std::vector<std::vector<double>> const multiple_rhs{rhs, {-42, -4, -36}, {4, 3, 2}};
+            std::vector<std::vector<double>> multiple_x(3, std::vector<double>(3, 0.0));
+            solver.prefactorize(data, block_perm);
+            solver.solve_multiple_with_prefactorized_matrix(data, block_perm, multiple_rhs, multiple_x);
+            check_result(multiple_x[0], x_ref);
+            check_result(multiple_x[1], std::vector<double>{-6, 2, -4});
+            check_result(multiple_x[2], std::vector<double>{1, 0, 0});
+        }
+
+        SUBCASE("Test low-rank update") {
+            std::vector<double> const original = data;
+            std::vector<double> modified = data;
+            modified[3] = 1.0; // (1, 0)
+            modified[4] = 9.0; // (1, 1)
+            solver.prefactorize(data, block_perm);
+
+            SparseLUSolver<double, double, double>::LowRankUpdate update;
+            REQUIRE(solver.prepare_low_rank_update(data, block_perm, original, modified, 2, update));
+            CHECK(update.rows == IdxVector{0, 1});
+            solver.solve_with_low_rank_update(data, block_perm, update, rhs, x);
+
+            // same as the factorization of the modified matrix
+            std::vector<double> x_modified(3, 0.0);
+            SparseLUSolver<double, double, double> modified_solver{row_indptr, col_indices, diag_lu};
+            SparseLUSolver<double, double, double>::BlockPermArray modified_block_perm{};
+            modified_solver.prefactorize_and_solve(modified, modified_block_perm, rhs, x_modified);
+            check_result(x, x_modified);
+
+            // too many changed rows
+            CHECK_FALSE(solver.prepare_low_rank_update(data, block_perm, original, modified, 1, update));
+
+            // singular modified matrix
+            std::vector<double> singular = original;
+            singular[3] = 0.0;
+            singular[4] = 0.0;
+            CHECK_FALSE(solver.prepare_low_rank_update(data, block_perm, original, singular, 2, update));
+        }
+
+        SUBCASE("Test mixed precision") {
+            solver.set_factorization_precision(FactorizationPrecision::mixed_precision);
+            solver.prefactorize(data, block_perm);
+            // the data is not factorized in-place
+            CHECK(data == scalar_lu_test_data());
+            solver.solve_with_prefactorized_matrix(data, block_perm, rhs, x);
+            check_result(x, x_ref);
+
+            // the right-hand side can be the solution vector
+            x = rhs;
+            solver.solve_with_prefactorized_matrix(data, block_perm, x, x);
+            check_result(x, x_ref);
+
+            std::vector<std::vector<double>> const multiple_rhs{rhs, {-42, -4, -36}};
+            std::vector<std::vector<double>> multiple_x(2, std::vector<double>(3, 0.0));
+            solver.solve_multiple_with_prefactorized_matrix(data, block_perm, multiple_rhs, multiple_x);
+            check_result(multiple_x[0], x_ref);
+            check_result(multiple_x[1], std::vector<double>{-6, 2, -4});
+
+            // the factorization is not in-place, so it can not be updated
+            SparseLUSolver<double, double, double>::LowRankUpdate update;
+            CHECK_FALSE(solver.prepare_low_rank_update(data, block_perm, data, data, 2, update));
+        }
+
+        SUBCASE("Test mixed precision with ill-conditioned matrix") {
+            // the single-precision factorization of the nearly singular top left block is too inaccurate for the
+            // refinement to converge, so the solver falls back to double precision
+            std::vector<double> ill_conditioned = {
+                1.0, 1.0, 0.0,       // row 0
+                1.0, 1.0000003, 0.0, // row 1
+                0.0, 0.0, 1.0        // row 2
+            };
+            std::vector<double> const ill_conditioned_rhs = {2.0, 2.1, 3.0};
+            std::vector<double> x_double(3, 0.0);
+            std::vector<double> double_data = ill_conditioned;
+            solver.prefactorize_and_solve(double_data, block_perm, ill_conditioned_rhs, x_double);
+
+            SparseLUSolver<double, double, double> mixed_solver{row_indptr, col_indices, diag_lu};
+            mixed_solver.set_factorization_precision(FactorizationPrecision::mixed_precision);
+            mixed_solver.prefactorize(ill_conditioned, block_perm);
+            mixed_solver.solve_with_prefactorized_matrix(ill_conditioned, block_perm, ill_conditioned_rhs, x);
+            check_result(x, x_double);
+            // the double-precision factorization is kept
+            mixed_solver.solve_with_prefactorized_matrix(ill_conditioned, block_perm, ill_conditioned_rhs, x);
+            check_result(x, x_double);
+        }
+
         // our use case only need selective inversion for block sparse matrices
         SUBCASE("Selective inversion error with scalar sparse matrix") {
             solver.prefactorize(data, block_perm);
@@ -410,6 +718,61 @@ TEST_CASE("Test Sparse LU solver") {
             check_result(x, x_ref);
         }
 
+        SUBCASE("Test multiple right-hand sides") {
+            std::vector<std::vector<Array>> multiple_rhs{rhs, rhs};
+            for (auto& value : multiple_rhs[1]) {
+                value *= -0.5;
+            }
+            std::vector<std::vector<Array>> multiple_x(2, std::vector<Array>(3, Array::Zero()));
+            solver.prefactorize(data, block_perm);
+            solver.solve_multiple_with_prefactorized_matrix(data, block_perm, multiple_rhs, multiple_x);
+            check_result(multiple_x[0], x_ref);
+            check_result(multiple_x[1], std::vector<Array>{{-1.5, -2}, {0.5, 1}, {-2.5, -3}});
+
+            // same as the single right-hand side solve
+            solver.solve_with_prefactorized_matrix(data, block_perm, multiple_rhs[1], x);
+            check_result(x, multiple_x[1]);
+        }
+
+        SUBCASE("Test low-rank update") {
+            std::vector<Tensor> modified = matrix.data;
+            modified[2] = Tensor{{3, 4}, {5, 7}};  // (0, 2)
+            modified[8] = Tensor{{2, 0}, {0, 50}}; // (2, 2)
+            solver.prefactorize(data, block_perm);
+
+            SparseLUSolver<Tensor, Array, Array>::LowRankUpdate update;
+            REQUIRE(solver.prepare_low_rank_update(data, block_perm, matrix.data, modified, 2, update));
+            CHECK(update.rows == IdxVector{0, 2});
+            solver.solve_with_low_rank_update(data, block_perm, update, rhs, x);
+
+            // same as the factorization of the modified matrix
+            std::vector<Array> x_modified(3, Array::Zero());
+            SparseLUSolver<Tensor, Array, Array> modified_solver{matrix.row_indptr, matrix.col_indices,
+                                                                 matrix.diag_lu};
+            SparseLUSolver<Tensor, Array, Array>::BlockPermArray modified_block_perm(matrix.row_indptr.size() - 1);
+            modified_solver.prefactorize_and_solve(modified, modified_block_perm, rhs, x_modified);
+            check_result(x, x_modified);
+
+            // no changes
+            REQUIRE(solver.prepare_low_rank_update(data, block_perm, matrix.data, matrix.data, 2, update));
+            CHECK(update.rows.empty());
+            solver.solve_with_low_rank_update(data, block_perm, update, rhs, x);
+            check_result(x, x_ref);
+        }
+
+        SUBCASE("Test mixed precision") {
+            solver.set_factorization_precision(FactorizationPrecision::mixed_precision);
+            solver.prefactorize(data, block_perm);
+            solver.solve_with_prefactorized_matrix(data, block_perm, rhs, x);
+            check_result(x, x_ref);
+
+            // same as double precision
+            std::vector<Array> x_double(3, Array::Zero());
+            solver.set_factorization_precision(FactorizationPrecision::double_precision);
+            solver.prefactorize_and_solve(data, block_perm, rhs, x_double);
+            check_result(x, x_double);
+        }
+
         SUBCASE("Selective inverse with prefactorized matrix") {
             SUBCASE("One block agrees with dense inverse") {
                 auto matrix_data = one_block_requiring_row_and_column_pivoting_lu_test_matrix();
@@ -465,6 +828,70 @@ TEST_CASE("Test Sparse LU solver") {
     }
 }
 
+TEST_CASE("Sparse LU lockstep solver") {
+    SUBCASE("Scalar(double) calculation") {
+        // same matrix as the scalar calculation of the sparse LU solver, in different lanes
+        auto row_indptr = IdxVector{0, 3, 6, 9};
+        auto col_indices = IdxVector{0, 1, 2, 0, 1, 2, 0, 1, 2};
+        auto diag_lu = IdxVector{0, 4, 8};
+        using LockstepSolver = SparseLULockstepSolver<double, double, double, 4>;
+
+        std::vector<double> const data = scalar_lu_test_data();
+        std::vector<double> scaled_data = data;
+        for (auto& value : scaled_data) {
+            value *= 2.0;
+        }
+        std::vector<double> singular_data = data;
+        singular_data[0] = 0.0;
+        std::vector<double> const rhs = {21, 2, 18};
+        std::vector<std::vector<double>> x(4, std::vector<double>(3, 0.0));
+
+        LockstepSolver solver{row_indptr, col_indices, diag_lu,
+                              std::make_shared<SparseLUSymbolic const>(row_indptr, col_indices, diag_lu)};
+        std::array<std::vector<double> const*, 4> const lane_data{&data, nullptr, &scaled_data, &singular_data};
+        LockstepSolver::LaneMask const failed_lanes = solver.prefactorize(lane_data);
+        CHECK(failed_lanes.count() == 1);
+        CHECK(failed_lanes[3]);
+
+        std::array<std::vector<double> const*, 4> const lane_rhs{&rhs, nullptr, &rhs, nullptr};
+        std::array<std::vector<double>*, 4> const lane_x{x.data(), nullptr, &x[2], nullptr};
+        solver.solve_with_prefactorized_matrix(lane_rhs, lane_x);
+        check_result(x[0], std::vector<double>{3, -1, 2});
+        check_result(x[1], std::vector<double>(3, 0.0));
+        check_result(x[2], std::vector<double>{1.5, -0.5, 1});
+    }
+
+    SUBCASE("Block(double 2*2) calculation") {
+        auto const matrix = three_block_rows_with_preallocated_fill_ins_lu_test_matrix();
+        using LockstepSolver = SparseLULockstepSolver<Tensor, Array, Array, 4>;
+
+        // the original matrix needs pivoting inside the blocks, which the lockstep factorization does not do
+        std::vector<Tensor> dominant_data = matrix.data;
+        for (Idx const diag_idx : matrix.diag_lu) {
+            dominant_data[diag_idx].matrix().diagonal().array() += 1000.0;
+        }
+        std::vector<Array> const x_ref = {{3, 4}, {-1, -2}, {5, 6}};
+        Eigen::VectorXd const x_ref_dense{{3, 4, -1, -2, 5, 6}};
+        Eigen::VectorXd const rhs_dense =
+            assemble_dense_matrix(matrix.row_indptr, matrix.col_indices, dominant_data) * x_ref_dense;
+        std::vector<Array> const rhs = {rhs_dense.segment<2>(0), rhs_dense.segment<2>(2), rhs_dense.segment<2>(4)};
+        std::vector<Array> x(3, Array::Zero());
+
+        LockstepSolver solver{
+            matrix.row_indptr, matrix.col_indices, matrix.diag_lu,
+            std::make_shared<SparseLUSymbolic const>(matrix.row_indptr, matrix.col_indices, matrix.diag_lu)};
+        std::array<std::vector<Tensor> const*, 2> const lane_data{&dominant_data, &matrix.data};
+        LockstepSolver::LaneMask const failed_lanes = solver.prefactorize(lane_data);
+        CHECK(failed_lanes.count() == 1);
+        CHECK(failed_lanes[1]);
+
+        std::array<std::vector<Array> const*, 1> const lane_rhs{&rhs};
+        std::array<std::vector<Array>*, 1> const lane_x{&x};
+        solver.solve_with_prefactorized_matrix(lane_rhs, lane_x);
+        check_result(x, x_ref);
+    }
+}
+
 TEST_CASE("LU solver with ill-conditioned system") {
     // test with ill-conditioned matrix if we do not do numerical pivoting
     // 4*4 matrix, or 2*2 with 2*2 blocks
@@ -542,6 +969,41 @@ TEST_CASE("LU solver with ill-conditioned system") {
                             SparseMatrixError);
         }
     }
+
+    SUBCASE("Small block pivot after a perturbed pivot") {
+        // the zero pivot of block 0 is perturbed to a tiny value, which makes the Schur-complement update of block 1
+        // huge. The other pivot of block 1 is then small relative to the largest pivot of the block, but not small
+        // enough to be perturbed. Once a pivot is perturbed, the condition of the later pivots is not checked.
+        auto row_indptr = IdxVector{0, 2, 4};
+        auto col_indices = IdxVector{0, 1, 0, 1};
+        auto diag_lu = IdxVector{0, 3};
+        auto const original_data = std::vector<Tensor>{
+            {{1, 0}, {0, 0}},    // 0, 0
+            {{0, 0}, {0, 1}},    // 0, 1
+            {{0, 0}, {0, 1}},    // 1, 0
+            {{1e-5, 0}, {0, 1}}, // 1, 1
+        };
+        auto block_perm = std::vector<SparseLUSolver<Tensor, Array, Array>::BlockPerm>(2);
+
+        SUBCASE("Pivot by pivot") {
+            auto data = original_data;
+            SparseLUSolver<Tensor, Array, Array> solver{row_indptr, col_indices, diag_lu};
+            CHECK_THROWS_AS(solver.prefactorize(data, block_perm, false), SparseMatrixError);
+            data = original_data;
+            CHECK_NOTHROW(solver.prefactorize(data, block_perm, true));
+        }
+
+        SUBCASE("Level by level") {
+            auto data = original_data;
+            auto symbolic = std::make_shared<SparseLUSymbolic>(row_indptr, col_indices, diag_lu);
+            symbolic->build_level_schedule(row_indptr, col_indices, diag_lu);
+            REQUIRE(symbolic->has_level_schedule());
+            JobExecutor executor{2};
+            SparseLUSolver<Tensor, Array, Array> solver{row_indptr, col_indices, diag_lu, symbolic};
+            solver.set_level_parallelism(&executor, executor.n_threads());
+            CHECK_NOTHROW(solver.prefactorize(data, block_perm, true));
+        }
+    }
 }
 
 } // namespace power_grid_model::math_solver
@@ -146,6 +146,7 @@ TEST_CASE("Test y bus") {
         CHECK(col_indices == ybus.col_indices());
         CHECK(bus_entry == ybus.bus_entry());
         CHECK(lu_transpose_entry == ybus.lu_transpose_entry());
+        CHECK(lu_transpose_entry == ybus.lu_symbolic()->transpose_entry);
         CHECK(y_bus_entry_indptr == ybus.y_bus_entry_indptr());
         CHECK(ybus.admittance().size() == admittance_sym.size());
         for (size_t i = 0; i < admittance_sym.size(); i++) {
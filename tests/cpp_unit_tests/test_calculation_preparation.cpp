@@ -5,14 +5,23 @@
 #include <power_grid_model/calculation_preparation.hpp>
 
 #include <power_grid_model/all_components.hpp>
+#include <power_grid_model/auxiliary/dataset.hpp>
+#include <power_grid_model/auxiliary/meta_data_gen.hpp>
 #include <power_grid_model/common/common.hpp>
+#include <power_grid_model/common/counting_iterator.hpp>
+#include <power_grid_model/common/dummy_logging.hpp>
 #include <power_grid_model/main_core/main_model_type.hpp>
+#include <power_grid_model/main_model_fwd.hpp>
+#include <power_grid_model/main_model_impl.hpp>
 #include <power_grid_model/math_solver/math_solver.hpp>
 #include <power_grid_model/math_solver/math_solver_dispatch.hpp>
 
 #include <doctest/doctest.h>
 
 #include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
 
 namespace power_grid_model {
 namespace {
@@ -97,5 +106,177 @@ TEST_CASE("Test SolverPreparationContext") {
     }
 }
 
+TEST_CASE("Test match unchanged math models") {
+    auto const make_math_topology = [](Idx n_bus, std::vector<BranchIdx> branch_bus_idx) {
+        MathModelTopology math_topo;
+        math_topo.phase_shift.resize(n_bus);
+        math_topo.branch_bus_idx = std::move(branch_bus_idx);
+        return std::make_shared<MathModelTopology const>(std::move(math_topo));
+    };
+    auto const make_coupling = [](std::vector<Idx2D> node) {
+        TopologicalComponentToMathCoupling topo_comp_coup;
+        topo_comp_coup.node = std::move(node);
+        return topo_comp_coup;
+    };
+
+    // two islands of two buses
+    std::vector const previous_math_topology{make_math_topology(2, {{0, 1}}), make_math_topology(2, {{0, 1}})};
+    auto const previous_topo_comp_coup = make_coupling({{0, 0}, {0, 1}, {1, 0}, {1, 1}});
+
+    SUBCASE("Island split") {
+        // the branch of the second island is opened
+        std::vector const math_topology{make_math_topology(2, {{0, 1}}), make_math_topology(1, {}),
+                                        make_math_topology(1, {})};
+        auto const topo_comp_coup = make_coupling({{0, 0}, {0, 1}, {1, 0}, {2, 0}});
+        CHECK(detail::match_unchanged_math_models(previous_math_topology, previous_topo_comp_coup, math_topology,
+                                                  topo_comp_coup) == IdxVector{0, disconnected, disconnected});
+    }
+
+    SUBCASE("Islands in another order") {
+        std::vector const math_topology{make_math_topology(2, {{0, 1}}), make_math_topology(2, {{0, 1}})};
+        auto const topo_comp_coup = make_coupling({{1, 0}, {1, 1}, {0, 0}, {0, 1}});
+        CHECK(detail::match_unchanged_math_models(previous_math_topology, previous_topo_comp_coup, math_topology,
+                                                  topo_comp_coup) == IdxVector{1, 0});
+    }
+
+    SUBCASE("Island with another topology") {
+        // a parallel branch is connected in the first island
+        std::vector const math_topology{make_math_topology(2, {{0, 1}, {0, 1}}), make_math_topology(2, {{0, 1}})};
+        auto const topo_comp_coup = make_coupling({{0, 0}, {0, 1}, {1, 0}, {1, 1}});
+        CHECK(detail::match_unchanged_math_models(previous_math_topology, previous_topo_comp_coup, math_topology,
+                                                  topo_comp_coup) == IdxVector{disconnected, 1});
+    }
+
+    SUBCASE("Other topological nodes") {
+        // a link is closed, which merges the topological nodes of the first island
+        std::vector const math_topology{make_math_topology(1, {}), make_math_topology(2, {{0, 1}})};
+        auto const topo_comp_coup = make_coupling({{0, 0}, {1, 0}, {1, 1}});
+        CHECK(detail::match_unchanged_math_models(previous_math_topology, previous_topo_comp_coup, math_topology,
+                                                  topo_comp_coup) == IdxVector{disconnected, disconnected});
+    }
+}
+
+TEST_CASE("Test reuse of the math models of untouched islands") {
+    using Model = MainModelImpl<MainModelType>;
+    auto const& meta_data = meta_data::meta_data_gen::meta_data;
+    MathSolverDispatcher const math_solver_dispatcher{math_solver::math_solver_tag<math_solver::MathSolver>{}};
+
+    // island 0: node 1 -- line 11 -- node 2
+    // island 1: node 3 -- line 12 -- node 4 -- line 13 -- node 5
+    std::vector<ID> const node_id{1, 2, 3, 4, 5};
+    std::vector<double> const node_u_rated(5, 10e3);
+
+    std::vector<ID> const line_id{11, 12, 13};
+    std::vector<ID> const line_from_node{1, 3, 4};
+    std::vector<ID> const line_to_node{2, 4, 5};
+    std::vector<IntS> const line_status(3, 1);
+    std::vector<IntS> const line_status_opened{1, 1, 0};
+    std::vector<double> const line_r1{0.1, 0.2, 0.1};
+    std::vector<double> const line_x1{0.2, 0.3, 0.1};
+    std::vector<double> const line_zero(3, 0.0);
+
+    std::vector<ID> const source_id{21, 22};
+    std::vector<ID> const source_node{1, 3};
+    std::vector<IntS> const source_status(2, 1);
+    std::vector<double> const source_u_ref{1.0, 1.05};
+
+    std::vector<ID> const load_id{31, 32, 33};
+    std::vector<ID> const load_node{2, 4, 5};
+    std::vector<IntS> const load_status(3, 1);
+    std::vector<IntS> const load_type(3, static_cast<IntS>(LoadGenType::const_pq));
+    std::vector<double> const load_p_specified{1e5, 2e5, 5e4};
+    std::vector<double> const load_q_specified{1e4, 2e4, 5e3};
+
+    auto const make_input_dataset = [&](std::vector<IntS> const& line_connected) {
+        ConstDataset input_dataset{false, 1, "input", meta_data};
+        input_dataset.add_buffer("node", 5, 5, nullptr, nullptr);
+        input_dataset.add_attribute_buffer("node", "id", node_id.data());
+        input_dataset.add_attribute_buffer("node", "u_rated", node_u_rated.data());
+        input_dataset.add_buffer("line", 3, 3, nullptr, nullptr);
+        input_dataset.add_attribute_buffer("line", "id", line_id.data());
+        input_dataset.add_attribute_buffer("line", "from_node", line_from_node.data());
+        input_dataset.add_attribute_buffer("line", "to_node", line_to_node.data());
+        input_dataset.add_attribute_buffer("line", "from_status", line_connected.data());
+        input_dataset.add_attribute_buffer("line", "to_status", line_connected.data());
+        input_dataset.add_attribute_buffer("line", "r1", line_r1.data());
+        input_dataset.add_attribute_buffer("line", "x1", line_x1.data());
+        input_dataset.add_attribute_buffer("line", "c1", line_zero.data());
+        input_dataset.add_attribute_buffer("line", "tan1", line_zero.data());
+        input_dataset.add_buffer("source", 2, 2, nullptr, nullptr);
+        input_dataset.add_attribute_buffer("source", "id", source_id.data());
+        input_dataset.add_attribute_buffer("source", "node", source_node.data());
+        input_dataset.add_attribute_buffer("source", "status", source_status.data());
+        input_dataset.add_attribute_buffer("source", "u_ref", source_u_ref.data());
+        input_dataset.add_buffer("sym_load", 3, 3, nullptr, nullptr);
+        input_dataset.add_attribute_buffer("sym_load", "id", load_id.data());
+        input_dataset.add_attribute_buffer("sym_load", "node", load_node.data());
+        input_dataset.add_attribute_buffer("sym_load", "status", load_status.data());
+        input_dataset.add_attribute_buffer("sym_load", "type", load_type.data());
+        input_dataset.add_attribute_buffer("sym_load", "p_specified", load_p_specified.data());
+        input_dataset.add_attribute_buffer("sym_load", "q_specified", load_q_specified.data());
+        return input_dataset;
+    };
+    auto const make_model = [&math_solver_dispatcher](ConstDataset const& input_dataset) {
+        return Model{50.0, input_dataset,
+                     SolverPreparationContext{.math_state = {}, .math_solver_dispatcher = &math_solver_dispatcher}};
+    };
+
+    common::logging::NoLogger logger{};
+    Model::Options const options{};
+    std::vector<IntS> energized(5);
+    std::vector<double> u(5);
+    std::vector<double> u_angle(5);
+    MutableDataset result_dataset{false, 1, "sym_output", meta_data};
+    result_dataset.add_buffer("node", 5, 5, nullptr, nullptr);
+    result_dataset.add_attribute_buffer("node", "energized", energized.data());
+    result_dataset.add_attribute_buffer("node", "u", u.data());
+    result_dataset.add_attribute_buffer("node", "u_angle", u_angle.data());
+
+    auto const input_dataset = make_input_dataset(line_status);
+    auto model = make_model(input_dataset);
+    model.calculate(options, false, result_dataset, logger);
+
+    // the math model of the island of a node, with its solver
+    auto const get_island = [](Model const& main_model, Idx node_idx) {
+        Idx const math_idx = main_model.state().topo_comp_coup->node[node_idx].group;
+        REQUIRE(math_idx != disconnected);
+        return std::pair{main_model.state().math_topology[math_idx].get(),
+                         &main_model.math_state().math_solvers_sym[math_idx].get()};
+    };
+    auto const [untouched_topology, untouched_solver] = get_island(model, 0);
+    auto const [split_topology, split_solver] = get_island(model, 2);
+    REQUIRE(model.state().math_topology.size() == 2);
+
+    // open line 13, which splits node 5 off the second island
+    ConstDataset update_dataset{false, 1, "update", meta_data};
+    update_dataset.add_buffer("line", 1, 1, nullptr, nullptr);
+    update_dataset.add_attribute_buffer("line", "id", &line_id[2]);
+    update_dataset.add_attribute_buffer("line", "from_status", &line_status_opened[2]);
+    update_dataset.add_attribute_buffer("line", "to_status", &line_status_opened[2]);
+    model.update_components<permanent_update_t>(update_dataset);
+    model.calculate(options, false, result_dataset, logger);
+
+    CHECK(get_island(model, 0) == std::pair{untouched_topology, untouched_solver});
+    auto const [new_split_topology, new_split_solver] = get_island(model, 2);
+    CHECK(new_split_topology != split_topology);
+    CHECK(new_split_solver != split_solver);
+    CHECK(model.state().topo_comp_coup->node[4].group == disconnected);
+
+    // the result is the same as the one of a model that is built in the switched state
+    auto const updated_energized = energized;
+    auto const updated_u = u;
+    auto const updated_u_angle = u_angle;
+    auto const switched_input_dataset = make_input_dataset(line_status_opened);
+    auto switched_model = make_model(switched_input_dataset);
+    switched_model.calculate(options, false, result_dataset, logger);
+    CHECK(updated_energized == energized);
+    CHECK(updated_energized[4] == 0);
+    for (Idx const node_idx : IdxRange{5}) {
+        CAPTURE(node_idx);
+        CHECK(updated_u[node_idx] == doctest::Approx(u[node_idx]));
+        CHECK(updated_u_angle[node_idx] == doctest::Approx(u_angle[node_idx]));
+    }
+}
+
 } // namespace
 } // namespace power_grid_model
@@ -149,6 +149,53 @@ TEST_CASE("Test component container") {
         CHECK_THROWS_AS(container.template get_item<C>(8), IDNotFound);
     }
 
+    SUBCASE("Test copy-on-write storage") {
+        CompContainer copy{container};
+        auto const& const_copy = copy;
+        CHECK(const_copy.is_storage_shared<C>());
+        CHECK(const_copy.is_storage_shared<C1>());
+        CHECK(const_copy.is_storage_shared<C2>());
+        CHECK(&const_copy.template get_item<C1>(2) == &const_container.template get_item<C1>(2));
+
+        // mutating a component only unshares the storage of its own type
+        copy.template get_item<C1>(2).b = 61.0;
+        CHECK(const_copy.template get_item<C1>(2).b == 61.0);
+        CHECK(const_container.template get_item<C1>(2).b == 60.0);
+        CHECK(!const_copy.is_storage_shared<C1>());
+        CHECK(const_copy.is_storage_shared<C>());
+        CHECK(const_copy.is_storage_shared<C2>());
+        CHECK(&const_copy.template get_item<C2>(3) == &const_container.template get_item<C2>(3));
+        CHECK(const_copy.get_idx_by_id(22) == const_container.get_idx_by_id(22));
+
+        // the original owns the storage that the copy does not share anymore
+        CHECK(!const_container.is_storage_shared<C1>());
+        CHECK(const_container.is_storage_shared<C2>());
+        container.template get_item<C2>(3).b = 71;
+        CHECK(!const_container.is_storage_shared<C2>());
+        CHECK(!const_copy.is_storage_shared<C2>());
+        CHECK(const_container.template get_item<C2>(3).b == 71);
+        CHECK(const_copy.template get_item<C2>(3).b == 70);
+
+        // reading through a mutable iterator does not unshare the storage
+        CompContainer second_copy{container};
+        auto const it = second_copy.template iter<C>().begin();
+        CHECK(&*it == &const_container.template get_item<C>(1));
+        CHECK(second_copy.is_storage_shared<C>());
+    }
+
+    SUBCASE("Test copy-on-write storage ownership after the copies are destroyed") {
+        {
+            CompContainer const copy{container};
+            CHECK(const_container.is_storage_shared<C1>());
+            CHECK(&copy.template get_item<C1>(2) == &const_container.template get_item<C1>(2));
+        }
+        // the storage is owned again, so mutating it does not copy it
+        CHECK(!const_container.is_storage_shared<C1>());
+        C1 const* const storage = &const_container.template get_item<C1>(2);
+        container.template get_item<C1>(2).b = 62.0;
+        CHECK(&const_container.template get_item<C1>(2) == storage);
+    }
+
     SUBCASE("Test size of a component class collection") {
         CHECK(const_container.size<C>() == 6);
         CHECK(const_container.size<C1>() == 2);
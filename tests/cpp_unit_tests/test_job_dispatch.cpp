@@ -3,10 +3,13 @@
 // SPDX-License-Identifier: MPL-2.0
 
 #include <power_grid_model/job_dispatch.hpp>
+#include <power_grid_model/job_executor.hpp>
 #include <power_grid_model/job_interface.hpp>
 
 #include <power_grid_model/batch_parameter.hpp>
 #include <power_grid_model/common/common.hpp>
+#include <power_grid_model/common/counting_iterator.hpp>
+#include <power_grid_model/common/enum.hpp>
 #include <power_grid_model/common/exception.hpp>
 #include <power_grid_model/common/logging.hpp>
 #include <power_grid_model/common/multi_threaded_logging.hpp>
@@ -16,9 +19,11 @@
 
 #include <algorithm>
 #include <atomic>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <ranges>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <thread>
@@ -29,9 +34,11 @@
 namespace power_grid_model {
 namespace {
 struct MockUpdateDataset {
-    MockUpdateDataset(bool data, Idx n_scenarios) : data{data}, n_scenarios{n_scenarios} {}
+    MockUpdateDataset(bool data, Idx n_scenarios, Idx invalid_scenario = na_Idx)
+        : data{data}, n_scenarios{n_scenarios}, invalid_scenario{invalid_scenario} {}
     bool data;
     Idx n_scenarios;
+    Idx invalid_scenario; // scenario of which the update data is rejected while preparing the job dispatch
     bool empty() const { return !data; }
     Idx batch_size() const { return n_scenarios; }
 };
@@ -43,16 +50,20 @@ struct CallCounter {
     std::atomic<Idx> cache_calculate_calls{};
     std::atomic<Idx> setup_calls{};
     std::atomic<Idx> winddown_calls{};
+    std::atomic<Idx> lockstep_calls{};
     std::atomic<Idx> set_logger_calls{};
     std::atomic<Idx> reset_logger_calls{};
+    std::atomic<Idx> prepare_threading{}; // threading with which the job dispatch was last prepared
 
     void reset_counters() {
         calculate_calls = 0;
         cache_calculate_calls = 0;
         setup_calls = 0;
         winddown_calls = 0;
+        lockstep_calls = 0;
         set_logger_calls = 0;
         reset_logger_calls = 0;
+        prepare_threading = 0;
     }
 };
 
@@ -82,6 +93,11 @@ class JobAdapterMock : public JobInterface {
     Idx get_cache_calculate_counter() const { return counter_->cache_calculate_calls; }
     Idx get_setup_counter() const { return counter_->setup_calls; }
     Idx get_winddown_counter() const { return counter_->winddown_calls; }
+    Idx get_lockstep_counter() const { return counter_->lockstep_calls; }
+    Idx get_prepare_threading() const { return counter_->prepare_threading; }
+
+  protected:
+    CallCounter& counter() const { return *counter_; }
 
   private:
     friend class JobInterface;
@@ -93,7 +109,13 @@ class JobAdapterMock : public JobInterface {
         ++(counter_->calculate_calls);
     }
     void cache_calculate_impl(Logger const& /*logger*/) const { ++(counter_->cache_calculate_calls); }
-    void prepare_job_dispatch_impl(MockUpdateDataset const& /*update_data*/) const { /* patch base class function */ }
+    void prepare_job_dispatch_impl(MockUpdateDataset const& update_data, std::vector<std::string>& exceptions,
+                                   Idx threading) const {
+        counter_->prepare_threading = threading;
+        if (!is_nan(update_data.invalid_scenario)) {
+            exceptions[update_data.invalid_scenario] = "invalid update data";
+        }
+    }
     void setup_impl(MockUpdateDataset const& /*update_data*/, Idx /*scenario_idx*/) const { ++(counter_->setup_calls); }
     void winddown_impl() const { ++(counter_->winddown_calls); }
 };
@@ -103,6 +125,40 @@ class SomeTestException : public std::runtime_error {
     using std::runtime_error::runtime_error;
 };
 
+// calculates groups of scenarios at once, of which one scenario fails
+class LockstepJobAdapterMock : public JobAdapterMock {
+  public:
+    LockstepJobAdapterMock(std::shared_ptr<CallCounter> counter, Idx group_size, Idx failing_scenario)
+        : JobAdapterMock{std::move(counter)}, group_size_{group_size}, failing_scenario_{failing_scenario} {}
+
+    Idx lockstep_group_size() const { return group_size_; }
+
+  private:
+    friend class JobInterface;
+
+    Idx group_size_;
+    Idx failing_scenario_;
+
+    template <typename SetupFn, typename WinddownFn, typename HandleExceptionFn>
+    void calculate_lockstep_impl(MockResultDataset const& /*result_data*/, std::span<Idx const> scenarios,
+                                 SetupFn setup, WinddownFn winddown, HandleExceptionFn handle_exception,
+                                 Logger const& /*logger*/) const {
+        ++(counter().lockstep_calls);
+        for (Idx const scenario_idx : scenarios) {
+            try {
+                setup(scenario_idx);
+                if (scenario_idx == failing_scenario_) {
+                    throw SomeTestException{"lockstep failure"};
+                }
+                ++(counter().calculate_calls);
+            } catch (...) {
+                handle_exception(scenario_idx);
+            }
+            winddown();
+        }
+    }
+};
+
 using common::logging::MultiThreadedLogger;
 
 MultiThreadedLogger& no_logger() {
@@ -154,6 +210,160 @@ TEST_CASE("Test job dispatch logic") {
             CHECK(adapter.get_calculate_counter() == n_scenarios);
             CHECK(adapter.get_cache_calculate_counter() == 1); // cache calculation is done
         }
+        SUBCASE("With scenarios and dynamic scheduling") {
+            bool const has_data = true;
+            Idx const n_scenarios = 23; // arbitrary non-zero value
+            auto const update_data = MockUpdateDataset(has_data, n_scenarios);
+            for (Idx const threading : {main_core::utils::sequential, Idx{0}, Idx{3}}) {
+                CAPTURE(threading);
+                adapter.reset_counters();
+                auto const actual_result =
+                    JobDispatch::batch_calculation(adapter, result_data, update_data, threading, no_logger(),
+                                                   BatchScheduling::dynamic);
+                CHECK(expected_result == actual_result);
+                // every scenario is calculated exactly once, regardless of the number of threads
+                CHECK(adapter.get_calculate_counter() == n_scenarios);
+                CHECK(adapter.get_setup_counter() == n_scenarios);
+                CHECK(adapter.get_winddown_counter() == n_scenarios);
+                CHECK(adapter.get_cache_calculate_counter() == 1);
+                // the preparation gets the threading of the batch
+                CHECK(adapter.get_prepare_threading() == threading);
+            }
+        }
+        SUBCASE("With invalid update data in a scenario") {
+            bool const has_data = true;
+            Idx const n_scenarios = 5; // arbitrary non-zero value
+            Idx const invalid_scenario = 2;
+            auto const update_data = MockUpdateDataset(has_data, n_scenarios, invalid_scenario);
+            adapter.reset_counters();
+            try {
+                JobDispatch::batch_calculation(adapter, result_data, update_data, main_core::utils::sequential,
+                                               no_logger());
+                FAIL("Expected batch calculation error not thrown.");
+            } catch (BatchCalculationError const& e) {
+                CHECK(e.failed_scenarios() == IdxVector{invalid_scenario});
+                CHECK(e.err_msgs() == std::vector<std::string>{"invalid update data"});
+            }
+            // the invalid scenario is not calculated, the others are
+            CHECK(adapter.get_setup_counter() == n_scenarios - 1);
+            CHECK(adapter.get_calculate_counter() == n_scenarios - 1);
+        }
+    }
+    SUBCASE("Test batch_calculation in lockstep") {
+        auto counter = std::make_shared<CallCounter>();
+        auto result_data = MockResultDataset{};
+        Idx const n_scenarios = 10; // arbitrary value that is not a multiple of the group size
+        Idx const group_size = 4;
+        Idx const failing_scenario = 5;
+        auto const update_data = MockUpdateDataset(true, n_scenarios);
+        for (Idx const threading : {main_core::utils::sequential, Idx{2}}) {
+            CAPTURE(threading);
+            auto adapter = LockstepJobAdapterMock{counter, group_size, failing_scenario};
+            adapter.reset_counters();
+            try {
+                JobDispatch::batch_calculation(adapter, result_data, update_data, threading, no_logger());
+                FAIL("Expected batch calculation error not thrown.");
+            } catch (BatchCalculationError const& e) {
+                // only the failing scenario of its group is reported
+                CHECK(e.failed_scenarios() == IdxVector{failing_scenario});
+                CHECK(e.err_msgs() == std::vector<std::string>{"lockstep failure"});
+            }
+            CHECK(adapter.get_calculate_counter() == n_scenarios - 1);
+            CHECK(adapter.get_setup_counter() == n_scenarios);
+            CHECK(adapter.get_winddown_counter() == n_scenarios);
+            if (threading == main_core::utils::sequential) {
+                // two full groups, and a group of the remaining two scenarios
+                CHECK(adapter.get_lockstep_counter() == 3);
+            }
+        }
+    }
+    SUBCASE("Test batch_calculation on executor") {
+        auto counter = std::make_shared<CallCounter>();
+        auto adapter = JobAdapterMock{counter};
+        auto result_data = MockResultDataset{};
+        Idx const n_scenarios = 17; // arbitrary non-zero value
+        auto const update_data = MockUpdateDataset(true, n_scenarios);
+        JobExecutor executor{3};
+        for (auto const scheduling : {BatchScheduling::static_stride, BatchScheduling::dynamic}) {
+            for (Idx const threading : {main_core::utils::sequential, Idx{0}, Idx{2}}) {
+                CAPTURE(threading);
+                adapter.reset_counters();
+                JobDispatch::batch_calculation(adapter, result_data, update_data, threading, no_logger(), scheduling,
+                                               &executor);
+                CHECK(adapter.get_calculate_counter() == n_scenarios);
+                CHECK(adapter.get_setup_counter() == n_scenarios);
+                CHECK(adapter.get_winddown_counter() == n_scenarios);
+                CHECK(adapter.get_cache_calculate_counter() == 1);
+            }
+        }
+    }
+    SUBCASE("Test n_executor_workers") {
+        Idx const n_scenarios = 14; // arbitrary non-zero value
+        CHECK(JobDispatch::n_executor_workers(n_scenarios, main_core::utils::sequential, 4) == 1);
+        CHECK(JobDispatch::n_executor_workers(n_scenarios, 1, 4) == 1);
+        CHECK(JobDispatch::n_executor_workers(n_scenarios, 0, 4) == 4);
+        CHECK(JobDispatch::n_executor_workers(n_scenarios, 3, 4) == 3);
+        CHECK(JobDispatch::n_executor_workers(n_scenarios, 8, 4) == 4);
+        CHECK(JobDispatch::n_executor_workers(2, 0, 4) == 2);
+    }
+    SUBCASE("Test ScenarioScheduler") {
+        auto collect_chunks = [](ScenarioScheduler& scheduler) {
+            std::vector<IdxRange> chunks;
+            for (auto chunk = scheduler.next_chunk(); !chunk.empty(); chunk = scheduler.next_chunk()) {
+                chunks.push_back(chunk);
+            }
+            return chunks;
+        };
+
+        SUBCASE("No scenarios") {
+            ScenarioScheduler scheduler{0, 4};
+            CHECK(scheduler.next_chunk().empty());
+        }
+        SUBCASE("Single thread") {
+            Idx const n_scenarios = 10;
+            ScenarioScheduler scheduler{n_scenarios, 1};
+            auto const chunks = collect_chunks(scheduler);
+            REQUIRE(!chunks.empty());
+            CHECK(chunks.front().front() == 0);
+            CHECK(chunks.back().back() == n_scenarios - 1);
+            CHECK(scheduler.next_chunk().empty());
+        }
+        SUBCASE("Chunks are contiguous and shrinking") {
+            Idx const n_scenarios = 1000;
+            Idx const n_thread = 4;
+            ScenarioScheduler scheduler{n_scenarios, n_thread};
+            auto const chunks = collect_chunks(scheduler);
+            REQUIRE(chunks.size() > 1);
+            Idx expected_begin = 0;
+            for (auto const& chunk : chunks) {
+                CHECK(chunk.front() == expected_begin);
+                expected_begin = chunk.back() + 1;
+            }
+            CHECK(expected_begin == n_scenarios);
+            CHECK(std::ranges::is_sorted(chunks, std::ranges::greater{}, [](IdxRange const& chunk) {
+                return std::ssize(chunk);
+            }));
+            CHECK(std::ssize(chunks.back()) == 1);
+        }
+        SUBCASE("Concurrent consumers") {
+            Idx const n_scenarios = 997;
+            Idx const n_thread = 5;
+            ScenarioScheduler scheduler{n_scenarios, n_thread};
+            std::vector<std::atomic<Idx>> visits(n_scenarios);
+            {
+                std::vector<std::jthread> threads;
+                for (Idx thread_number = 0; thread_number < n_thread; ++thread_number) {
+                    threads.emplace_back([&scheduler, &visits] {
+                        for (auto chunk = scheduler.next_chunk(); !chunk.empty(); chunk = scheduler.next_chunk()) {
+                            for (Idx const scenario_idx : chunk) {
+                                ++visits[scenario_idx];
+                            }
+                        }
+                    });
+                }
+            }
+            CHECK(std::ranges::all_of(visits, [](std::atomic<Idx> const& count) { return count == 1; }));
+        }
     }
     SUBCASE("Test single_thread_job") {
         auto counter = std::make_shared<CallCounter>();
@@ -180,7 +390,8 @@ TEST_CASE("Test job dispatch logic") {
             CHECK(adapter_.get_calculate_counter() == expected_calls);
         };
 
-        adapter.prepare_job_dispatch(update_data); // replicate preparation step from batch_calculation
+        // replicate preparation step from batch_calculation
+        adapter.prepare_job_dispatch(update_data, exceptions, main_core::utils::sequential);
         common::logging::NoMultiThreadedLogger no_log;
         auto single_job = JobDispatch::single_thread_job(adapter, result_data, update_data, exceptions, no_log);
 
@@ -208,6 +419,56 @@ TEST_CASE("Test job dispatch logic") {
         CHECK_NOTHROW(single_job(start, stride, n_scenarios));
         check_call_numbers(adapter, call_number);
     }
+    SUBCASE("Test dynamic_thread_job") {
+        auto counter = std::make_shared<CallCounter>();
+        auto adapter = JobAdapterMock{counter};
+        auto result_data = MockResultDataset{};
+        bool const has_data{false};
+        Idx const n_scenarios = 9; // arbitrary non-zero value
+        auto const update_data = MockUpdateDataset(has_data, n_scenarios);
+        exceptions.resize(n_scenarios);
+
+        // replicate preparation step from batch_calculation
+        adapter.prepare_job_dispatch(update_data, exceptions, main_core::utils::sequential);
+        common::logging::NoMultiThreadedLogger no_log;
+        auto dynamic_job = JobDispatch::dynamic_thread_job(adapter, result_data, update_data, exceptions, no_log);
+
+        adapter.reset_counters();
+        ScenarioScheduler scheduler{n_scenarios, 3};
+        CHECK_NOTHROW(dynamic_job(scheduler));
+        CHECK(adapter.get_setup_counter() == n_scenarios);
+        CHECK(adapter.get_winddown_counter() == n_scenarios);
+        CHECK(adapter.get_calculate_counter() == n_scenarios);
+
+        // the scheduler is exhausted, so a second job does nothing
+        adapter.reset_counters();
+        CHECK_NOTHROW(dynamic_job(scheduler));
+        CHECK(adapter.get_calculate_counter() == 0);
+    }
+    SUBCASE("Test dynamic_job_dispatch") {
+        std::atomic<Idx> n_calls{0};
+        std::atomic<Idx> n_scenarios_handled{0};
+        auto dynamic_job = [&n_calls, &n_scenarios_handled](ScenarioScheduler& scheduler) {
+            ++n_calls;
+            for (auto chunk = scheduler.next_chunk(); !chunk.empty(); chunk = scheduler.next_chunk()) {
+                n_scenarios_handled += std::ssize(chunk);
+            }
+        };
+
+        SUBCASE("Sequential") {
+            Idx const n_scenarios = 10; // arbitrary non-zero value
+            JobDispatch::dynamic_job_dispatch(dynamic_job, n_scenarios, main_core::utils::sequential);
+            CHECK(n_calls == 1);
+            CHECK(n_scenarios_handled == n_scenarios);
+        }
+        SUBCASE("Multi-threaded") {
+            Idx const n_scenarios = 50; // arbitrary non-zero value
+            Idx const threading = 4;
+            JobDispatch::dynamic_job_dispatch(dynamic_job, n_scenarios, threading);
+            CHECK(n_calls == JobDispatch::n_threads(n_scenarios, threading));
+            CHECK(n_scenarios_handled == n_scenarios);
+        }
+    }
     SUBCASE("Test job_dispatch") {
         struct JobArguments {
             Idx start;
@@ -304,6 +565,30 @@ TEST_CASE("Test job dispatch logic") {
             }
         }
     }
+    SUBCASE("Test nested_threading") {
+        auto const hardware_thread = static_cast<Idx>(std::jthread::hardware_concurrency());
+        CAPTURE(hardware_thread);
+
+        SUBCASE("Sequential batch") {
+            CHECK(JobDispatch::nested_threading(14, main_core::utils::sequential) == main_core::utils::sequential);
+            CHECK(JobDispatch::nested_threading(14, 1) == main_core::utils::sequential);
+        }
+        SUBCASE("Threads are divided over the scenarios") {
+            CHECK(JobDispatch::nested_threading(14, 4) == main_core::utils::sequential);
+            CHECK(JobDispatch::nested_threading(2, 8) == 4);
+            CHECK(JobDispatch::nested_threading(3, 8) == 2);
+            CHECK(JobDispatch::nested_threading(1, 8) == 8);
+            CHECK(JobDispatch::nested_threading(0, 8) == 8);
+        }
+        SUBCASE("Hardware threading") {
+            Idx const n_nested_thread = JobDispatch::nested_threading(1, 0);
+            if (hardware_thread < 2) {
+                CHECK(n_nested_thread == main_core::utils::sequential);
+            } else {
+                CHECK(n_nested_thread == hardware_thread);
+            }
+        }
+    }
     SUBCASE("Test call_with") {
         // These call counters are local as are unrelated to the adapter mock
         // and are only used to test the call_with functionality
@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: Contributors to the Power Grid Model project <powergridmodel@lfenergy.org>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include <power_grid_model/job_executor.hpp>
+#include <power_grid_model/main_model_fwd.hpp>
+
+#include <power_grid_model/common/common.hpp>
+
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace power_grid_model {
+namespace {
+class SomeTestException : public std::runtime_error {
+  public:
+    using std::runtime_error::runtime_error;
+};
+} // namespace
+
+TEST_CASE("Test model revision") {
+    ModelRevision revision;
+    auto const initial_key = revision.key();
+
+    SUBCASE("Increment keeps the instance") {
+        revision.increment();
+        CHECK(revision.key().instance_id == initial_key.instance_id);
+        CHECK(revision.key().revision == initial_key.revision + 1);
+        CHECK(revision.key() != initial_key);
+    }
+    SUBCASE("Copy is a new instance") {
+        ModelRevision const copy{revision};
+        CHECK(copy.key().instance_id != initial_key.instance_id);
+        CHECK(revision.key() == initial_key);
+
+        ModelRevision assigned;
+        assigned = revision;
+        CHECK(assigned.key().instance_id != initial_key.instance_id);
+        CHECK(assigned.key().instance_id != copy.key().instance_id);
+    }
+    SUBCASE("Move keeps the instance") {
+        ModelRevision const moved{std::move(revision)};
+        CHECK(moved.key() == initial_key);
+    }
+}
+
+TEST_CASE("Test warm slot") {
+    WarmSlot slot;
+    ModelRevisionKey const key{.instance_id = 1, .revision = 2};
+    CHECK(slot.empty());
+    CHECK(slot.take<int>(key) == nullptr);
+
+    SUBCASE("Matching key") {
+        slot.store(key, std::make_unique<int>(5));
+        CHECK(!slot.empty());
+        auto const value = slot.take<int>(key);
+        REQUIRE(value != nullptr);
+        CHECK(*value == 5);
+        CHECK(slot.empty());
+    }
+    SUBCASE("Different revision") {
+        slot.store(key, std::make_unique<int>(5));
+        CHECK(slot.take<int>({.instance_id = 1, .revision = 3}) == nullptr);
+        CHECK(slot.empty());
+    }
+    SUBCASE("Different type") {
+        slot.store(key, std::make_unique<int>(5));
+        CHECK(slot.take<double>(key) == nullptr);
+        CHECK(slot.empty());
+    }
+    SUBCASE("Store nothing") {
+        slot.store(key, std::unique_ptr<int>{});
+        CHECK(slot.empty());
+    }
+}
+
+TEST_CASE("Test job executor") {
+    SUBCASE("Number of threads") {
+        CHECK(JobExecutor{3}.n_threads() == 3);
+        CHECK(JobExecutor{0}.n_threads() >= 1);
+    }
+
+    SUBCASE("Run on a subset of workers") {
+        JobExecutor executor{4};
+        std::vector<std::atomic<Idx>> calls(executor.n_threads());
+        auto job = [&calls](Idx worker_idx) { ++calls[worker_idx]; };
+
+        executor.run(2, job);
+        CHECK(calls[0] == 1);
+        CHECK(calls[1] == 1);
+        CHECK(calls[2] == 0);
+        CHECK(calls[3] == 0);
+
+        // the workers are reused for the next run; requests beyond the pool size are capped
+        executor.run(10, job);
+        CHECK(calls[0] == 2);
+        CHECK(calls[1] == 2);
+        CHECK(calls[2] == 1);
+        CHECK(calls[3] == 1);
+    }
+
+    SUBCASE("Workers are persistent") {
+        JobExecutor executor{2};
+        std::vector<std::thread::id> first_ids(2);
+        std::vector<std::thread::id> second_ids(2);
+        auto record_first = [&first_ids](Idx worker_idx) { first_ids[worker_idx] = std::this_thread::get_id(); };
+        auto record_second = [&second_ids](Idx worker_idx) { second_ids[worker_idx] = std::this_thread::get_id(); };
+        executor.run(2, record_first);
+        executor.run(2, record_second);
+        CHECK(first_ids == second_ids);
+        CHECK(first_ids[0] != std::this_thread::get_id());
+    }
+
+    SUBCASE("Warm slots survive between runs") {
+        JobExecutor executor{2};
+        ModelRevisionKey const key{.instance_id = 7, .revision = 0};
+        auto store = [&executor, &key](Idx worker_idx) {
+            executor.warm_slot(worker_idx).store(key, std::make_unique<Idx>(worker_idx));
+        };
+        std::vector<Idx> taken(2, -1);
+        auto take = [&executor, &key, &taken](Idx worker_idx) {
+            if (auto value = executor.warm_slot(worker_idx).take<Idx>(key); value != nullptr) {
+                taken[worker_idx] = *value;
+            }
+        };
+        executor.run(2, store);
+        executor.run(2, take);
+        CHECK(taken == std::vector<Idx>{0, 1});
+
+        executor.run(2, store);
+        executor.clear_warm_slots();
+        taken = {-1, -1};
+        executor.run(2, take);
+        CHECK(taken == std::vector<Idx>{-1, -1});
+    }
+
+    SUBCASE("Exceptions are rethrown in the calling thread") {
+        JobExecutor executor{3};
+        std::atomic<Idx> n_calls{0};
+        auto job = [&n_calls](Idx worker_idx) {
+            ++n_calls;
+            if (worker_idx == 1) {
+                throw SomeTestException{"worker error"};
+            }
+        };
+        CHECK_THROWS_AS(executor.run(3, job), SomeTestException);
+        CHECK(n_calls == 3);
+
+        // the executor is still usable afterwards
+        n_calls = 0;
+        auto no_throw_job = [&n_calls](Idx /*worker_idx*/) { ++n_calls; };
+        CHECK_NOTHROW(executor.run(3, no_throw_job));
+        CHECK(n_calls == 3);
+    }
+}
+
+} // namespace power_grid_model
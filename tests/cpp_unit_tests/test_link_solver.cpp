@@ -14,8 +14,6 @@
 #include <cstddef>
 #include <ranges>
 #include <span>
-#include <unordered_map>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -39,7 +37,7 @@ T generate_input_result(std::span<const IntS> data, std::span<const Idx> rows, s
                         Idx col_number) {
     T result{};
 
-    detail::CooSparseMatrix& T_matrix = [&result]() -> detail::CooSparseMatrix& {
+    detail::SparseRowMatrix& T_matrix = [&result]() -> detail::SparseRowMatrix& {
         if constexpr (std::same_as<T, detail::ReducedEchelonForm>) {
             return result.matrix;
         } else if constexpr (std::same_as<T, detail::SolutionSet>) {
@@ -65,8 +63,8 @@ TEST_CASE("Test the link solver algorithm") {
             AdjacencyMap const adjacency_map = build_adjacency_map(std::move(edges));
 
             REQUIRE(adjacency_map.size() == 2);
-            CHECK(adjacency_map.at(0) == std::unordered_set<Idx>{0});
-            CHECK(adjacency_map.at(1) == std::unordered_set<Idx>{0});
+            CHECK(adjacency_map.at(0) == IdxVector{0});
+            CHECK(adjacency_map.at(1) == IdxVector{0});
         }
 
         SUBCASE("Two edges, three nodes") {
@@ -74,9 +72,9 @@ TEST_CASE("Test the link solver algorithm") {
             AdjacencyMap const adjacency_map = build_adjacency_map(std::move(edges));
 
             REQUIRE(adjacency_map.size() == 3);
-            CHECK(adjacency_map.at(0) == std::unordered_set<Idx>{0});
-            CHECK(adjacency_map.at(1) == std::unordered_set<Idx>{0, 1});
-            CHECK(adjacency_map.at(2) == std::unordered_set<Idx>{1});
+            CHECK(adjacency_map.at(0) == IdxVector{0});
+            CHECK(adjacency_map.at(1) == IdxVector{0, 1});
+            CHECK(adjacency_map.at(2) == IdxVector{1});
         }
 
         SUBCASE("Three edges, three nodes") {
@@ -84,9 +82,9 @@ TEST_CASE("Test the link solver algorithm") {
             AdjacencyMap const adjacency_map = build_adjacency_map(std::move(edges));
 
             REQUIRE(adjacency_map.size() == 3);
-            CHECK(adjacency_map.at(0) == std::unordered_set<Idx>{0, 2});
-            CHECK(adjacency_map.at(1) == std::unordered_set<Idx>{0, 1});
-            CHECK(adjacency_map.at(2) == std::unordered_set<Idx>{1, 2});
+            CHECK(adjacency_map.at(0) == IdxVector{0, 2});
+            CHECK(adjacency_map.at(1) == IdxVector{0, 1});
+            CHECK(adjacency_map.at(2) == IdxVector{1, 2});
         }
 
         SUBCASE("Two edges, two nodes") {
@@ -94,8 +92,8 @@ TEST_CASE("Test the link solver algorithm") {
             AdjacencyMap const adjacency_map = build_adjacency_map(std::move(edges));
 
             REQUIRE(adjacency_map.size() == 2);
-            CHECK(adjacency_map.at(0) == std::unordered_set<Idx>{0, 1});
-            CHECK(adjacency_map.at(1) == std::unordered_set<Idx>{0, 1});
+            CHECK(adjacency_map.at(0) == IdxVector{0, 1});
+            CHECK(adjacency_map.at(1) == IdxVector{0, 1});
         }
 
         SUBCASE("Seven edges, five nodes") {
@@ -103,14 +101,38 @@ TEST_CASE("Test the link solver algorithm") {
             AdjacencyMap const adjacency_map = build_adjacency_map(std::move(edges));
 
             REQUIRE(adjacency_map.size() == 5);
-            CHECK(adjacency_map.at(0) == std::unordered_set<Idx>{0, 1, 2});
-            CHECK(adjacency_map.at(1) == std::unordered_set<Idx>{1, 4, 5});
-            CHECK(adjacency_map.at(2) == std::unordered_set<Idx>{2, 3, 4});
-            CHECK(adjacency_map.at(3) == std::unordered_set<Idx>{0, 3, 6});
-            CHECK(adjacency_map.at(4) == std::unordered_set<Idx>{5, 6});
+            CHECK(adjacency_map.at(0) == IdxVector{0, 1, 2});
+            CHECK(adjacency_map.at(1) == IdxVector{1, 4, 5});
+            CHECK(adjacency_map.at(2) == IdxVector{2, 3, 4});
+            CHECK(adjacency_map.at(3) == IdxVector{0, 3, 6});
+            CHECK(adjacency_map.at(4) == IdxVector{5, 6});
         }
     }
 
+    SUBCASE("Test move edges in adjacency list") {
+        auto edges = std::vector<BranchIdx>{{0, 1}, {1, 2}, {2, 0}};
+        AdjacencyMap adjacency_map = build_adjacency_map(std::move(edges));
+        IdxVector moved_edges;
+
+        adjacency_map.erase(0, 0);
+        adjacency_map.erase(1, 0);
+        adjacency_map.move_edges(1, 0, moved_edges);
+        CHECK(moved_edges == IdxVector{1});
+        CHECK(adjacency_map.at(0) == IdxVector{1, 2});
+        CHECK(adjacency_map.at(1).empty());
+        CHECK(adjacency_map.at(2) == IdxVector{1, 2});
+
+        // an erased edge that is inserted again is only listed once
+        adjacency_map.erase(0, 2);
+        CHECK(adjacency_map.at(0) == IdxVector{1});
+        adjacency_map.insert(0, 2);
+        CHECK(adjacency_map.at(0) == IdxVector{1, 2});
+        adjacency_map.move_edges(0, 2, moved_edges);
+        CHECK(moved_edges == IdxVector{1, 2});
+        CHECK(adjacency_map.at(0).empty());
+        CHECK(adjacency_map.at(2) == IdxVector{1, 2});
+    }
+
     SUBCASE("Test forward elimination - elimination game") {
         using enum EdgeEvent;
         ReducedEchelonForm result{};
@@ -124,7 +146,7 @@ TEST_CASE("Test the link solver algorithm") {
             result.matrix.prepare(node_number);
             forward_elimination(result, std::move(edges), std::move(node_loads));
 
-            REQUIRE(result.matrix.data_map.size() == 1);
+            REQUIRE(result.matrix.nnz() == 1);
             CHECK(1 == result.matrix.get_value(0, 0));
             CHECK(result.rhs == std::vector<DoubleComplex>{{1.0, 0.0}});
             CHECK(result.free_edge_indices.empty());
@@ -142,7 +164,7 @@ TEST_CASE("Test the link solver algorithm") {
             result.matrix.prepare(node_number);
             forward_elimination(result, std::move(edges), std::move(node_loads));
 
-            REQUIRE(result.matrix.data_map.size() == 2);
+            REQUIRE(result.matrix.nnz() == 2);
             CHECK(1 == result.matrix.get_value(0, 0));
             CHECK(1 == result.matrix.get_value(1, 1));
             REQUIRE(result.rhs.size() == 2);
@@ -164,7 +186,7 @@ TEST_CASE("Test the link solver algorithm") {
             result.matrix.prepare(node_number);
             forward_elimination(result, std::move(edges), std::move(node_loads));
 
-            REQUIRE(result.matrix.data_map.size() == 4);
+            REQUIRE(result.matrix.nnz() == 4);
             CHECK(1 == result.matrix.get_value(0, 0));
             CHECK(-1 == result.matrix.get_value(0, 1));
             CHECK(1 == result.matrix.get_value(1, 1));
@@ -191,7 +213,7 @@ TEST_CASE("Test the link solver algorithm") {
             result.matrix.prepare(node_number);
             forward_elimination(result, std::move(edges), std::move(node_loads));
 
-            REQUIRE(result.matrix.data_map.size() == 2);
+            REQUIRE(result.matrix.nnz() == 2);
             CHECK(1 == result.matrix.get_value(0, 0));
             CHECK(1 == result.matrix.get_value(0, 1));
             REQUIRE(result.rhs.size() == 1);
@@ -215,7 +237,7 @@ TEST_CASE("Test the link solver algorithm") {
             result.matrix.prepare(node_number);
             forward_elimination(result, std::move(edges), std::move(node_loads));
 
-            REQUIRE(result.matrix.data_map.size() == 14);
+            REQUIRE(result.matrix.nnz() == 14);
             CHECK(1 == result.matrix.get_value(0, 0));
             CHECK(1 == result.matrix.get_value(0, 2));
             CHECK(1 == result.matrix.get_value(0, 1));
@@ -291,7 +313,7 @@ TEST_CASE("Test the link solver algorithm") {
             result.edges_history[0].rows = {0};
 
             backward_substitution(result);
-            REQUIRE(result.matrix.data_map.size() == 1);
+            REQUIRE(result.matrix.nnz() == 1);
             CHECK(1 == result.matrix.get_value(0, 0));
             REQUIRE(result.rhs.size() == 1);
             CHECK(result.rhs == std::vector<DoubleComplex>{{1.0, 0.0}});
@@ -312,7 +334,7 @@ TEST_CASE("Test the link solver algorithm") {
             result.edges_history[1].rows = {1};
 
             backward_substitution(result);
-            REQUIRE(result.matrix.data_map.size() == 2);
+            REQUIRE(result.matrix.nnz() == 2);
             CHECK(1 == result.matrix.get_value(0, 0));
             CHECK(1 == result.matrix.get_value(1, 1));
             REQUIRE(result.rhs.size() == 2);
@@ -338,7 +360,7 @@ TEST_CASE("Test the link solver algorithm") {
             result.edges_history[2].rows = {1};
 
             backward_substitution(result);
-            REQUIRE(result.matrix.data_map.size() == 4);
+            REQUIRE(result.matrix.nnz() == 4);
             CHECK(1 == result.matrix.get_value(0, 0));
             CHECK(1 == result.matrix.get_value(1, 1));
             CHECK(-1 == result.matrix.get_value(1, 2));
@@ -362,7 +384,7 @@ TEST_CASE("Test the link solver algorithm") {
             result.edges_history[1].rows = {0};
 
             backward_substitution(result);
-            REQUIRE(result.matrix.data_map.size() == 2);
+            REQUIRE(result.matrix.nnz() == 2);
             CHECK(1 == result.matrix.get_value(0, 0));
             CHECK(1 == result.matrix.get_value(0, 1));
             REQUIRE(result.rhs.size() == 1);
@@ -409,7 +431,7 @@ TEST_CASE("Test the link solver algorithm") {
             result.edges_history[6].rows = std::vector<Idx>{1, 2, 3};
 
             backward_substitution(result);
-            REQUIRE(result.matrix.data_map.size() == 11);
+            REQUIRE(result.matrix.nnz() == 11);
             CHECK(1 == result.matrix.get_value(0, 0));
             CHECK(1 == result.matrix.get_value(0, 3));
             CHECK(1 == result.matrix.get_value(0, 6));
@@ -8,14 +8,78 @@
 
 #include <doctest/doctest.h>
 
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 #include <map>
+#include <set>
 #include <utility>
 #include <vector>
 
 namespace {
 using power_grid_model::Idx;
+using power_grid_model::IdxVector;
+using power_grid_model::OrderingGraph;
+
+// square grid of side * side vertices
+OrderingGraph lattice_graph(Idx side) {
+    std::vector<std::pair<Idx, Idx>> edges;
+    for (Idx row = 0; row != side; ++row) {
+        for (Idx col = 0; col != side; ++col) {
+            Idx const vertex = row * side + col;
+            if (col + 1 != side) {
+                edges.emplace_back(vertex, vertex + 1);
+            }
+            if (row + 1 != side) {
+                edges.emplace_back(vertex, vertex + side);
+            }
+        }
+    }
+    return power_grid_model::make_ordering_graph(side * side, edges);
+}
+
+// fill-ins by playing the elimination game on the graph
+std::set<std::pair<Idx, Idx>> reference_fill_in(OrderingGraph const& graph, IdxVector const& order) {
+    std::vector<std::set<Idx>> adjacent(graph.n_vertices());
+    for (Idx vertex = 0; vertex != graph.n_vertices(); ++vertex) {
+        adjacent[vertex].insert(graph.adjacent(vertex).begin(), graph.adjacent(vertex).end());
+    }
+    std::set<std::pair<Idx, Idx>> fills;
+    for (Idx const vertex : order) {
+        for (Idx const first : adjacent[vertex]) {
+            for (Idx const second : adjacent[vertex]) {
+                if (first < second && adjacent[first].insert(second).second) {
+                    adjacent[second].insert(first);
+                    fills.emplace(first, second);
+                }
+            }
+        }
+        for (Idx const other : adjacent[vertex]) {
+            adjacent[other].erase(vertex);
+        }
+    }
+    return fills;
+}
+
+IdxVector natural_order(OrderingGraph const& graph) {
+    IdxVector order(graph.n_vertices());
+    std::ranges::generate(order, [n = Idx{0}]() mutable { return n++; });
+    return order;
+}
+
+void check_ordering(OrderingGraph const& graph, IdxVector const& order,
+                    std::vector<std::pair<Idx, Idx>> const& fills) {
+    IdxVector sorted_order{order};
+    std::ranges::sort(sorted_order);
+    CHECK(sorted_order == natural_order(graph));
+
+    std::set<std::pair<Idx, Idx>> sorted_fills;
+    for (auto const& [from, to] : fills) {
+        sorted_fills.emplace(std::min(from, to), std::max(from, to));
+    }
+    CHECK(sorted_fills.size() == fills.size());
+    CHECK(sorted_fills == reference_fill_in(graph, order));
+}
 } // namespace
 
 TEST_CASE("Test sparse ordering") {
@@ -33,4 +97,77 @@ TEST_CASE("Test sparse ordering") {
         CHECK(alpha == std::vector<Idx>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
         CHECK(fills == std::vector<std::pair<Idx, Idx>>{{3, 5}, {4, 5}, {5, 8}, {5, 6}, {5, 7}});
     }
+
+    SUBCASE("make_ordering_graph") {
+        std::vector<std::pair<Idx, Idx>> const edges{{2, 0}, {0, 1}, {1, 0}, {1, 1}, {3, 1}};
+        auto const graph = power_grid_model::make_ordering_graph(4, edges);
+
+        CHECK(graph.n_vertices() == 4);
+        CHECK(graph.indptr == IdxVector{0, 2, 4, 5, 6});
+        CHECK(graph.indices == IdxVector{1, 2, 0, 3, 0, 1});
+    }
+
+    SUBCASE("Automatic ordering of a small graph is the minimum degree ordering") {
+        std::map<Idx, std::vector<Idx>> const graph_map{{0, {3, 5}}, {1, {4, 5, 8}}, {2, {4, 5, 6}}, {3, {6, 7}},
+                                                        {4, {6, 8}}, {6, {7, 8, 9}}, {7, {8, 9}},    {8, {9}}};
+        std::vector<std::pair<Idx, Idx>> edges;
+        for (auto const& [from, adjacent] : graph_map) {
+            for (Idx const to : adjacent) {
+                edges.emplace_back(from, to);
+            }
+        }
+        auto const graph = power_grid_model::make_ordering_graph(10, edges);
+
+        auto const [alpha, fills] = power_grid_model::sparse_ordering(graph);
+        auto const [alpha_ref, fills_ref] = power_grid_model::minimum_degree_ordering(graph_map);
+        CHECK(alpha == alpha_ref);
+        CHECK(fills == fills_ref);
+    }
+
+    SUBCASE("Approximate minimum degree ordering") {
+        using enum power_grid_model::SparseOrderingMethod;
+
+        for (Idx const side : {2, 5, 12}) {
+            CAPTURE(side);
+            auto const graph = lattice_graph(side);
+            auto const [order, fills] = power_grid_model::sparse_ordering(graph, approximate_minimum_degree);
+            check_ordering(graph, order, fills);
+            CHECK(fills.size() <= reference_fill_in(graph, natural_order(graph)).size());
+        }
+    }
+
+    SUBCASE("Nested dissection ordering") {
+        using enum power_grid_model::SparseOrderingMethod;
+
+        auto const graph = lattice_graph(20);
+        auto const [order, fills] = power_grid_model::sparse_ordering(graph, nested_dissection);
+        check_ordering(graph, order, fills);
+        CHECK(2 * fills.size() < reference_fill_in(graph, natural_order(graph)).size());
+
+        // disconnected graph with small leaves
+        std::vector<std::pair<Idx, Idx>> const edges{{0, 1}, {1, 2}, {2, 3}, {3, 0}, {4, 5}, {5, 6}, {6, 7}, {7, 8}};
+        auto const disconnected_graph = power_grid_model::make_ordering_graph(10, edges);
+        auto const disconnected_order = power_grid_model::nested_dissection_ordering(disconnected_graph, 2);
+        check_ordering(disconnected_graph, disconnected_order,
+                       power_grid_model::detail::elimination_fill_in(disconnected_graph, disconnected_order));
+    }
+    SUBCASE("Sparse ordering cache") {
+        using enum power_grid_model::SparseOrderingMethod;
+
+        power_grid_model::SparseOrderingCache cache{2};
+        auto const graph = lattice_graph(5);
+        auto const ordering = power_grid_model::sparse_ordering(graph, automatic, cache);
+        CHECK(*ordering == power_grid_model::sparse_ordering(graph));
+        CHECK(cache.size() == 1);
+
+        // the same graph shares the ordering, another graph or method does not
+        CHECK(power_grid_model::sparse_ordering(lattice_graph(5), automatic, cache) == ordering);
+        CHECK(power_grid_model::sparse_ordering(graph, nested_dissection, cache) != ordering);
+        CHECK(power_grid_model::sparse_ordering(lattice_graph(4), automatic, cache) != ordering);
+
+        // the least recently used ordering is evicted
+        CHECK(cache.size() == 2);
+        CHECK(cache.find(graph, automatic) == nullptr);
+        CHECK(cache.find(lattice_graph(4), automatic) != nullptr);
+    }
 }
@@ -469,3 +469,54 @@ TEST_CASE("Test cycle reorder") {
 }
 
 } // namespace power_grid_model::topology
+
+TEST_CASE("Test depth first visit") {
+    using power_grid_model::topology::detail::CompressedGraph;
+    using power_grid_model::topology::detail::depth_first_visit;
+    using power_grid_model::topology::detail::GraphIdx;
+    using power_grid_model::topology::detail::VertexColor;
+
+    struct Visitor {
+        std::vector<GraphIdx>* discovered;
+        std::vector<std::pair<GraphIdx, GraphIdx>>* tree_edges;
+        std::vector<std::pair<GraphIdx, GraphIdx>>* back_edges;
+
+        void discover_vertex(GraphIdx u, CompressedGraph<int> const& /* g */) const { discovered->push_back(u); }
+        void tree_edge(GraphIdx source, GraphIdx target, GraphIdx e, CompressedGraph<int> const& g) const {
+            CHECK(g[e] == static_cast<int>(10 * source + target));
+            tree_edges->emplace_back(source, target);
+        }
+        void back_edge(GraphIdx source, GraphIdx target, GraphIdx /* e */, CompressedGraph<int> const& /* g */) const {
+            back_edges->emplace_back(source, target);
+        }
+    };
+
+    // 0 - 1 - 2 - 0 (cycle), 1 - 3, and 4 - 5 as a separate island
+    std::vector<std::pair<GraphIdx, GraphIdx>> const branches{{0, 1}, {1, 2}, {2, 0}, {3, 1}, {4, 5}};
+    std::vector<std::pair<GraphIdx, GraphIdx>> edges;
+    std::vector<int> edge_values;
+    for (auto const& [from, to] : branches) {
+        edges.emplace_back(from, to);
+        edge_values.push_back(static_cast<int>(10 * from + to));
+        edges.emplace_back(to, from);
+        edge_values.push_back(static_cast<int>(10 * to + from));
+    }
+    CompressedGraph<int> const graph{6, edges, edge_values};
+    CHECK(graph.n_vertices() == 6);
+
+    std::vector<VertexColor> color(6, VertexColor::white);
+    std::vector<std::pair<GraphIdx, GraphIdx>> stack;
+    std::vector<GraphIdx> discovered;
+    std::vector<std::pair<GraphIdx, GraphIdx>> tree_edges;
+    std::vector<std::pair<GraphIdx, GraphIdx>> back_edges;
+    depth_first_visit(graph, 0, color, stack, Visitor{&discovered, &tree_edges, &back_edges});
+
+    // edges are visited in the order in which they were added
+    CHECK(discovered == std::vector<GraphIdx>{0, 1, 2, 3});
+    CHECK(tree_edges == std::vector<std::pair<GraphIdx, GraphIdx>>{{0, 1}, {1, 2}, {1, 3}});
+    // the edges back to the parent are reported as well, the topology filters them
+    CHECK(back_edges == std::vector<std::pair<GraphIdx, GraphIdx>>{{1, 0}, {2, 1}, {2, 0}, {3, 1}});
+    CHECK(std::ranges::count(color, VertexColor::black) == 4);
+    CHECK(color[4] == VertexColor::white);
+    CHECK(color[5] == VertexColor::white);
+}
@@ -7,6 +7,7 @@
 #include <power_grid_model_cpp/basics.hpp>
 #include <power_grid_model_cpp/buffer.hpp>
 #include <power_grid_model_cpp/dataset.hpp>
+#include <power_grid_model_cpp/executor.hpp>
 #include <power_grid_model_cpp/handle.hpp>
 #include <power_grid_model_cpp/model.hpp>
 #include <power_grid_model_cpp/options.hpp>
@@ -18,11 +19,13 @@
 
 #include <algorithm>
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <exception> // NOLINT(misc-include-cleaner)
 #include <map>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -343,6 +346,455 @@ TEST_CASE("API Model") {
         CHECK(batch_node_result_u_angle[3] == doctest::Approx(0.0));
     }
 
+    SUBCASE("Batch power flow on a persistent executor") {
+        Executor executor{2};
+        options.set_executor(executor);
+        options.set_threading(0);
+        for (Idx const batch_scheduling : {Idx{PGM_batch_scheduling_static}, Idx{PGM_batch_scheduling_dynamic}}) {
+            CAPTURE(batch_scheduling);
+            options.set_batch_scheduling(batch_scheduling);
+            // repeat to run on the warm model copies of the workers
+            for (Idx repetition = 0; repetition != 2; ++repetition) {
+                CAPTURE(repetition);
+                node_batch_output.set_nan();
+                model.calculate(options, batch_output_dataset, batch_update_dataset);
+                node_batch_output.get_value(PGM_def_sym_output_node_u, batch_node_result_u.data(), -1);
+                CHECK(batch_node_result_u[0] == doctest::Approx(40.0));
+                CHECK(batch_node_result_u[1] == doctest::Approx(0.0));
+                CHECK(batch_node_result_u[2] == doctest::Approx(70.0));
+                CHECK(batch_node_result_u[3] == doctest::Approx(0.0));
+            }
+        }
+        options.reset_executor();
+    }
+
+    SUBCASE("Power flow with parallel islands") {
+        options.set_island_parallelism(PGM_island_parallelism_parallel);
+        for (Idx const threading : {Idx{-1}, Idx{0}, Idx{4}}) {
+            CAPTURE(threading);
+            options.set_threading(threading);
+            node_batch_output.set_nan();
+            model.calculate(options, batch_output_dataset, batch_update_dataset);
+            node_batch_output.get_value(PGM_def_sym_output_node_u, batch_node_result_u.data(), -1);
+            CHECK(batch_node_result_u[0] == doctest::Approx(40.0));
+            CHECK(batch_node_result_u[1] == doctest::Approx(0.0));
+            CHECK(batch_node_result_u[2] == doctest::Approx(70.0));
+            CHECK(batch_node_result_u[3] == doctest::Approx(0.0));
+        }
+    }
+
+    SUBCASE("Power flow with parallel islands after a switching change") {
+        auto const input_data_islands_json = R"json({
+  "version": "1.0",
+  "type": "input",
+  "is_batch": false,
+  "attributes": {},
+  "data": {
+    "node": [
+      {"id": 1, "u_rated": 10000},
+      {"id": 2, "u_rated": 10000},
+      {"id": 3, "u_rated": 10000},
+      {"id": 4, "u_rated": 10000},
+      {"id": 5, "u_rated": 10000},
+      {"id": 6, "u_rated": 10000},
+      {"id": 7, "u_rated": 10000}
+    ],
+    "line": [
+      {"id": 11, "from_node": 1, "to_node": 2, "from_status": 1, "to_status": 1,
+       "r1": 0.1, "x1": 0.2, "c1": 0, "tan1": 0},
+      {"id": 12, "from_node": 3, "to_node": 4, "from_status": 1, "to_status": 1,
+       "r1": 0.2, "x1": 0.3, "c1": 0, "tan1": 0},
+      {"id": 13, "from_node": 4, "to_node": 5, "from_status": 1, "to_status": 1,
+       "r1": 0.1, "x1": 0.1, "c1": 0, "tan1": 0},
+      {"id": 14, "from_node": 5, "to_node": 3, "from_status": 1, "to_status": 1,
+       "r1": 0.3, "x1": 0.2, "c1": 0, "tan1": 0},
+      {"id": 15, "from_node": 6, "to_node": 7, "from_status": 1, "to_status": 1,
+       "r1": 0.2, "x1": 0.2, "c1": 0, "tan1": 0}
+    ],
+    "source": [
+      {"id": 21, "node": 1, "status": 1, "u_ref": 1},
+      {"id": 22, "node": 3, "status": 1, "u_ref": 1.05},
+      {"id": 23, "node": 6, "status": 1, "u_ref": 0.95}
+    ],
+    "sym_load": [
+      {"id": 31, "node": 2, "status": 1, "type": 0, "p_specified": 100000, "q_specified": 10000},
+      {"id": 32, "node": 4, "status": 1, "type": 0, "p_specified": 200000, "q_specified": 20000},
+      {"id": 33, "node": 5, "status": 1, "type": 0, "p_specified": 50000, "q_specified": 5000},
+      {"id": 34, "node": 7, "status": 1, "type": 0, "p_specified": 150000, "q_specified": 15000}
+    ]
+  }
+})json"s; // NOLINT(misc-include-cleaner) https://github.com/llvm/llvm-project/issues/98122
+
+        // only the second island changes, the other islands keep their solvers
+        auto const update_data_islands_json = R"json({
+  "version": "1.0",
+  "type": "update",
+  "is_batch": false,
+  "attributes": {},
+  "data": {
+    "line": [
+      {"id": 12, "from_status": 0, "to_status": 0}
+    ]
+  }
+})json"s; // NOLINT(misc-include-cleaner) https://github.com/llvm/llvm-project/issues/98122
+
+        auto const owning_input_dataset_islands = load_dataset(input_data_islands_json);
+        auto const owning_update_dataset_islands = load_dataset(update_data_islands_json);
+
+        constexpr Idx n_node = 7;
+        Buffer node_output_islands{PGM_def_sym_output_node, n_node};
+        DatasetMutable output_dataset_islands{"sym_output", false, 1};
+        output_dataset_islands.add_buffer("node", n_node, n_node, nullptr, node_output_islands);
+
+        options.set_island_parallelism(PGM_island_parallelism_parallel);
+        auto const calculate = [&](Idx threading) {
+            options.set_threading(threading);
+            Model model_islands{50.0, owning_input_dataset_islands.dataset};
+            // the first calculation builds the solvers that are kept by the switching change
+            model_islands.calculate(options, output_dataset_islands);
+            model_islands.update(owning_update_dataset_islands.dataset);
+            node_output_islands.set_nan();
+            model_islands.calculate(options, output_dataset_islands);
+            std::vector<double> u(n_node);
+            std::vector<double> u_angle(n_node);
+            node_output_islands.get_value(PGM_def_sym_output_node_u, u.data(), -1);
+            node_output_islands.get_value(PGM_def_sym_output_node_u_angle, u_angle.data(), -1);
+            return std::pair{u, u_angle};
+        };
+
+        auto const [u_sequential, u_angle_sequential] = calculate(1);
+        auto const [u_parallel, u_angle_parallel] = calculate(4);
+        for (std::size_t node = 0; node != u_sequential.size(); ++node) {
+            CAPTURE(node);
+            CHECK(u_parallel[node] == doctest::Approx(u_sequential[node]));
+            CHECK(u_angle_parallel[node] == doctest::Approx(u_angle_sequential[node]));
+        }
+    }
+
+    SUBCASE("Batch power flow grouped by topology") {
+        options.set_scenario_ordering(PGM_scenario_ordering_group_by_topology);
+        for (Idx const threading : {Idx{-1}, Idx{0}, Idx{2}}) {
+            CAPTURE(threading);
+            options.set_threading(threading);
+            node_batch_output.set_nan();
+            model.calculate(options, batch_output_dataset, batch_update_dataset);
+            node_batch_output.get_value(PGM_def_sym_output_node_u, batch_node_result_u.data(), -1);
+            CHECK(batch_node_result_u[0] == doctest::Approx(40.0));
+            CHECK(batch_node_result_u[1] == doctest::Approx(0.0));
+            CHECK(batch_node_result_u[2] == doctest::Approx(70.0));
+            CHECK(batch_node_result_u[3] == doctest::Approx(0.0));
+        }
+    }
+
+    SUBCASE("Batch power flow with warm start") {
+        options.set_calculation_method(PGM_newton_raphson);
+        for (Idx const power_flow_initialization :
+             {Idx{PGM_power_flow_initialization_default}, Idx{PGM_power_flow_initialization_warm_start}}) {
+            CAPTURE(power_flow_initialization);
+            options.set_power_flow_initialization(power_flow_initialization);
+            // repeat to start from the solution of the previous calculation
+            for (Idx repetition = 0; repetition != 2; ++repetition) {
+                CAPTURE(repetition);
+                node_batch_output.set_nan();
+                model.calculate(options, batch_output_dataset, batch_update_dataset);
+                node_batch_output.get_value(PGM_def_sym_output_node_u, batch_node_result_u.data(), -1);
+                CHECK(batch_node_result_u[0] == doctest::Approx(40.0));
+                CHECK(batch_node_result_u[1] == doctest::Approx(0.0));
+                CHECK(batch_node_result_u[2] == doctest::Approx(70.0));
+                CHECK(batch_node_result_u[3] == doctest::Approx(0.0));
+            }
+        }
+    }
+
+    SUBCASE("State estimation with mixed precision factorization") {
+        auto const input_data_se_json = R"json({
+  "version": "1.0",
+  "type": "input",
+  "is_batch": false,
+  "attributes": {},
+  "data": {
+    "node": [
+      {"id": 1, "u_rated": 10000},
+      {"id": 2, "u_rated": 10000}
+    ],
+    "line": [
+      {"id": 3, "from_node": 1, "to_node": 2, "from_status": 1, "to_status": 1,
+       "r1": 0.1, "x1": 0.1, "c1": 0, "tan1": 0}
+    ],
+    "source": [
+      {"id": 4, "node": 1, "status": 1, "u_ref": 1}
+    ],
+    "sym_load": [
+      {"id": 5, "node": 2, "status": 1, "type": 0, "p_specified": 100000, "q_specified": 10000}
+    ],
+    "sym_voltage_sensor": [
+      {"id": 6, "measured_object": 1, "u_sigma": 100, "u_measured": 10000},
+      {"id": 7, "measured_object": 2, "u_sigma": 100, "u_measured": 9900}
+    ],
+    "sym_power_sensor": [
+      {"id": 8, "measured_object": 5, "measured_terminal_type": 4, "power_sigma": 1000, "p_measured": 100000,
+       "q_measured": 10000}
+    ]
+  }
+})json"s; // NOLINT(misc-include-cleaner) https://github.com/llvm/llvm-project/issues/98122
+
+        auto const owning_input_dataset_se = load_dataset(input_data_se_json);
+        Model model_se{50.0, owning_input_dataset_se.dataset};
+
+        Buffer node_output_se{PGM_def_sym_output_node, 2};
+        DatasetMutable output_dataset_se{"sym_output", false, 1};
+        output_dataset_se.add_buffer("node", 2, 2, nullptr, node_output_se);
+
+        options.set_calculation_type(PGM_state_estimation);
+        for (Idx const calculation_method : {Idx{PGM_iterative_linear}, Idx{PGM_newton_raphson}}) {
+            CAPTURE(calculation_method);
+            options.set_calculation_method(calculation_method);
+
+            auto const calculate = [&](Idx factorization_precision) {
+                options.set_factorization_precision(factorization_precision);
+                node_output_se.set_nan();
+                model_se.calculate(options, output_dataset_se);
+                std::vector<double> u(2);
+                std::vector<double> u_angle(2);
+                node_output_se.get_value(PGM_def_sym_output_node_u, u.data(), -1);
+                node_output_se.get_value(PGM_def_sym_output_node_u_angle, u_angle.data(), -1);
+                return std::pair{u, u_angle};
+            };
+
+            auto const [u_double, u_angle_double] = calculate(PGM_factorization_precision_double);
+            auto const [u_mixed, u_angle_mixed] = calculate(PGM_factorization_precision_mixed);
+            for (std::size_t node = 0; node != u_double.size(); ++node) {
+                CAPTURE(node);
+                CHECK(u_mixed[node] == doctest::Approx(u_double[node]));
+                CHECK(u_angle_mixed[node] == doctest::Approx(u_angle_double[node]));
+            }
+        }
+    }
+
+    SUBCASE("Batch power flow of branch outages") {
+        auto const input_data_n1_json = R"json({
+  "version": "1.0",
+  "type": "input",
+  "is_batch": false,
+  "attributes": {},
+  "data": {
+    "node": [
+      {"id": 1, "u_rated": 10000},
+      {"id": 2, "u_rated": 10000},
+      {"id": 3, "u_rated": 10000},
+      {"id": 4, "u_rated": 10000}
+    ],
+    "line": [
+      {"id": 11, "from_node": 1, "to_node": 2, "from_status": 1, "to_status": 1,
+       "r1": 0.1, "x1": 0.2, "c1": 0, "tan1": 0},
+      {"id": 12, "from_node": 2, "to_node": 3, "from_status": 1, "to_status": 1,
+       "r1": 0.2, "x1": 0.3, "c1": 0, "tan1": 0},
+      {"id": 13, "from_node": 3, "to_node": 1, "from_status": 1, "to_status": 1,
+       "r1": 0.1, "x1": 0.1, "c1": 0, "tan1": 0},
+      {"id": 14, "from_node": 3, "to_node": 4, "from_status": 1, "to_status": 1,
+       "r1": 0.3, "x1": 0.2, "c1": 0, "tan1": 0}
+    ],
+    "source": [
+      {"id": 5, "node": 1, "status": 1, "u_ref": 1}
+    ],
+    "sym_load": [
+      {"id": 6, "node": 2, "status": 1, "type": 0, "p_specified": 100000, "q_specified": 10000},
+      {"id": 7, "node": 3, "status": 1, "type": 0, "p_specified": 200000, "q_specified": 20000},
+      {"id": 8, "node": 4, "status": 1, "type": 0, "p_specified": 50000, "q_specified": 5000}
+    ]
+  }
+})json"s; // NOLINT(misc-include-cleaner) https://github.com/llvm/llvm-project/issues/98122
+
+        // one outage per scenario, the last one islands node 4
+        auto const update_data_n1_json = R"json({
+  "version": "1.0",
+  "type": "update",
+  "is_batch": true,
+  "attributes": {},
+  "data": [
+    {"line": [{"id": 11, "from_status": 0, "to_status": 0}]},
+    {"line": [{"id": 12, "from_status": 0, "to_status": 0}]},
+    {"line": [{"id": 13, "from_status": 0, "to_status": 0}]},
+    {"line": [{"id": 14, "from_status": 0, "to_status": 0}]}
+  ]
+})json"s; // NOLINT(misc-include-cleaner) https://github.com/llvm/llvm-project/issues/98122
+
+        auto const owning_input_dataset_n1 = load_dataset(input_data_n1_json);
+        auto const owning_update_dataset_n1 = load_dataset(update_data_n1_json);
+        Model model_n1{50.0, owning_input_dataset_n1.dataset};
+
+        constexpr Idx n_scenario = 4;
+        constexpr Idx n_node = 4;
+        constexpr Idx n_line = 4;
+        Buffer node_output_n1{PGM_def_sym_output_node, n_scenario * n_node};
+        Buffer line_output_n1{PGM_def_sym_output_line, n_scenario * n_line};
+        DatasetMutable output_dataset_n1{"sym_output", true, n_scenario};
+        output_dataset_n1.add_buffer("node", n_node, n_scenario * n_node, nullptr, node_output_n1);
+        output_dataset_n1.add_buffer("line", n_line, n_scenario * n_line, nullptr, line_output_n1);
+
+        for (Idx const calculation_method : {Idx{PGM_linear}, Idx{PGM_iterative_current}, Idx{PGM_newton_raphson}}) {
+            CAPTURE(calculation_method);
+            options.set_calculation_method(calculation_method);
+
+            auto const calculate = [&](Idx contingency_mode) {
+                options.set_contingency_mode(contingency_mode);
+                node_output_n1.set_nan();
+                line_output_n1.set_nan();
+                model_n1.calculate(options, output_dataset_n1, owning_update_dataset_n1.dataset);
+                std::vector<int8_t> energized(n_scenario * n_node);
+                std::vector<double> u(n_scenario * n_node);
+                std::vector<double> u_angle(n_scenario * n_node);
+                std::vector<double> i_from(n_scenario * n_line);
+                std::vector<double> p_from(n_scenario * n_line);
+                node_output_n1.get_value(PGM_def_sym_output_node_energized, energized.data(), -1);
+                node_output_n1.get_value(PGM_def_sym_output_node_u, u.data(), -1);
+                node_output_n1.get_value(PGM_def_sym_output_node_u_angle, u_angle.data(), -1);
+                line_output_n1.get_value(PGM_def_sym_output_line_i_from, i_from.data(), -1);
+                line_output_n1.get_value(PGM_def_sym_output_line_p_from, p_from.data(), -1);
+                return std::tuple{energized, u, u_angle, i_from, p_from};
+            };
+
+            auto const [energized_full, u_full, u_angle_full, i_from_full, p_from_full] =
+                calculate(PGM_contingency_mode_full_rebuild);
+            auto const [energized_low_rank, u_low_rank, u_angle_low_rank, i_from_low_rank, p_from_low_rank] =
+                calculate(PGM_contingency_mode_low_rank_update);
+
+            // the islanding outage de-energizes node 4
+            CHECK(energized_full[(n_scenario - 1) * n_node + 3] == 0);
+            for (std::size_t idx = 0; idx != u_full.size(); ++idx) {
+                CAPTURE(idx);
+                CHECK(energized_low_rank[idx] == energized_full[idx]);
+                CHECK(u_low_rank[idx] == doctest::Approx(u_full[idx]));
+                CHECK(u_angle_low_rank[idx] == doctest::Approx(u_angle_full[idx]));
+            }
+            for (std::size_t idx = 0; idx != i_from_full.size(); ++idx) {
+                CAPTURE(idx);
+                CHECK(i_from_low_rank[idx] == doctest::Approx(i_from_full[idx]));
+                CHECK(p_from_low_rank[idx] == doctest::Approx(p_from_full[idx]));
+            }
+        }
+    }
+
+    SUBCASE("Batch power flow in lockstep") {
+        auto const input_data_ts_json = R"json({
+  "version": "1.0",
+  "type": "input",
+  "is_batch": false,
+  "attributes": {},
+  "data": {
+    "node": [
+      {"id": 1, "u_rated": 10000},
+      {"id": 2, "u_rated": 10000},
+      {"id": 3, "u_rated": 10000},
+      {"id": 4, "u_rated": 10000}
+    ],
+    "line": [
+      {"id": 11, "from_node": 1, "to_node": 2, "from_status": 1, "to_status": 1,
+       "r1": 0.1, "x1": 0.2, "c1": 0, "tan1": 0},
+      {"id": 12, "from_node": 2, "to_node": 3, "from_status": 1, "to_status": 1,
+       "r1": 0.2, "x1": 0.3, "c1": 0, "tan1": 0},
+      {"id": 13, "from_node": 3, "to_node": 1, "from_status": 1, "to_status": 1,
+       "r1": 0.1, "x1": 0.1, "c1": 0, "tan1": 0},
+      {"id": 14, "from_node": 3, "to_node": 4, "from_status": 1, "to_status": 1,
+       "r1": 0.3, "x1": 0.2, "c1": 0, "tan1": 0}
+    ],
+    "source": [
+      {"id": 5, "node": 1, "status": 1, "u_ref": 1}
+    ],
+    "sym_load": [
+      {"id": 6, "node": 2, "status": 1, "type": 0, "p_specified": 100000, "q_specified": 10000},
+      {"id": 7, "node": 3, "status": 1, "type": 0, "p_specified": 200000, "q_specified": 20000},
+      {"id": 8, "node": 4, "status": 1, "type": 0, "p_specified": 50000, "q_specified": 5000}
+    ]
+  }
+})json"s; // NOLINT(misc-include-cleaner) https://github.com/llvm/llvm-project/issues/98122
+
+        // a time series of the loads
+        // the Newton-Raphson method does not converge for the load of scenario 2, scenario 3 also changes the topology
+        auto const update_data_ts_json = R"json({
+  "version": "1.0",
+  "type": "update",
+  "is_batch": true,
+  "attributes": {},
+  "data": [
+    {"sym_load": [{"id": 6, "p_specified": 100000}, {"id": 8, "p_specified": 50000}]},
+    {"sym_load": [{"id": 6, "p_specified": 120000}, {"id": 8, "p_specified": 60000}]},
+    {"sym_load": [{"id": 6, "p_specified": 110000}, {"id": 8, "p_specified": 1e9}]},
+    {"sym_load": [{"id": 6, "p_specified": 80000}, {"id": 8, "p_specified": 40000}],
+     "line": [{"id": 12, "from_status": 0, "to_status": 0}]},
+    {"sym_load": [{"id": 6, "p_specified": 90000}, {"id": 8, "p_specified": 45000}]},
+    {"sym_load": [{"id": 6, "p_specified": 130000}, {"id": 8, "p_specified": 65000}]}
+  ]
+})json"s; // NOLINT(misc-include-cleaner) https://github.com/llvm/llvm-project/issues/98122
+
+        auto const owning_input_dataset_ts = load_dataset(input_data_ts_json);
+        auto const owning_update_dataset_ts = load_dataset(update_data_ts_json);
+        Model model_ts{50.0, owning_input_dataset_ts.dataset};
+
+        constexpr Idx n_scenario = 6;
+        constexpr Idx n_node = 4;
+        constexpr Idx n_line = 4;
+        Buffer node_output_ts{PGM_def_sym_output_node, n_scenario * n_node};
+        Buffer line_output_ts{PGM_def_sym_output_line, n_scenario * n_line};
+        DatasetMutable output_dataset_ts{"sym_output", true, n_scenario};
+        output_dataset_ts.add_buffer("node", n_node, n_scenario * n_node, nullptr, node_output_ts);
+        output_dataset_ts.add_buffer("line", n_line, n_scenario * n_line, nullptr, line_output_ts);
+
+        for (Idx const calculation_method : {Idx{PGM_linear}, Idx{PGM_newton_raphson}}) {
+            CAPTURE(calculation_method);
+            options.set_calculation_method(calculation_method);
+
+            auto const calculate = [&](Idx batch_lockstep, Idx threading) {
+                options.set_batch_lockstep(batch_lockstep);
+                options.set_threading(threading);
+                node_output_ts.set_nan();
+                line_output_ts.set_nan();
+                std::vector<Idx> failed;
+                try {
+                    model_ts.calculate(options, output_dataset_ts, owning_update_dataset_ts.dataset);
+                } catch (PowerGridBatchError const& e) {
+                    for (auto const& failed_scenario : e.failed_scenarios()) {
+                        failed.push_back(failed_scenario.scenario);
+                    }
+                    std::ranges::sort(failed);
+                }
+                std::vector<double> u(n_scenario * n_node);
+                std::vector<double> u_angle(n_scenario * n_node);
+                std::vector<double> p_from(n_scenario * n_line);
+                node_output_ts.get_value(PGM_def_sym_output_node_u, u.data(), -1);
+                node_output_ts.get_value(PGM_def_sym_output_node_u_angle, u_angle.data(), -1);
+                line_output_ts.get_value(PGM_def_sym_output_line_p_from, p_from.data(), -1);
+                return std::tuple{failed, u, u_angle, p_from};
+            };
+
+            auto const [failed_ref, u_ref, u_angle_ref, p_from_ref] = calculate(PGM_batch_lockstep_disabled, -1);
+            if (calculation_method == PGM_newton_raphson) {
+                CHECK(failed_ref == std::vector<Idx>{2});
+            } else {
+                CHECK(failed_ref.empty());
+            }
+
+            for (Idx const threading : {Idx{-1}, Idx{2}}) {
+                CAPTURE(threading);
+                auto const [failed, u, u_angle, p_from] = calculate(PGM_batch_lockstep_enabled, threading);
+                CHECK(failed == failed_ref);
+                for (Idx scenario = 0; scenario != n_scenario; ++scenario) {
+                    if (std::ranges::find(failed_ref, scenario) != failed_ref.end()) {
+                        continue;
+                    }
+                    CAPTURE(scenario);
+                    for (Idx idx = scenario * n_node; idx != (scenario + 1) * n_node; ++idx) {
+                        CHECK(u[idx] == doctest::Approx(u_ref[idx]));
+                        CHECK(u_angle[idx] == doctest::Approx(u_angle_ref[idx]));
+                    }
+                    for (Idx idx = scenario * n_line; idx != (scenario + 1) * n_line; ++idx) {
+                        CHECK(p_from[idx] == doctest::Approx(p_from_ref[idx]));
+                    }
+                }
+            }
+        }
+    }
+
     SUBCASE("Input error handling") {
         SUBCASE("Construction error") {
             auto const bad_load_id_state_json = R"json({
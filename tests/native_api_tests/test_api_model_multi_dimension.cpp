@@ -12,9 +12,11 @@
 
 #include <doctest/doctest.h>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <complex>
+#include <limits>
 #include <numbers>
 #include <string>
 #include <vector>
@@ -107,6 +109,25 @@ TEST_CASE("API Model Multi-Dimension") {
             CHECK(i_source_result[idx] == doctest::Approx(i_source_ref[idx]));
         }
     }
+    SUBCASE("Parallel cartesian product") {
+        std::vector<double> i_source_result(total_batch_size);
+        DatasetMutable batch_output_dataset{"sym_output", true, total_batch_size};
+        batch_output_dataset.add_buffer("source", 1, total_batch_size, nullptr, nullptr);
+        batch_output_dataset.add_attribute_buffer("source", "i", i_source_result.data());
+
+        Options options{};
+        for (Idx const threading : {Idx{0}, Idx{2}, Idx{8}}) {
+            CAPTURE(threading);
+            options.set_threading(threading);
+            std::ranges::fill(i_source_result, std::numeric_limits<double>::quiet_NaN());
+
+            model.calculate(options, batch_output_dataset, batch_u_ref);
+
+            for (Idx idx = 0; idx < total_batch_size; ++idx) {
+                CHECK(i_source_result[idx] == doctest::Approx(i_source_ref[idx]));
+            }
+        }
+    }
     SUBCASE("Linked list item referring to itself is not allowed") {
         CHECK_THROWS_AS(batch_u_ref.set_next_cartesian_product_dimension(batch_u_ref), PowerGridRegularError);
     }
@@ -367,6 +367,68 @@ auto update_vector_json() {
   ]
 })json"s; // NOLINT(misc-include-cleaner) https://github.com/llvm/llvm-project/issues/98122
 }
+
+// consecutive scenarios update the same components, but not always the same attributes
+// the last scenario updates other components
+auto time_series_update_json() {
+    return R"json({
+  "version": "1.0",
+  "type": "update",
+  "is_batch": true,
+  "attributes": {},
+  "data": [
+    {
+      "sym_load": [
+        {"id": 7, "p_specified": 1000000}
+      ],
+      "asym_load": [
+        {"id": 8, "p_specified": [100000, 200000, 300000]}
+      ],
+      "line": [
+        {"id": 4, "from_status": 1}
+      ]
+    },
+    {
+      "sym_load": [
+        {"id": 7, "p_specified": 1000000, "q_specified": 200000}
+      ],
+      "asym_load": [
+        {"id": 8, "p_specified": [100000, null, 300000]}
+      ],
+      "line": [
+        {"id": 4, "from_status": 1}
+      ]
+    },
+    {
+      "sym_load": [
+        {"id": 7, "status": 0}
+      ],
+      "asym_load": [
+        {"id": 8, "q_specified": [10000, 10000, 10000]}
+      ],
+      "line": [
+        {"id": 4, "from_status": 0}
+      ]
+    },
+    {
+      "sym_load": [
+        {"id": 7, "q_specified": 100000}
+      ],
+      "asym_load": [
+        {"id": 8, "status": 1}
+      ],
+      "line": [
+        {"id": 4, "from_status": 1}
+      ]
+    },
+    {
+      "shunt": [
+        {"id": 9, "g1": 0.02}
+      ]
+    }
+  ]
+})json"s; // NOLINT(misc-include-cleaner) https://github.com/llvm/llvm-project/issues/98122
+}
 } // namespace
 
 TEST_CASE("API model - all updates") {
@@ -426,6 +488,43 @@ TEST_CASE("API model - all updates") {
     }
 }
 
+TEST_CASE("API model - delta scenario transition") {
+    auto const owning_input_dataset = load_dataset(complete_state_json());
+    auto const& input_dataset = owning_input_dataset.dataset;
+    auto model = Model{50.0, input_dataset};
+
+    auto const owning_update_dataset = load_dataset(time_series_update_json());
+    auto const& update_data = owning_update_dataset.dataset;
+    Idx const n_scenarios = update_data.get_info().batch_size();
+
+    auto const calculate_node_u_pu = [&model, &update_data, n_scenarios](Idx scenario_transition, Idx threading) {
+        std::vector<double> node_u_pu(3 * n_scenarios);
+        DatasetMutable output{"sym_output", true, n_scenarios};
+        output.add_buffer("node", 3, 3 * n_scenarios, nullptr, nullptr);
+        output.add_attribute_buffer("node", "u_pu", node_u_pu.data());
+
+        auto opt = get_default_options(PGM_symmetric, PGM_newton_raphson);
+        opt.set_scenario_transition(scenario_transition);
+        opt.set_threading(threading);
+        model.calculate(opt, output, update_data);
+        return node_u_pu;
+    };
+
+    auto const reference = calculate_node_u_pu(PGM_scenario_transition_restore, -1);
+    for (Idx const threading : {Idx{-1}, Idx{2}}) {
+        CAPTURE(threading);
+        auto const result = calculate_node_u_pu(PGM_scenario_transition_delta, threading);
+        REQUIRE(result.size() == reference.size());
+        for (size_t idx = 0; idx != result.size(); ++idx) {
+            CAPTURE(idx);
+            CHECK(result[idx] == doctest::Approx(reference[idx]));
+        }
+    }
+
+    // the model itself is not changed by the batch calculation
+    CHECK(calculate_node_u_pu(PGM_scenario_transition_restore, -1) == reference);
+}
+
 TEST_CASE("API model - updates w/ alternating compute mode") {
     auto const owning_input_dataset = load_dataset(complete_state_json());
     auto const& input_dataset = owning_input_dataset.dataset;